@@ -0,0 +1,1170 @@
+// Headless throughput benchmark for the software renderer. Renders a camera path through a generated scene into
+// an in-memory frame buffer without a window, then prints frame time percentiles and renderer profiler counters.
+//
+// Usage: otesa-render-benchmark [--width N] [--height N] [--frames N] [--warmup N] [--threads MODE] [--spin MICROSECONDS]
+//                               [--affinity on|off] [--precision double|single] [--shading forward|visibility] [--sort on|off]
+//                               [--bins adaptive|fixed] [--interlacing on|off] [--mipmaps on|off] [--seed N]
+//                               [--tiled on|off] [--path FILE] [--texel-fetch on|off] [--stage-csv FILE]
+//
+// With --texel-fetch on, it instead times 8-bit texel fetches along axis-aligned and oblique spans for the linear
+// and tiled texture layouts, without creating a renderer.
+//
+// With --stage-csv, render thread stage timers are turned on and each measured frame's per-thread stage times are
+// written to the given file, one row per thread per frame.
+//
+// Camera path files have one keyframe per line, "x y z yaw pitch" in world space and degrees. Keyframes are spread
+// evenly over the rendered frames. Lines starting with '#' are comments. Without a path, the camera orbits the scene.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../Math/Constants.h"
+#include "../Math/MathUtils.h"
+#include "../Math/Matrix4.h"
+#include "../Math/Random.h"
+#include "../Math/Vector3.h"
+#include "../Rendering/RenderBackend.h"
+#include "../Rendering/RenderBuffer.h"
+#include "../Rendering/RenderCamera.h"
+#include "../Rendering/RenderDrawCall.h"
+#include "../Rendering/RenderDrawCommand.h"
+#include "../Rendering/RenderFrameSettings.h"
+#include "../Rendering/RenderInitSettings.h"
+#include "../Rendering/RenderMaterialUtils.h"
+#include "../Rendering/RendererUtils.h"
+#include "../Rendering/SoftwareRenderer.h"
+#include "../Utilities/Color.h"
+#include "../Utilities/Platform.h"
+#include "../World/MeshUtils.h"
+
+#include "components/debug/Debug.h"
+#include "components/utilities/String.h"
+#include "components/utilities/TextLinesFile.h"
+
+namespace
+{
+	struct BenchmarkSettings
+	{
+		int width, height;
+		int frameCount;
+		int warmupFrameCount;
+		int renderThreadsMode;
+		int renderThreadsSpinMicroseconds;
+		bool enableThreadAffinity;
+		RasterPrecisionMode rasterPrecisionMode;
+		ShadingMode shadingMode;
+		bool enableDrawCallSorting;
+		bool enableAdaptiveBinSizing;
+		bool enableInterlacing;
+		bool enableMipmaps;
+		bool enableTiledTexels;
+		int seed;
+		std::string cameraPathFilename;
+		bool isTexelFetchOnly;
+		std::string stageCsvFilename; // Empty if stage timers are off.
+
+		BenchmarkSettings()
+		{
+			this->width = 1280;
+			this->height = 720;
+			this->frameCount = 300;
+			this->warmupFrameCount = 10;
+			this->renderThreadsMode = 5;
+			this->renderThreadsSpinMicroseconds = 100;
+			this->enableThreadAffinity = false;
+			this->rasterPrecisionMode = RasterPrecisionMode::Double;
+			this->shadingMode = ShadingMode::Forward;
+			this->enableDrawCallSorting = true;
+			this->enableAdaptiveBinSizing = true;
+			this->enableInterlacing = false;
+			this->enableMipmaps = false;
+			this->enableTiledTexels = false;
+			this->seed = 12345;
+			this->isTexelFetchOnly = false;
+		}
+	};
+
+	struct CameraKeyframe
+	{
+		WorldDouble3 position;
+		Degrees yaw, pitch;
+	};
+
+	void PrintUsage()
+	{
+		std::printf("Usage: otesa-render-benchmark [--width N] [--height N] [--frames N] [--warmup N] [--threads MODE] [--spin MICROSECONDS]\n");
+		std::printf("                              [--affinity on|off] [--precision double|single] [--shading forward|visibility] [--sort on|off]\n");
+		std::printf("                              [--bins adaptive|fixed] [--interlacing on|off] [--mipmaps on|off] [--seed N]\n");
+		std::printf("                              [--tiled on|off] [--path FILE] [--texel-fetch on|off] [--stage-csv FILE]\n");
+		std::printf("  --threads MODE   Render threads mode 0-5, same as the RenderThreadsMode option.\n");
+		std::printf("  --spin N         Render thread busy-wait budget, same as the RenderThreadsSpinMicroseconds option.\n");
+		std::printf("  --affinity on|off  Pin render threads to physical cores, same as the RenderThreadsAffinity option.\n");
+		std::printf("  --sort on|off    Front-to-back draw call sorting, same as the RenderSortDrawCalls option.\n");
+		std::printf("  --bins MODE      Rasterizer bin sizing, same as the RenderAdaptiveBins option.\n");
+		std::printf("  --interlacing on|off  Every other row per frame, same as the RenderInterlacing option.\n");
+		std::printf("  --mipmaps on|off Object texture mip levels, same as the RenderMipmaps option.\n");
+		std::printf("  --tiled on|off   Tiled object texture sampling, same as the RenderTiledTextures option.\n");
+		std::printf("  --path FILE      Camera keyframes, one \"x y z yaw pitch\" per line. Defaults to an orbit.\n");
+		std::printf("  --texel-fetch on|off  Texel fetch microbenchmark of linear vs. tiled texture layouts instead of rendering.\n");
+		std::printf("  --stage-csv FILE Render thread stage times per frame, one row per thread.\n");
+	}
+
+	bool TryParseInt(const char *str, int minValue, int *outValue)
+	{
+		char *end = nullptr;
+		const long value = std::strtol(str, &end, 10);
+		if ((end == str) || (*end != '\0') || (value < minValue))
+		{
+			return false;
+		}
+
+		*outValue = static_cast<int>(value);
+		return true;
+	}
+
+	bool TryParseArgs(int argc, char *argv[], BenchmarkSettings *outSettings)
+	{
+		for (int i = 1; i < argc; i++)
+		{
+			const std::string arg = argv[i];
+			if ((arg == "--help") || (arg == "-h"))
+			{
+				return false;
+			}
+
+			if ((i + 1) >= argc)
+			{
+				std::fprintf(stderr, "Missing value for \"%s\".\n", arg.c_str());
+				return false;
+			}
+
+			const char *value = argv[i + 1];
+			i++;
+
+			bool success = true;
+			if (arg == "--width")
+			{
+				success = TryParseInt(value, 1, &outSettings->width);
+			}
+			else if (arg == "--height")
+			{
+				success = TryParseInt(value, 1, &outSettings->height);
+			}
+			else if (arg == "--frames")
+			{
+				success = TryParseInt(value, 1, &outSettings->frameCount);
+			}
+			else if (arg == "--warmup")
+			{
+				success = TryParseInt(value, 0, &outSettings->warmupFrameCount);
+			}
+			else if (arg == "--threads")
+			{
+				success = TryParseInt(value, 0, &outSettings->renderThreadsMode) && (outSettings->renderThreadsMode <= 5);
+			}
+			else if (arg == "--spin")
+			{
+				success = TryParseInt(value, 0, &outSettings->renderThreadsSpinMicroseconds);
+			}
+			else if (arg == "--affinity")
+			{
+				const std::string affinityStr = value;
+				if (affinityStr == "on")
+				{
+					outSettings->enableThreadAffinity = true;
+				}
+				else if (affinityStr == "off")
+				{
+					outSettings->enableThreadAffinity = false;
+				}
+				else
+				{
+					success = false;
+				}
+			}
+			else if (arg == "--precision")
+			{
+				const std::string precisionStr = value;
+				if (precisionStr == "double")
+				{
+					outSettings->rasterPrecisionMode = RasterPrecisionMode::Double;
+				}
+				else if (precisionStr == "single")
+				{
+					outSettings->rasterPrecisionMode = RasterPrecisionMode::Single;
+				}
+				else
+				{
+					success = false;
+				}
+			}
+			else if (arg == "--shading")
+			{
+				const std::string shadingStr = value;
+				if (shadingStr == "forward")
+				{
+					outSettings->shadingMode = ShadingMode::Forward;
+				}
+				else if (shadingStr == "visibility")
+				{
+					outSettings->shadingMode = ShadingMode::VisibilityBuffer;
+				}
+				else
+				{
+					success = false;
+				}
+			}
+			else if (arg == "--sort")
+			{
+				const std::string sortStr = value;
+				if (sortStr == "on")
+				{
+					outSettings->enableDrawCallSorting = true;
+				}
+				else if (sortStr == "off")
+				{
+					outSettings->enableDrawCallSorting = false;
+				}
+				else
+				{
+					success = false;
+				}
+			}
+			else if (arg == "--bins")
+			{
+				const std::string binsStr = value;
+				if (binsStr == "adaptive")
+				{
+					outSettings->enableAdaptiveBinSizing = true;
+				}
+				else if (binsStr == "fixed")
+				{
+					outSettings->enableAdaptiveBinSizing = false;
+				}
+				else
+				{
+					success = false;
+				}
+			}
+			else if (arg == "--interlacing")
+			{
+				const std::string interlacingStr = value;
+				if (interlacingStr == "on")
+				{
+					outSettings->enableInterlacing = true;
+				}
+				else if (interlacingStr == "off")
+				{
+					outSettings->enableInterlacing = false;
+				}
+				else
+				{
+					success = false;
+				}
+			}
+			else if (arg == "--mipmaps")
+			{
+				const std::string mipmapsStr = value;
+				if (mipmapsStr == "on")
+				{
+					outSettings->enableMipmaps = true;
+				}
+				else if (mipmapsStr == "off")
+				{
+					outSettings->enableMipmaps = false;
+				}
+				else
+				{
+					success = false;
+				}
+			}
+			else if (arg == "--tiled")
+			{
+				const std::string tiledStr = value;
+				if (tiledStr == "on")
+				{
+					outSettings->enableTiledTexels = true;
+				}
+				else if (tiledStr == "off")
+				{
+					outSettings->enableTiledTexels = false;
+				}
+				else
+				{
+					success = false;
+				}
+			}
+			else if (arg == "--seed")
+			{
+				success = TryParseInt(value, 0, &outSettings->seed);
+			}
+			else if (arg == "--path")
+			{
+				outSettings->cameraPathFilename = value;
+			}
+			else if (arg == "--stage-csv")
+			{
+				outSettings->stageCsvFilename = value;
+			}
+			else if (arg == "--texel-fetch")
+			{
+				const std::string texelFetchStr = value;
+				if (texelFetchStr == "on")
+				{
+					outSettings->isTexelFetchOnly = true;
+				}
+				else if (texelFetchStr == "off")
+				{
+					outSettings->isTexelFetchOnly = false;
+				}
+				else
+				{
+					success = false;
+				}
+			}
+			else
+			{
+				std::fprintf(stderr, "Unrecognized argument \"%s\".\n", arg.c_str());
+				return false;
+			}
+
+			if (!success)
+			{
+				std::fprintf(stderr, "Invalid value \"%s\" for \"%s\".\n", value, arg.c_str());
+				return false;
+			}
+		}
+
+		// Frame buffer dimensions must line up with the rasterizer's tiles.
+		const int alignment = RendererUtils::RESOLUTION_ALIGNMENT;
+		outSettings->width = std::max(outSettings->width - (outSettings->width % alignment), alignment);
+		outSettings->height = std::max(outSettings->height - (outSettings->height % alignment), alignment);
+		return true;
+	}
+
+	bool TryLoadCameraPath(const std::string &filename, std::vector<CameraKeyframe> &outKeyframes)
+	{
+		TextLinesFile textLinesFile;
+		if (!textLinesFile.init(filename.c_str()))
+		{
+			DebugLogErrorFormat("Couldn't open camera path \"%s\".", filename.c_str());
+			return false;
+		}
+
+		for (int i = 0; i < textLinesFile.getLineCount(); i++)
+		{
+			const std::string &line = textLinesFile.getLine(i);
+			const Buffer<std::string> tokens = String::split(line);
+			if (tokens.getCount() != 5)
+			{
+				DebugLogErrorFormat("Expected \"x y z yaw pitch\" on camera path line \"%s\".", line.c_str());
+				return false;
+			}
+
+			CameraKeyframe keyframe;
+			keyframe.position = WorldDouble3(std::atof(tokens[0].c_str()), std::atof(tokens[1].c_str()), std::atof(tokens[2].c_str()));
+			keyframe.yaw = std::atof(tokens[3].c_str());
+			keyframe.pitch = std::atof(tokens[4].c_str());
+			outKeyframes.emplace_back(keyframe);
+		}
+
+		if (outKeyframes.empty())
+		{
+			DebugLogErrorFormat("Camera path \"%s\" has no keyframes.", filename.c_str());
+			return false;
+		}
+
+		return true;
+	}
+
+	CameraKeyframe GetCameraKeyframe(const std::vector<CameraKeyframe> &keyframes, int frameIndex, int frameCount)
+	{
+		const int keyframeCount = static_cast<int>(keyframes.size());
+		if ((keyframeCount == 1) || (frameCount <= 1))
+		{
+			return keyframes[0];
+		}
+
+		const double pathPercent = static_cast<double>(frameIndex) / static_cast<double>(frameCount - 1);
+		const double keyframeReal = pathPercent * static_cast<double>(keyframeCount - 1);
+		const int index0 = std::min(static_cast<int>(keyframeReal), keyframeCount - 2);
+		const int index1 = index0 + 1;
+		const double percent = keyframeReal - static_cast<double>(index0);
+
+		const CameraKeyframe &keyframe0 = keyframes[index0];
+		const CameraKeyframe &keyframe1 = keyframes[index1];
+		CameraKeyframe keyframe;
+		keyframe.position = keyframe0.position.lerp(keyframe1.position, percent);
+		keyframe.yaw = keyframe0.yaw + ((keyframe1.yaw - keyframe0.yaw) * percent);
+		keyframe.pitch = keyframe0.pitch + ((keyframe1.pitch - keyframe0.pitch) * percent);
+		return keyframe;
+	}
+}
+
+// Generated scene. Mimics a city block: a floor of tiles, walls of stacked voxels, and some alpha-tested sprites,
+// all within one chunk and lit by a handful of point lights.
+namespace
+{
+	constexpr int SCENE_GRID_SIZE = 48; // Voxels per side.
+	constexpr double SCENE_CENTER = static_cast<double>(SCENE_GRID_SIZE) * 0.50;
+	constexpr double ORBIT_RADIUS_MIN = 9.0; // No walls in the orbit ring so the camera stays in open space.
+	constexpr double ORBIT_RADIUS_MAX = 13.0;
+	constexpr double ORBIT_RADIUS = (ORBIT_RADIUS_MIN + ORBIT_RADIUS_MAX) * 0.50;
+	constexpr double CAMERA_HEIGHT = 0.60;
+	constexpr int MAX_WALL_HEIGHT = 3;
+	constexpr int SPRITE_COUNT = 128;
+	constexpr int LIGHT_COUNT = 24;
+	constexpr int LIGHT_LEVEL_COUNT = 13;
+	constexpr int TEXTURE_SIZE = 64;
+	constexpr int PALETTE_HUE_COUNT = 16; // Palette is 16 hues by 16 brightnesses.
+	constexpr int PALETTE_BRIGHTNESS_COUNT = 16;
+
+	struct BenchmarkMesh
+	{
+		VertexPositionBufferID positionBufferID;
+		VertexAttributeBufferID normalBufferID, texCoordBufferID;
+		IndexBufferID indexBufferID;
+	};
+
+	struct BenchmarkInstance
+	{
+		WorldDouble3 position;
+		const BenchmarkMesh *mesh;
+		RenderMaterialID materialID;
+	};
+
+	struct BenchmarkScene
+	{
+		BenchmarkMesh cubeMesh, floorMesh, spriteMesh;
+		ObjectTextureID paletteTextureID, lightTableTextureID, ditherTextureID, skyBgTextureID;
+		std::vector<BenchmarkInstance> instances;
+		std::vector<WorldDouble3> lightPositions;
+		std::vector<double> lightEndRadii;
+		UniformBufferID transformBufferID, lightBufferID;
+		std::vector<RenderDrawCall> drawCalls;
+	};
+
+	uint8_t MakePaletteIndex(int hue, int brightness)
+	{
+		return static_cast<uint8_t>((hue * PALETTE_BRIGHTNESS_COUNT) + brightness);
+	}
+
+	// Appends one quad per face with counter-clockwise winding when seen from outside, which is front-facing for the rasterizer.
+	void AppendQuad(const Double3 &origin, const Double3 &axisU, const Double3 &axisV, std::vector<double> &positions,
+		std::vector<double> &normals, std::vector<double> &texCoords, std::vector<int32_t> &indices)
+	{
+		const int32_t firstIndex = static_cast<int32_t>(positions.size() / MeshUtils::POSITION_COMPONENTS_PER_VERTEX);
+		const Double3 normal = axisU.cross(axisV).normalized();
+		const Double3 corners[] = { origin, origin + axisU, origin + axisU + axisV, origin + axisV };
+		constexpr double cornerTexCoords[] = { 0.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0 };
+
+		for (int i = 0; i < 4; i++)
+		{
+			const Double3 &corner = corners[i];
+			positions.insert(positions.end(), { corner.x, corner.y, corner.z });
+			normals.insert(normals.end(), { normal.x, normal.y, normal.z });
+			texCoords.insert(texCoords.end(), { cornerTexCoords[i * 2] * Constants::JustBelowOne, cornerTexCoords[(i * 2) + 1] * Constants::JustBelowOne });
+		}
+
+		indices.insert(indices.end(), { firstIndex, firstIndex + 1, firstIndex + 2, firstIndex + 2, firstIndex + 3, firstIndex });
+	}
+
+	bool TryCreateMesh(const std::vector<double> &positions, const std::vector<double> &normals, const std::vector<double> &texCoords,
+		const std::vector<int32_t> &indices, SoftwareRenderer &renderer, BenchmarkMesh *outMesh)
+	{
+		const int vertexCount = static_cast<int>(positions.size()) / MeshUtils::POSITION_COMPONENTS_PER_VERTEX;
+		const int indexCount = static_cast<int>(indices.size());
+		outMesh->positionBufferID = renderer.createVertexPositionBuffer(vertexCount, MeshUtils::POSITION_COMPONENTS_PER_VERTEX, sizeof(double));
+		outMesh->normalBufferID = renderer.createVertexAttributeBuffer(vertexCount, MeshUtils::NORMAL_COMPONENTS_PER_VERTEX, sizeof(double));
+		outMesh->texCoordBufferID = renderer.createVertexAttributeBuffer(vertexCount, MeshUtils::TEX_COORD_COMPONENTS_PER_VERTEX, sizeof(double));
+		outMesh->indexBufferID = renderer.createIndexBuffer(indexCount, sizeof(int32_t));
+		if ((outMesh->positionBufferID < 0) || (outMesh->normalBufferID < 0) || (outMesh->texCoordBufferID < 0) || (outMesh->indexBufferID < 0))
+		{
+			DebugLogError("Couldn't create benchmark mesh buffers.");
+			return false;
+		}
+
+		LockedBuffer lockedPositions = renderer.lockVertexPositionBuffer(outMesh->positionBufferID);
+		std::copy(positions.begin(), positions.end(), lockedPositions.getDoubles().begin());
+		renderer.unlockVertexPositionBuffer(outMesh->positionBufferID);
+
+		LockedBuffer lockedNormals = renderer.lockVertexAttributeBuffer(outMesh->normalBufferID);
+		std::copy(normals.begin(), normals.end(), lockedNormals.getDoubles().begin());
+		renderer.unlockVertexAttributeBuffer(outMesh->normalBufferID);
+
+		LockedBuffer lockedTexCoords = renderer.lockVertexAttributeBuffer(outMesh->texCoordBufferID);
+		std::copy(texCoords.begin(), texCoords.end(), lockedTexCoords.getDoubles().begin());
+		renderer.unlockVertexAttributeBuffer(outMesh->texCoordBufferID);
+
+		LockedBuffer lockedIndices = renderer.lockIndexBuffer(outMesh->indexBufferID);
+		std::copy(indices.begin(), indices.end(), lockedIndices.getInts().begin());
+		renderer.unlockIndexBuffer(outMesh->indexBufferID);
+
+		return true;
+	}
+
+	bool TryCreateMeshes(SoftwareRenderer &renderer, BenchmarkScene &scene)
+	{
+		std::vector<double> positions, normals, texCoords;
+		std::vector<int32_t> indices;
+
+		// Unit cube with its minimum corner at the origin.
+		AppendQuad(Double3(1.0, 0.0, 0.0), Double3::UnitY, Double3::UnitZ, positions, normals, texCoords, indices);
+		AppendQuad(Double3(0.0, 0.0, 1.0), -Double3::UnitZ, Double3::UnitY, positions, normals, texCoords, indices);
+		AppendQuad(Double3(0.0, 1.0, 0.0), Double3::UnitZ, Double3::UnitX, positions, normals, texCoords, indices);
+		AppendQuad(Double3(0.0, 0.0, 0.0), Double3::UnitX, Double3::UnitZ, positions, normals, texCoords, indices);
+		AppendQuad(Double3(0.0, 0.0, 1.0), Double3::UnitX, Double3::UnitY, positions, normals, texCoords, indices);
+		AppendQuad(Double3(1.0, 0.0, 0.0), -Double3::UnitX, Double3::UnitY, positions, normals, texCoords, indices);
+		if (!TryCreateMesh(positions, normals, texCoords, indices, renderer, &scene.cubeMesh))
+		{
+			return false;
+		}
+
+		positions.clear();
+		normals.clear();
+		texCoords.clear();
+		indices.clear();
+		AppendQuad(Double3::Zero, Double3::UnitZ, Double3::UnitX, positions, normals, texCoords, indices);
+		if (!TryCreateMesh(positions, normals, texCoords, indices, renderer, &scene.floorMesh))
+		{
+			return false;
+		}
+
+		positions.clear();
+		normals.clear();
+		texCoords.clear();
+		indices.clear();
+		AppendQuad(Double3(0.0, 0.0, -0.50), Double3::UnitZ, Double3::UnitY, positions, normals, texCoords, indices);
+		return TryCreateMesh(positions, normals, texCoords, indices, renderer, &scene.spriteMesh);
+	}
+
+	ObjectTextureID CreatePatternTexture(int hue, bool hasTransparency, SoftwareRenderer &renderer)
+	{
+		const ObjectTextureID textureID = renderer.createTexture(TEXTURE_SIZE, TEXTURE_SIZE, 1);
+		LockedTexture lockedTexture = renderer.lockTexture(textureID);
+		Span2D<uint8_t> texels = lockedTexture.getTexels8();
+		for (int y = 0; y < TEXTURE_SIZE; y++)
+		{
+			for (int x = 0; x < TEXTURE_SIZE; x++)
+			{
+				// Bricks with mortar lines, or a disc for sprites.
+				uint8_t texel;
+				if (hasTransparency)
+				{
+					const int dx = x - (TEXTURE_SIZE / 2);
+					const int dy = y - (TEXTURE_SIZE / 2);
+					const bool isInside = ((dx * dx) + (dy * dy)) < ((TEXTURE_SIZE * TEXTURE_SIZE) / 5);
+					texel = isInside ? MakePaletteIndex(hue, PALETTE_BRIGHTNESS_COUNT - 1 - ((dx * dx + dy * dy) % 5)) : 0;
+				}
+				else
+				{
+					const int brickRow = y / 8;
+					const int brickX = x + ((brickRow & 1) * 8);
+					const bool isMortar = ((y % 8) == 0) || ((brickX % 16) == 0);
+					texel = MakePaletteIndex(hue, isMortar ? 6 : (PALETTE_BRIGHTNESS_COUNT - 1 - ((x ^ y) & 3)));
+				}
+
+				texels.set(x, y, texel);
+			}
+		}
+
+		renderer.unlockTexture(textureID);
+		return textureID;
+	}
+
+	void CreateFrameTextures(SoftwareRenderer &renderer, BenchmarkScene &scene)
+	{
+		constexpr int paletteLength = PALETTE_HUE_COUNT * PALETTE_BRIGHTNESS_COUNT;
+		scene.paletteTextureID = renderer.createTexture(paletteLength, 1, 4);
+		LockedTexture lockedPalette = renderer.lockTexture(scene.paletteTextureID);
+		Span2D<uint32_t> paletteTexels = lockedPalette.getTexels32();
+		for (int hue = 0; hue < PALETTE_HUE_COUNT; hue++)
+		{
+			const double hueRadians = (static_cast<double>(hue) / static_cast<double>(PALETTE_HUE_COUNT)) * Constants::TwoPi;
+			const double r = 0.50 + (0.50 * std::cos(hueRadians));
+			const double g = 0.50 + (0.50 * std::cos(hueRadians - (Constants::TwoPi / 3.0)));
+			const double b = 0.50 + (0.50 * std::cos(hueRadians + (Constants::TwoPi / 3.0)));
+			for (int brightness = 0; brightness < PALETTE_BRIGHTNESS_COUNT; brightness++)
+			{
+				const double percent = static_cast<double>(brightness) / static_cast<double>(PALETTE_BRIGHTNESS_COUNT - 1);
+				const Color color(
+					static_cast<uint8_t>(r * percent * 255.0),
+					static_cast<uint8_t>(g * percent * 255.0),
+					static_cast<uint8_t>(b * percent * 255.0));
+				paletteTexels.set(MakePaletteIndex(hue, brightness), 0, color.toRGBA());
+			}
+		}
+
+		renderer.unlockTexture(scene.paletteTextureID);
+
+		// Light level 0 is the brightest, same as Arena's light tables.
+		scene.lightTableTextureID = renderer.createTexture(paletteLength, LIGHT_LEVEL_COUNT, 1);
+		LockedTexture lockedLightTable = renderer.lockTexture(scene.lightTableTextureID);
+		Span2D<uint8_t> lightTableTexels = lockedLightTable.getTexels8();
+		for (int lightLevel = 0; lightLevel < LIGHT_LEVEL_COUNT; lightLevel++)
+		{
+			const double lightPercent = 1.0 - (static_cast<double>(lightLevel) / static_cast<double>(LIGHT_LEVEL_COUNT - 1));
+			for (int i = 0; i < paletteLength; i++)
+			{
+				const int hue = i / PALETTE_BRIGHTNESS_COUNT;
+				const int brightness = i % PALETTE_BRIGHTNESS_COUNT;
+				const int litBrightness = static_cast<int>(std::round(static_cast<double>(brightness) * lightPercent));
+				lightTableTexels.set(i, lightLevel, MakePaletteIndex(hue, litBrightness));
+			}
+		}
+
+		renderer.unlockTexture(scene.lightTableTextureID);
+
+		// Placeholder dither texture, same as DitheringMode::None in the game.
+		scene.ditherTextureID = renderer.createTexture(1, 1, 1);
+		LockedTexture lockedDither = renderer.lockTexture(scene.ditherTextureID);
+		lockedDither.getTexels8().set(0, 0, 0);
+		renderer.unlockTexture(scene.ditherTextureID);
+
+		scene.skyBgTextureID = renderer.createTexture(1, 1, 1);
+		LockedTexture lockedSkyBg = renderer.lockTexture(scene.skyBgTextureID);
+		lockedSkyBg.getTexels8().set(0, 0, MakePaletteIndex(10, PALETTE_BRIGHTNESS_COUNT - 1));
+		renderer.unlockTexture(scene.skyBgTextureID);
+	}
+
+	RenderMaterialID CreateMaterial(FragmentShaderType fragmentShaderType, ObjectTextureID textureID, bool enableBackFaceCulling,
+		SoftwareRenderer &renderer)
+	{
+		RenderMaterialKey materialKey;
+		materialKey.init(VertexShaderType::Basic, fragmentShaderType, Span<const ObjectTextureID>(&textureID, 1), RenderLightingType::PerPixel,
+			enableBackFaceCulling, true, true);
+		return renderer.createMaterial(materialKey);
+	}
+
+	bool TryCreateScene(int seed, SoftwareRenderer &renderer, BenchmarkScene &scene)
+	{
+		if (!TryCreateMeshes(renderer, scene))
+		{
+			return false;
+		}
+
+		CreateFrameTextures(renderer, scene);
+
+		constexpr int wallMaterialCount = 6;
+		RenderMaterialID wallMaterialIDs[wallMaterialCount];
+		for (int i = 0; i < wallMaterialCount; i++)
+		{
+			const ObjectTextureID textureID = CreatePatternTexture(i * 2, false, renderer);
+			wallMaterialIDs[i] = CreateMaterial(FragmentShaderType::Opaque, textureID, true, renderer);
+		}
+
+		const ObjectTextureID floorTextureID = CreatePatternTexture(13, false, renderer);
+		const RenderMaterialID floorMaterialID = CreateMaterial(FragmentShaderType::Opaque, floorTextureID, true, renderer);
+		const ObjectTextureID spriteTextureID = CreatePatternTexture(4, true, renderer);
+		const RenderMaterialID spriteMaterialID = CreateMaterial(FragmentShaderType::AlphaTested, spriteTextureID, false, renderer);
+
+		Random random(seed);
+		for (int z = 0; z < SCENE_GRID_SIZE; z++)
+		{
+			for (int x = 0; x < SCENE_GRID_SIZE; x++)
+			{
+				scene.instances.push_back({ WorldDouble3(x, 0.0, z), &scene.floorMesh, floorMaterialID });
+
+				const double dx = (static_cast<double>(x) + 0.50) - SCENE_CENTER;
+				const double dz = (static_cast<double>(z) + 0.50) - SCENE_CENTER;
+				const double distance = std::sqrt((dx * dx) + (dz * dz));
+				const bool isInOrbitRing = (distance >= ORBIT_RADIUS_MIN) && (distance <= ORBIT_RADIUS_MAX);
+				if (!isInOrbitRing && (random.next(4) == 0))
+				{
+					const RenderMaterialID wallMaterialID = wallMaterialIDs[random.next(wallMaterialCount)];
+					const int wallHeight = 1 + random.next(MAX_WALL_HEIGHT);
+					for (int y = 0; y < wallHeight; y++)
+					{
+						scene.instances.push_back({ WorldDouble3(x, y, z), &scene.cubeMesh, wallMaterialID });
+					}
+				}
+			}
+		}
+
+		for (int i = 0; i < SPRITE_COUNT; i++)
+		{
+			const double angle = random.nextReal() * Constants::TwoPi;
+			const double radius = ORBIT_RADIUS_MIN + (random.nextReal() * (ORBIT_RADIUS_MAX - ORBIT_RADIUS_MIN));
+			const WorldDouble3 position(SCENE_CENTER + (std::cos(angle) * radius), 0.0, SCENE_CENTER + (std::sin(angle) * radius));
+			scene.instances.push_back({ position, &scene.spriteMesh, spriteMaterialID });
+		}
+
+		for (int i = 0; i < LIGHT_COUNT; i++)
+		{
+			const double x = random.nextReal() * static_cast<double>(SCENE_GRID_SIZE);
+			const double z = random.nextReal() * static_cast<double>(SCENE_GRID_SIZE);
+			scene.lightPositions.emplace_back(WorldDouble3(x, 1.0, z));
+			scene.lightEndRadii.emplace_back(3.0 + (random.nextReal() * 4.0));
+		}
+
+		const int instanceCount = static_cast<int>(scene.instances.size());
+		scene.transformBufferID = renderer.createUniformBuffer(instanceCount, sizeof(Matrix4d), alignof(Matrix4d));
+		scene.lightBufferID = renderer.createUniformBuffer(LIGHT_COUNT, sizeof(double) * 5, sizeof(double));
+		if ((scene.transformBufferID < 0) || (scene.lightBufferID < 0))
+		{
+			DebugLogError("Couldn't create benchmark uniform buffers.");
+			return false;
+		}
+
+		scene.drawCalls.resize(instanceCount);
+		for (int i = 0; i < instanceCount; i++)
+		{
+			const BenchmarkInstance &instance = scene.instances[i];
+			RenderDrawCall &drawCall = scene.drawCalls[i];
+			drawCall.transformBufferID = scene.transformBufferID;
+			drawCall.transformIndex = i;
+			drawCall.positionBufferID = instance.mesh->positionBufferID;
+			drawCall.normalBufferID = instance.mesh->normalBufferID;
+			drawCall.texCoordBufferID = instance.mesh->texCoordBufferID;
+			drawCall.indexBufferID = instance.mesh->indexBufferID;
+			drawCall.materialID = instance.materialID;
+		}
+
+		return true;
+	}
+
+	// Transforms and lights are relative to the camera's chunk, same as the game's floating origin.
+	void UpdateSceneUniforms(const RenderCamera &camera, SoftwareRenderer &renderer, BenchmarkScene &scene)
+	{
+		const int instanceCount = static_cast<int>(scene.instances.size());
+		LockedBuffer lockedTransforms = renderer.lockUniformBuffer(scene.transformBufferID);
+		for (int i = 0; i < instanceCount; i++)
+		{
+			const BenchmarkInstance &instance = scene.instances[i];
+			const Double3 position = instance.position - camera.floatingOriginPoint;
+			Matrix4d transform = Matrix4d::translation(position.x, position.y, position.z);
+			if (instance.mesh == &scene.spriteMesh)
+			{
+				// Billboard facing the camera around the Y axis.
+				const Double3 toCamera = camera.worldPoint - instance.position;
+				const Radians yaw = std::atan2(-toCamera.z, -toCamera.x);
+				transform = transform * Matrix4d::yRotation(yaw);
+			}
+
+			std::memcpy(lockedTransforms.bytes.begin() + (i * lockedTransforms.bytesPerStride), &transform, sizeof(transform));
+		}
+
+		renderer.unlockUniformBuffer(scene.transformBufferID);
+
+		LockedBuffer lockedLights = renderer.lockUniformBuffer(scene.lightBufferID);
+		for (int i = 0; i < LIGHT_COUNT; i++)
+		{
+			const Double3 position = scene.lightPositions[i] - camera.floatingOriginPoint;
+			const double lightValues[] = { position.x, position.y, position.z, 0.0, scene.lightEndRadii[i] };
+			std::memcpy(lockedLights.bytes.begin() + (i * lockedLights.bytesPerStride), lightValues, sizeof(lightValues));
+		}
+
+		renderer.unlockUniformBuffer(scene.lightBufferID);
+	}
+}
+
+// Texel fetch microbenchmark.
+namespace
+{
+	// Larger than L2 on most CPUs so the layouts differ in how many cache lines a span touches, not just L1 hits.
+	constexpr int TEXEL_FETCH_TEXTURE_SIZE = 1024;
+	constexpr int TEXEL_FETCH_SPAN_LENGTH = 256; // Pixels per span, one texel step per pixel.
+	constexpr int TEXEL_FETCH_SPAN_COUNT = 16384;
+	constexpr int TEXEL_FETCH_REPEAT_COUNT = 8;
+
+	// Same texel addressing as the software renderer's perspective sampling, tiled or row-major.
+	template<bool isTiled>
+	uint32_t FetchTexelSpans(const uint8_t *texels, const std::vector<double> &spanStartUs, const std::vector<double> &spanStartVs,
+		double texCoordStepU, double texCoordStepV)
+	{
+		constexpr double textureSizeReal = static_cast<double>(TEXEL_FETCH_TEXTURE_SIZE);
+		const int tileCountX = SoftwareObjectTexture::getTileCount(TEXEL_FETCH_TEXTURE_SIZE);
+
+		uint32_t checksum = 0;
+		for (int spanIndex = 0; spanIndex < static_cast<int>(spanStartUs.size()); spanIndex++)
+		{
+			double u = spanStartUs[spanIndex];
+			double v = spanStartVs[spanIndex];
+			for (int i = 0; i < TEXEL_FETCH_SPAN_LENGTH; i++)
+			{
+				const int texelX = static_cast<int>((u - std::floor(u)) * textureSizeReal);
+				const int texelY = static_cast<int>((v - std::floor(v)) * textureSizeReal);
+
+				int texelIndex;
+				if constexpr (isTiled)
+				{
+					texelIndex = SoftwareObjectTexture::getTiledTexelIndex(texelX, texelY, tileCountX);
+				}
+				else
+				{
+					texelIndex = texelX + (texelY * TEXEL_FETCH_TEXTURE_SIZE);
+				}
+
+				checksum += texels[texelIndex];
+				u += texCoordStepU;
+				v += texCoordStepV;
+			}
+		}
+
+		return checksum;
+	}
+
+	template<bool isTiled>
+	double GetTexelFetchThroughput(const uint8_t *texels, const std::vector<double> &spanStartUs, const std::vector<double> &spanStartVs,
+		double texCoordStepU, double texCoordStepV, uint32_t *outChecksum)
+	{
+		FetchTexelSpans<isTiled>(texels, spanStartUs, spanStartVs, texCoordStepU, texCoordStepV); // Warm-up.
+
+		const auto startTime = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < TEXEL_FETCH_REPEAT_COUNT; i++)
+		{
+			*outChecksum += FetchTexelSpans<isTiled>(texels, spanStartUs, spanStartVs, texCoordStepU, texCoordStepV);
+		}
+
+		const auto endTime = std::chrono::high_resolution_clock::now();
+		const double seconds = static_cast<double>((endTime - startTime).count()) / static_cast<double>(std::nano::den);
+		const double fetchCount = static_cast<double>(TEXEL_FETCH_REPEAT_COUNT) * static_cast<double>(spanStartUs.size()) *
+			static_cast<double>(TEXEL_FETCH_SPAN_LENGTH);
+		return (fetchCount / seconds) / 1000000.0;
+	}
+
+	void RunTexelFetchBenchmark(int seed)
+	{
+		Random random(seed);
+
+		constexpr int texelCount = TEXEL_FETCH_TEXTURE_SIZE * TEXEL_FETCH_TEXTURE_SIZE;
+		std::vector<uint8_t> linearTexels(texelCount);
+		for (uint8_t &texel : linearTexels)
+		{
+			texel = static_cast<uint8_t>(random.next(256));
+		}
+
+		const int tileCount = SoftwareObjectTexture::getTileCount(TEXEL_FETCH_TEXTURE_SIZE);
+		std::vector<uint8_t> tiledTexels(tileCount * tileCount * SoftwareObjectTexture::TILE_TEXEL_COUNT);
+		for (int y = 0; y < TEXEL_FETCH_TEXTURE_SIZE; y++)
+		{
+			for (int x = 0; x < TEXEL_FETCH_TEXTURE_SIZE; x++)
+			{
+				tiledTexels[SoftwareObjectTexture::getTiledTexelIndex(x, y, tileCount)] = linearTexels[x + (y * TEXEL_FETCH_TEXTURE_SIZE)];
+			}
+		}
+
+		std::vector<double> spanStartUs(TEXEL_FETCH_SPAN_COUNT);
+		std::vector<double> spanStartVs(TEXEL_FETCH_SPAN_COUNT);
+		for (int i = 0; i < TEXEL_FETCH_SPAN_COUNT; i++)
+		{
+			spanStartUs[i] = random.nextReal();
+			spanStartVs[i] = random.nextReal();
+		}
+
+		// Axis-aligned walks along a texel row like a wall facing the camera. Oblique walks mostly down texel
+		// columns like a wall seen at a steep angle.
+		constexpr double texelStep = 1.0 / static_cast<double>(TEXEL_FETCH_TEXTURE_SIZE);
+		constexpr double axisAlignedStepU = texelStep;
+		constexpr double axisAlignedStepV = 0.0;
+		constexpr double obliqueStepU = texelStep * 0.25;
+		constexpr double obliqueStepV = texelStep;
+
+		uint32_t checksum = 0;
+		const double linearAxisAligned = GetTexelFetchThroughput<false>(linearTexels.data(), spanStartUs, spanStartVs, axisAlignedStepU, axisAlignedStepV, &checksum);
+		const double tiledAxisAligned = GetTexelFetchThroughput<true>(tiledTexels.data(), spanStartUs, spanStartVs, axisAlignedStepU, axisAlignedStepV, &checksum);
+		const double linearOblique = GetTexelFetchThroughput<false>(linearTexels.data(), spanStartUs, spanStartVs, obliqueStepU, obliqueStepV, &checksum);
+		const double tiledOblique = GetTexelFetchThroughput<true>(tiledTexels.data(), spanStartUs, spanStartVs, obliqueStepU, obliqueStepV, &checksum);
+
+		std::printf("Texel fetch: %dx%d 8-bit texture, %d spans of %d texels, %d repeats\n", TEXEL_FETCH_TEXTURE_SIZE, TEXEL_FETCH_TEXTURE_SIZE,
+			TEXEL_FETCH_SPAN_COUNT, TEXEL_FETCH_SPAN_LENGTH, TEXEL_FETCH_REPEAT_COUNT);
+		std::printf("Axis-aligned: linear %.1f Mtexels/s, tiled %.1f Mtexels/s (%.2fx)\n", linearAxisAligned, tiledAxisAligned,
+			tiledAxisAligned / linearAxisAligned);
+		std::printf("Oblique: linear %.1f Mtexels/s, tiled %.1f Mtexels/s (%.2fx)\n", linearOblique, tiledOblique,
+			tiledOblique / linearOblique);
+		std::printf("Checksum: %u\n", checksum);
+	}
+}
+
+// Results.
+namespace
+{
+	double GetPercentile(const std::vector<double> &sortedValues, double percent)
+	{
+		DebugAssert(!sortedValues.empty());
+		const double indexReal = percent * static_cast<double>(sortedValues.size() - 1);
+		const int index = static_cast<int>(std::round(indexReal));
+		return sortedValues[index];
+	}
+
+	void PrintResults(const BenchmarkSettings &settings, const BenchmarkScene &scene, std::vector<double> frameTimes,
+		const std::vector<RendererProfilerData3D> &profilerDatas)
+	{
+		std::sort(frameTimes.begin(), frameTimes.end());
+
+		double totalFrameTime = 0.0;
+		for (const double frameTime : frameTimes)
+		{
+			totalFrameTime += frameTime;
+		}
+
+		const double frameCountReal = static_cast<double>(frameTimes.size());
+		const double meanFrameTime = totalFrameTime / frameCountReal;
+
+		std::printf("Resolution: %dx%d, render threads mode: %d, spin: %d us, affinity: %s, precision: %s\n", settings.width, settings.height,
+			settings.renderThreadsMode, settings.renderThreadsSpinMicroseconds, settings.enableThreadAffinity ? "on" : "off",
+			(settings.rasterPrecisionMode == RasterPrecisionMode::Single) ? "single" : "double");
+		std::printf("Scene: %d draw calls, %d lights, %d frames (%d warmup)\n", static_cast<int>(scene.drawCalls.size()), LIGHT_COUNT,
+			settings.frameCount, settings.warmupFrameCount);
+		std::printf("Frame time (ms): mean %.3f, p50 %.3f, p90 %.3f, p99 %.3f, min %.3f, max %.3f (%.1f FPS)\n",
+			meanFrameTime * 1000.0, GetPercentile(frameTimes, 0.50) * 1000.0, GetPercentile(frameTimes, 0.90) * 1000.0,
+			GetPercentile(frameTimes, 0.99) * 1000.0, frameTimes.front() * 1000.0, frameTimes.back() * 1000.0, 1.0 / meanFrameTime);
+
+		// Averaged per-frame renderer counters.
+		double drawCallCount = 0.0;
+		double sortedDrawCallCount = 0.0;
+		double presentedTriangleCount = 0.0;
+		double totalLightCount = 0.0;
+		double totalCoverageTests = 0.0;
+		double totalCoverageBlockAccepts = 0.0;
+		double totalDepthTests = 0.0;
+		double totalColorWrites = 0.0;
+		double totalShadedFragments = 0.0;
+		double totalMipmappedFragments = 0.0;
+		double totalLitFragments = 0.0;
+		double totalFragmentLightTests = 0.0;
+		int64_t binArenaPeakByteCount = 0;
+		double binCount = 0.0;
+		double binnedTriangleCount = 0.0;
+		int maxBinTriangleCount = 0;
+		std::vector<double> workerBusyTimes, workerIdleTimes;
+		for (const RendererProfilerData3D &profilerData : profilerDatas)
+		{
+			drawCallCount += static_cast<double>(profilerData.drawCallCount);
+			sortedDrawCallCount += static_cast<double>(profilerData.sortedDrawCallCount);
+			presentedTriangleCount += static_cast<double>(profilerData.presentedTriangleCount);
+			totalLightCount += static_cast<double>(profilerData.totalLightCount);
+			totalCoverageTests += static_cast<double>(profilerData.totalCoverageTests);
+			totalCoverageBlockAccepts += static_cast<double>(profilerData.totalCoverageBlockAccepts);
+			totalDepthTests += static_cast<double>(profilerData.totalDepthTests);
+			totalColorWrites += static_cast<double>(profilerData.totalColorWrites);
+			totalShadedFragments += static_cast<double>(profilerData.totalShadedFragments);
+			totalMipmappedFragments += static_cast<double>(profilerData.totalMipmappedFragments);
+			totalLitFragments += static_cast<double>(profilerData.totalLitFragments);
+			totalFragmentLightTests += static_cast<double>(profilerData.totalFragmentLightTests);
+			binArenaPeakByteCount = std::max(binArenaPeakByteCount, profilerData.binArenaPeakByteCount);
+			binCount += static_cast<double>(profilerData.binCount);
+			binnedTriangleCount += static_cast<double>(profilerData.binnedTriangleCount);
+			maxBinTriangleCount = std::max(maxBinTriangleCount, profilerData.maxBinTriangleCount);
+
+			workerBusyTimes.resize(std::max(workerBusyTimes.size(), profilerData.workerBusyTimes.size()), 0.0);
+			workerIdleTimes.resize(std::max(workerIdleTimes.size(), profilerData.workerIdleTimes.size()), 0.0);
+			for (size_t i = 0; i < profilerData.workerBusyTimes.size(); i++)
+			{
+				workerBusyTimes[i] += profilerData.workerBusyTimes[i];
+				workerIdleTimes[i] += profilerData.workerIdleTimes[i];
+			}
+		}
+
+		const RendererProfilerData3D &lastProfilerData = profilerDatas.back();
+		std::printf("Threads: %d\n", lastProfilerData.threadCount);
+		std::printf("Draw calls: %.0f (%.0f sorted), presented triangles: %.0f, visible lights: %.0f\n", drawCallCount / frameCountReal,
+			sortedDrawCallCount / frameCountReal, presentedTriangleCount / frameCountReal, totalLightCount / frameCountReal);
+		std::printf("Coverage tests: %.0f, depth tests: %.0f, color writes: %.0f (%.2f per pixel)\n", totalCoverageTests / frameCountReal,
+			totalDepthTests / frameCountReal, totalColorWrites / frameCountReal,
+			(totalColorWrites / frameCountReal) / static_cast<double>(settings.width * settings.height));
+		std::printf("Block-accepted pixels: %.0f (%.1f%% of covered-or-tested pixels)\n", totalCoverageBlockAccepts / frameCountReal,
+			(totalCoverageBlockAccepts / std::max(totalCoverageBlockAccepts + totalCoverageTests, 1.0)) * 100.0);
+		std::printf("Shaded fragments: %.0f (%.2f per pixel), mipmapped: %.1f%%\n", totalShadedFragments / frameCountReal,
+			(totalShadedFragments / frameCountReal) / static_cast<double>(settings.width * settings.height),
+			(totalMipmappedFragments / std::max(totalShadedFragments, 1.0)) * 100.0);
+		std::printf("Lit fragments: %.0f, lights per lit fragment: %.2f\n", totalLitFragments / frameCountReal,
+			totalFragmentLightTests / std::max(totalLitFragments, 1.0));
+		std::printf("Textures: %d (%.2f MB, +%.2f MB mips), materials: %d, bin arena peak: %.2f KB\n", lastProfilerData.objectTextureCount,
+			static_cast<double>(lastProfilerData.objectTextureByteCount) / (1024.0 * 1024.0),
+			static_cast<double>(lastProfilerData.objectTextureMipByteCount) / (1024.0 * 1024.0), lastProfilerData.materialCount,
+			static_cast<double>(binArenaPeakByteCount) / 1024.0);
+		std::printf("Bins: %.1f (last %dx%d), binned triangles: %.0f (%.1f per bin), busiest bin: %d triangles\n", binCount / frameCountReal,
+			lastProfilerData.binWidth, lastProfilerData.binHeight, binnedTriangleCount / frameCountReal, binnedTriangleCount / std::max(binCount, 1.0),
+			maxBinTriangleCount);
+
+		for (size_t i = 0; i < workerBusyTimes.size(); i++)
+		{
+			const int cpuID = (i < lastProfilerData.workerCpuIDs.size()) ? lastProfilerData.workerCpuIDs[i] : -1;
+			const std::string cpuText = (cpuID >= 0) ? ("CPU " + std::to_string(cpuID)) : "unpinned";
+			std::printf("Worker %d (%s): busy %.3f ms, idle %.3f ms\n", static_cast<int>(i), cpuText.c_str(),
+				(workerBusyTimes[i] / frameCountReal) * 1000.0, (workerIdleTimes[i] / frameCountReal) * 1000.0);
+		}
+	}
+
+	bool TryWriteStageCsv(const std::string &filename, const std::vector<double> &frameTimes, const std::vector<RendererProfilerData3D> &profilerDatas)
+	{
+		std::FILE *file = std::fopen(filename.c_str(), "w");
+		if (file == nullptr)
+		{
+			DebugLogError("Couldn't open stage CSV \"" + filename + "\" for writing.");
+			return false;
+		}
+
+		std::fprintf(file, "frame,thread,cpu,frame_ms");
+		for (const char *stageName : RENDERER_PROFILER_STAGE_NAMES)
+		{
+			std::fprintf(file, ",%s_ms", stageName);
+		}
+
+		std::fprintf(file, ",idle_ms\n");
+
+		for (size_t frameIndex = 0; frameIndex < profilerDatas.size(); frameIndex++)
+		{
+			const RendererProfilerData3D &profilerData = profilerDatas[frameIndex];
+			const int threadCount = static_cast<int>(profilerData.workerStageTimes.size()) / RENDERER_PROFILER_STAGE_COUNT;
+			for (int threadIndex = 0; threadIndex < threadCount; threadIndex++)
+			{
+				const int cpuID = (threadIndex < static_cast<int>(profilerData.workerCpuIDs.size())) ? profilerData.workerCpuIDs[threadIndex] : -1;
+				std::fprintf(file, "%d,%d,%d,%.4f", static_cast<int>(frameIndex), threadIndex, cpuID, frameTimes[frameIndex] * 1000.0);
+
+				for (int stageIndex = 0; stageIndex < RENDERER_PROFILER_STAGE_COUNT; stageIndex++)
+				{
+					const double stageTime = profilerData.workerStageTimes[(threadIndex * RENDERER_PROFILER_STAGE_COUNT) + stageIndex];
+					std::fprintf(file, ",%.4f", stageTime * 1000.0);
+				}
+
+				const double idleTime = (threadIndex < static_cast<int>(profilerData.workerIdleTimes.size())) ? profilerData.workerIdleTimes[threadIndex] : 0.0;
+				std::fprintf(file, ",%.4f\n", idleTime * 1000.0);
+			}
+		}
+
+		std::fclose(file);
+		return true;
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	BenchmarkSettings settings;
+	if (!TryParseArgs(argc, argv, &settings))
+	{
+		PrintUsage();
+		return EXIT_FAILURE;
+	}
+
+	if (settings.isTexelFetchOnly)
+	{
+		RunTexelFetchBenchmark(settings.seed);
+		return EXIT_SUCCESS;
+	}
+
+	const std::string logPath = Platform::getLogPath();
+	if (!Debug::init(logPath.c_str()))
+	{
+		std::fprintf(stderr, "Couldn't init debug logging.\n");
+		return EXIT_FAILURE;
+	}
+
+	std::vector<CameraKeyframe> cameraKeyframes;
+	if (!settings.cameraPathFilename.empty())
+	{
+		if (!TryLoadCameraPath(settings.cameraPathFilename, cameraKeyframes))
+		{
+			Debug::shutdown();
+			return EXIT_FAILURE;
+		}
+	}
+
+	RenderInitSettings initSettings;
+	initSettings.init(nullptr, std::string(), settings.width, settings.height, settings.renderThreadsMode, DitheringMode::None);
+
+	SoftwareRenderer renderer;
+	if (!renderer.init(initSettings))
+	{
+		DebugLogError("Couldn't init software renderer.");
+		Debug::shutdown();
+		return EXIT_FAILURE;
+	}
+
+	BenchmarkScene scene;
+	if (!TryCreateScene(settings.seed, renderer, scene))
+	{
+		renderer.shutdown();
+		Debug::shutdown();
+		return EXIT_FAILURE;
+	}
+
+	RenderDrawCommandList commandList;
+	commandList.addDrawCalls(Span<const RenderDrawCall>(scene.drawCalls.data(), static_cast<int>(scene.drawCalls.size())));
+
+	// No queued frames or static frame reuse, each frame time covers all of its rendering.
+	RenderFrameSettings frameSettings;
+	frameSettings.init(Colors::Black, 0.20, scene.lightBufferID, LIGHT_COUNT, 0.0, scene.paletteTextureID, scene.lightTableTextureID,
+		scene.ditherTextureID, scene.skyBgTextureID, settings.renderThreadsMode, DitheringMode::None);
+	frameSettings.renderThreadsSpinMicroseconds = settings.renderThreadsSpinMicroseconds;
+	frameSettings.enableRenderThreadsAffinity = settings.enableThreadAffinity;
+	frameSettings.enableDrawCallSorting = settings.enableDrawCallSorting;
+	frameSettings.enableAdaptiveBinSizing = settings.enableAdaptiveBinSizing;
+	frameSettings.enableInterlacing = settings.enableInterlacing;
+	frameSettings.enableMipmaps = settings.enableMipmaps;
+	frameSettings.enableTiledTexels = settings.enableTiledTexels;
+	frameSettings.rasterPrecisionMode = settings.rasterPrecisionMode;
+	frameSettings.shadingMode = settings.shadingMode;
+	frameSettings.enableStageTimers = !settings.stageCsvFilename.empty();
+
+	constexpr Degrees fovY = 60.0;
+	const double aspectRatio = static_cast<double>(settings.width) / static_cast<double>(settings.height);
+	const double tallPixelRatio = RendererUtils::getTallPixelRatio(true);
+	std::vector<uint32_t> outputBuffer(settings.width * settings.height);
+
+	std::vector<double> frameTimes;
+	std::vector<RendererProfilerData3D> profilerDatas;
+	frameTimes.reserve(settings.frameCount);
+	profilerDatas.reserve(settings.frameCount);
+
+	const int totalFrameCount = settings.warmupFrameCount + settings.frameCount;
+	for (int i = 0; i < totalFrameCount; i++)
+	{
+		const int pathFrameIndex = std::max(i - settings.warmupFrameCount, 0);
+
+		CameraKeyframe keyframe;
+		if (!cameraKeyframes.empty())
+		{
+			keyframe = GetCameraKeyframe(cameraKeyframes, pathFrameIndex, settings.frameCount);
+		}
+		else
+		{
+			const double orbitPercent = static_cast<double>(pathFrameIndex) / static_cast<double>(settings.frameCount);
+			const double orbitRadians = orbitPercent * Constants::TwoPi;
+			keyframe.position = WorldDouble3(
+				SCENE_CENTER + (std::cos(orbitRadians) * ORBIT_RADIUS),
+				CAMERA_HEIGHT,
+				SCENE_CENTER + (std::sin(orbitRadians) * ORBIT_RADIUS));
+			keyframe.yaw = -MathUtils::radToDeg(orbitRadians); // Look along the orbit.
+			keyframe.pitch = 0.0;
+		}
+
+		RenderCamera camera;
+		camera.init(keyframe.position, keyframe.yaw, keyframe.pitch, fovY, aspectRatio, tallPixelRatio);
+		UpdateSceneUniforms(camera, renderer, scene);
+
+		const auto frameStartTime = std::chrono::high_resolution_clock::now();
+		renderer.submitFrame(commandList, camera, frameSettings, outputBuffer.data());
+		const auto frameEndTime = std::chrono::high_resolution_clock::now();
+
+		if (i >= settings.warmupFrameCount)
+		{
+			const double frameTime = static_cast<double>((frameEndTime - frameStartTime).count()) / static_cast<double>(std::nano::den);
+			frameTimes.emplace_back(frameTime);
+			profilerDatas.emplace_back(renderer.getProfilerData());
+		}
+	}
+
+	PrintResults(settings, scene, frameTimes, profilerDatas);
+
+	if (!settings.stageCsvFilename.empty())
+	{
+		if (TryWriteStageCsv(settings.stageCsvFilename, frameTimes, profilerDatas))
+		{
+			std::printf("Stage times: %s\n", settings.stageCsvFilename.c_str());
+		}
+	}
+
+	renderer.shutdown();
+	Debug::shutdown();
+
+	return EXIT_SUCCESS;
+}
@@ -400,6 +400,7 @@ void EntityChunkManager::initializeEntity(EntityInstance &entityInst, EntityInst
 
 	const EntityDefID defID = initInfo.defID;
 	entityInst.init(instID, defID, positionID, bboxID, transformHeapIndex, transformIndex);
+	this->createdEntityIDs.emplace_back(instID);
 
 	WorldDouble3 &entityPosition = this->positions.get(positionID);
 	entityPosition = initInfo.feetPosition;
@@ -1870,6 +1871,7 @@ void EntityChunkManager::updateFadedElevatedPlatforms(EntityChunk &entityChunk,
 					const float entityColliderHeight = entityColliderBBox.GetSize().GetY();
 					const double newEntityFeetY = ceilingScale;
 					entityPosition.y = newEntityFeetY; // Probably don't need entity def Y offset
+					this->movedEntityIDs.emplace_back(entityInstID);
 
 					const double newEntityPhysicsCenterY = newEntityFeetY + (entityColliderHeight * 0.50);
 					const JPH::RVec3 newEntityPhysicsPosition(oldEntityPhysicsPosition.GetX(), static_cast<float>(newEntityPhysicsCenterY), oldEntityPhysicsPosition.GetZ());
@@ -2274,6 +2276,11 @@ void EntityChunkManager::updatePostPhysicsStep(const VoxelChunkManager &voxelChu
 				static_cast<double>(physicsPosition.GetY() - physicsColliderCenterToFeetDistance),
 				static_cast<WEDouble>(physicsPosition.GetZ()));
 			entityPosition = newPosition;
+
+			if (newPosition != oldPosition)
+			{
+				this->movedEntityIDs.emplace_back(entityInstID);
+			}
 		}
 	}
 
@@ -2294,6 +2301,11 @@ void EntityChunkManager::updatePostPhysicsStep(const VoxelChunkManager &voxelChu
 			static_cast<double>(physicsPosition.GetY() - physicsColliderCenterToFeetDistance),
 			static_cast<WEDouble>(physicsPosition.GetZ()));
 		entityPosition = newPosition;
+
+		if (newPosition != oldPosition)
+		{
+			this->movedEntityIDs.emplace_back(entityInstID);
+		}
 	};
 
 	for (const EntityInstanceID entityInstID : this->citizenEntityInstIDs)
@@ -2497,6 +2509,8 @@ void EntityChunkManager::endFrame(JPH::PhysicsSystem &physicsSystem, Renderer &r
 	}
 
 	this->destroyedEntityIDs.clear();
+	this->createdEntityIDs.clear();
+	this->movedEntityIDs.clear();
 }
 
 void EntityChunkManager::clear(JPH::PhysicsSystem &physicsSystem, Renderer &renderer)
@@ -212,6 +212,12 @@ public:
 	// Entities scheduled for destruction from memory this frame. These should not be simulated or rendered.
 	std::vector<EntityInstanceID> destroyedEntityIDs;
 
+	// Entities initialized this frame, so other systems can pick them up without scanning every chunk. May also be in the destroyed list.
+	std::vector<EntityInstanceID> createdEntityIDs;
+
+	// Entities whose position changed this frame after being initialized. May contain duplicates.
+	std::vector<EntityInstanceID> movedEntityIDs;
+
 	// Voxels treated as solid for pathfinding due to the presence of an entity.
 	std::unordered_map<WorldInt2, EntityInstanceID> occupiedVoxels;
 private:
@@ -1,7 +1,10 @@
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <cstdint>
 #include <filesystem>
+#include <fstream>
+#include <numeric>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -40,6 +43,7 @@
 #include "../Player/PlayerInterface.h"
 #include "../Player/PlayerLogic.h"
 #include "../Player/WeaponAnimationLibrary.h"
+#include "../Rendering/RenderBackend.h"
 #include "../Rendering/RenderBackendType.h"
 #include "../Rendering/RenderCamera.h"
 #include "../Rendering/RenderDrawCommand.h"
@@ -73,12 +77,15 @@
 
 namespace
 {
+	constexpr int PROFILER_HISTORY_FRAME_COUNT = 600; // Ten seconds at 60 FPS.
+
 	struct FrameTimer
 	{
 		std::chrono::nanoseconds maximumFrameDuration; // Longest allowed frame time before engine will run in slow motion.
 		std::chrono::nanoseconds minimumFrameDuration; // Shortest allowed frame time if not enough work is happening.
 		std::chrono::time_point<std::chrono::high_resolution_clock> previousTimePoint, currentTimePoint;
 		double deltaTime; // Difference between frame times in seconds.
+		double workTime; // Previous frame time in seconds before sleeping to match the target FPS.
 		double clampedDeltaTime; // For game logic calculations that become imprecise or break at low FPS.
 		int physicsSteps; // 1 unless the engine has to do more steps this frame to keep numeric accuracy.
 
@@ -87,6 +94,7 @@ namespace
 			this->maximumFrameDuration = std::chrono::nanoseconds(0);
 			this->minimumFrameDuration = std::chrono::nanoseconds(0);
 			this->deltaTime = 0.0;
+			this->workTime = 0.0;
 			this->clampedDeltaTime = 0.0;
 			this->physicsSteps = 0;
 		}
@@ -105,6 +113,7 @@ namespace
 			this->currentTimePoint = std::chrono::high_resolution_clock::now();
 
 			auto previousFrameDuration = this->currentTimePoint - this->previousTimePoint;
+			const auto previousFrameWorkDuration = previousFrameDuration;
 			if (previousFrameDuration < this->minimumFrameDuration)
 			{
 				const auto sleepBias = previousFrameDuration / 1000; // Keep slightly above target FPS instead of slightly below.
@@ -129,6 +138,7 @@ namespace
 
 			constexpr double timeUnitsReal = static_cast<double>(std::nano::den);
 			this->deltaTime = static_cast<double>(previousFrameDuration.count()) / timeUnitsReal;
+			this->workTime = static_cast<double>(previousFrameWorkDuration.count()) / timeUnitsReal;
 			this->clampedDeltaTime = std::fmin(previousFrameDuration.count(), this->maximumFrameDuration.count()) / timeUnitsReal;
 			this->physicsSteps = static_cast<int>(std::ceil(this->clampedDeltaTime / Physics::DeltaTime));
 		}
@@ -459,6 +469,15 @@ bool Game::init()
 		}
 	}, globalUiContextName, this->inputManager);
 
+	this->uiManager.addInputActionListener(InputActionName::DebugProfilerSave,
+		[this](const InputActionCallbackValues &values)
+	{
+		if (values.performed)
+		{
+			this->saveProfilerHistory();
+		}
+	}, globalUiContextName, this->inputManager);
+
 	// Initialize window icon.
 	const std::string windowIconPath = dataFolderPath + "icon.bmp";
 	const Surface windowIconSurface = Surface::loadBMP(windowIconPath.c_str(), RendererUtils::DEFAULT_PIXELFORMAT);
@@ -671,6 +690,54 @@ void Game::saveScreenshot(const Surface &surface)
 	}
 }
 
+void Game::saveProfilerHistory()
+{
+	if (this->profilerHistory.empty())
+	{
+		DebugLogWarning("No render stage times to save, the profiler needs to be visible while playing.");
+		return;
+	}
+
+	const std::string csvPath = Platform::getLogPath() + "profiler.csv";
+	std::ofstream csvStream(csvPath, std::ios::trunc);
+	if (!csvStream.is_open())
+	{
+		DebugLogError("Couldn't open \"" + csvPath + "\" for writing render stage times.");
+		return;
+	}
+
+	csvStream << "frame,thread,cpu,render_ms,present_ms,reused";
+	for (const char *stageName : RENDERER_PROFILER_STAGE_NAMES)
+	{
+		csvStream << ',' << stageName << "_ms";
+	}
+
+	csvStream << ",idle_ms\n";
+
+	for (int frameIndex = 0; frameIndex < static_cast<int>(this->profilerHistory.size()); frameIndex++)
+	{
+		const RendererProfilerData &profilerData = this->profilerHistory[frameIndex];
+		const int threadCount = static_cast<int>(profilerData.workerStageTimes.size()) / RENDERER_PROFILER_STAGE_COUNT;
+		for (int threadIndex = 0; threadIndex < threadCount; threadIndex++)
+		{
+			const int cpuID = (threadIndex < static_cast<int>(profilerData.workerCpuIDs.size())) ? profilerData.workerCpuIDs[threadIndex] : -1;
+			csvStream << frameIndex << ',' << threadIndex << ',' << cpuID << ',' << (profilerData.renderTime * 1000.0) << ',' << (profilerData.presentTime * 1000.0) << ',' <<
+				profilerData.reusedFrameCount;
+
+			for (int stageIndex = 0; stageIndex < RENDERER_PROFILER_STAGE_COUNT; stageIndex++)
+			{
+				const double stageTime = profilerData.workerStageTimes[(threadIndex * RENDERER_PROFILER_STAGE_COUNT) + stageIndex];
+				csvStream << ',' << (stageTime * 1000.0);
+			}
+
+			const double idleTime = (threadIndex < static_cast<int>(profilerData.workerIdleTimes.size())) ? profilerData.workerIdleTimes[threadIndex] : 0.0;
+			csvStream << ',' << (idleTime * 1000.0) << '\n';
+		}
+	}
+
+	DebugLog("Saved " + std::to_string(this->profilerHistory.size()) + " frames of render stage times to \"" + csvPath + "\".");
+}
+
 void Game::handleContextChanges()
 {
 	if (!this->nextContextName.empty())
@@ -735,29 +802,98 @@ void Game::updateDebugInfoText()
 		const bool profilerDataIsValid = (renderDims.x > 0) && (renderDims.y > 0);
 		if (profilerDataIsValid)
 		{
-			const double resolutionScale = this->options.getGraphics_ResolutionScale();
+			const double resolutionScale = this->renderer.getResolutionScale();
 			const std::string renderWidth = std::to_string(renderDims.x);
 			const std::string renderHeight = std::to_string(renderDims.y);
-			const std::string renderResScale = String::fixedPrecision(resolutionScale * 100.0, 0) + "%";
+			std::string renderResScale = String::fixedPrecision(resolutionScale * 100.0, 0) + "%";
+			if (this->options.getGraphics_DynamicResolution())
+			{
+				renderResScale += " dynamic";
+			}
 			const std::string renderThreadCount = std::to_string(profilerData.threadCount);
 			const std::string renderTime = String::fixedPrecision(profilerData.renderTime * 1000.0, 2);
+			const std::string renderReusedText = (profilerData.reusedFrameCount > 0) ? (" (reused x" + std::to_string(profilerData.reusedFrameCount) + ")") : std::string();
 			const std::string renderDrawCallCount = std::to_string(profilerData.drawCallCount);
+			const std::string renderSortedDrawCallCount = std::to_string(profilerData.sortedDrawCallCount);
 			const std::string renderCoverageTestRatio = String::fixedPrecision(static_cast<double>(profilerData.totalCoverageTests) / static_cast<double>(profilerData.pixelCount), 2);
+			const std::string renderCoverageBlockAcceptPercent = String::fixedPrecision((static_cast<double>(profilerData.totalCoverageBlockAccepts) /
+				static_cast<double>(std::max<int64_t>(profilerData.totalCoverageBlockAccepts + profilerData.totalCoverageTests, 1))) * 100.0, 0);
 			const std::string renderDepthTestRatio = String::fixedPrecision(static_cast<double>(profilerData.totalDepthTests) / static_cast<double>(profilerData.pixelCount), 2);
 			const std::string renderColorOverdrawRatio = String::fixedPrecision(static_cast<double>(profilerData.totalColorWrites) / static_cast<double>(profilerData.pixelCount), 2);
+			const std::string renderShadedFragmentRatio = String::fixedPrecision(static_cast<double>(profilerData.totalShadedFragments) / static_cast<double>(profilerData.pixelCount), 2);
+			const std::string renderMipmappedFragmentPercent = String::fixedPrecision((static_cast<double>(profilerData.totalMipmappedFragments) /
+				static_cast<double>(std::max<int64_t>(profilerData.totalShadedFragments, 1))) * 100.0, 0);
+			const std::string renderLightsPerFragment = String::fixedPrecision(static_cast<double>(profilerData.totalFragmentLightTests) /
+				static_cast<double>(std::max<int64_t>(profilerData.totalLitFragments, 1)), 2);
 			const std::string objectTextureMbCount = String::fixedPrecision(static_cast<double>(profilerData.objectTextureByteCount) / (1024.0 * 1024.0), 2);
+			const std::string objectTextureMipMbCount = String::fixedPrecision(static_cast<double>(profilerData.objectTextureMipByteCount) / (1024.0 * 1024.0), 2);
 			const std::string uiTextureMbCount = String::fixedPrecision(static_cast<double>(profilerData.uiTextureByteCount) / (1024.0 * 1024.0), 2);
+			std::string workerBusyText = "n/a";
+			if (!profilerData.workerBusyTimes.empty())
+			{
+				// Average over slowest busy time, 100% means every thread was busy for the same amount of time.
+				const auto busyTimesMinMax = std::minmax_element(profilerData.workerBusyTimes.begin(), profilerData.workerBusyTimes.end());
+				const double busyTimesTotal = std::accumulate(profilerData.workerBusyTimes.begin(), profilerData.workerBusyTimes.end(), 0.0);
+				const double busyTimesAverage = busyTimesTotal / static_cast<double>(profilerData.workerBusyTimes.size());
+				const double busyTimesBalance = (*busyTimesMinMax.second > 0.0) ? (busyTimesAverage / *busyTimesMinMax.second) : 1.0;
+				workerBusyText = String::fixedPrecision(*busyTimesMinMax.first * 1000.0, 2) + "-" + String::fixedPrecision(*busyTimesMinMax.second * 1000.0, 2) +
+					"ms (" + String::fixedPrecision(busyTimesBalance * 100.0, 0) + "% balance)";
+			}
+
+			std::string workerStageText = "n/a";
+			if (!profilerData.workerStageTimes.empty())
+			{
+				// Slowest thread per stage since that's the one the frame waits on.
+				workerStageText.clear();
+				const int stageThreadCount = static_cast<int>(profilerData.workerStageTimes.size()) / RENDERER_PROFILER_STAGE_COUNT;
+				for (int stageIndex = 0; stageIndex < RENDERER_PROFILER_STAGE_COUNT; stageIndex++)
+				{
+					double maxStageTime = 0.0;
+					for (int threadIndex = 0; threadIndex < stageThreadCount; threadIndex++)
+					{
+						maxStageTime = std::max(maxStageTime, profilerData.workerStageTimes[(threadIndex * RENDERER_PROFILER_STAGE_COUNT) + stageIndex]);
+					}
+
+					if (stageIndex > 0)
+					{
+						workerStageText += ", ";
+					}
+
+					workerStageText += std::string(RENDERER_PROFILER_STAGE_NAMES[stageIndex]) + " " + String::fixedPrecision(maxStageTime * 1000.0, 2);
+				}
+
+				workerStageText += "ms";
+			}
+
+			const std::string presentTime = String::fixedPrecision(profilerData.presentTime * 1000.0, 2);
+			const std::string binArenaMbCount = String::fixedPrecision(static_cast<double>(profilerData.binArenaPeakByteCount) / (1024.0 * 1024.0), 2);
+			const std::string binLayoutText = std::to_string(profilerData.binWidth) + "x" + std::to_string(profilerData.binHeight) + " (" + std::to_string(profilerData.binCount) + ")";
+			const std::string binTriangleAverage = String::fixedPrecision(static_cast<double>(profilerData.binnedTriangleCount) / static_cast<double>(std::max(profilerData.binCount, 1)), 1);
 			debugText.append("\nScene: " + renderWidth + "x" + renderHeight + " (" + renderResScale + ")" + '\n' +
-				"Render: " + renderTime + "ms, " + renderThreadCount + " thread" + ((profilerData.threadCount > 1) ? "s" : "") + '\n' +
-				"Object textures: " + std::to_string(profilerData.objectTextureCount) + " (" + objectTextureMbCount + "MB)" + '\n' +
+				"Render: " + renderTime + "ms" + renderReusedText + ", " + renderThreadCount + " thread" + ((profilerData.threadCount > 1) ? "s" : "") + '\n' +
+				"Thread busy: " + workerBusyText + '\n' +
+				"Thread stages: " + workerStageText + '\n' +
+				"Present: " + presentTime + "ms" + '\n' +
+				"Object textures: " + std::to_string(profilerData.objectTextureCount) + " (" + objectTextureMbCount + "MB, +" + objectTextureMipMbCount + "MB mips)" + '\n' +
 				"UI textures: " + std::to_string(profilerData.uiTextureCount) + " (" + uiTextureMbCount + "MB)" + '\n' +
 				"Materials: " + std::to_string(profilerData.materialCount) + '\n' +
-				"Draw calls: " + renderDrawCallCount + '\n' +
+				"Draw calls: " + renderDrawCallCount + " (" + renderSortedDrawCallCount + " sorted)" + '\n' +
 				"Rendered Tris: " + std::to_string(profilerData.presentedTriangleCount) + '\n' +
-				"Lights: " + std::to_string(profilerData.totalLightCount) + '\n' +
-				"Coverage tests: " + renderCoverageTestRatio + "x" + '\n' +
+				"Bins: " + binLayoutText + ", " + binTriangleAverage + " tris avg, " + std::to_string(profilerData.maxBinTriangleCount) + " max" + '\n' +
+				"Bin memory: " + binArenaMbCount + "MB" + '\n' +
+				"Lights: " + std::to_string(profilerData.totalLightCount) + " (" + renderLightsPerFragment + " per lit fragment)" + '\n' +
+				"Coverage tests: " + renderCoverageTestRatio + "x (" + renderCoverageBlockAcceptPercent + "% block accepted)" + '\n' +
 				"Depth tests: " + renderDepthTestRatio + "x" + '\n' +
-				"Overdraw: " + renderColorOverdrawRatio + "x");
+				"Overdraw: " + renderColorOverdrawRatio + "x" + '\n' +
+				"Shaded fragments: " + renderShadedFragmentRatio + "x (" + renderMipmappedFragmentPercent + "% mipmapped)");
+
+			if (profilerData.rasterPrecisionDiffPercent >= 0.0)
+			{
+				const std::string rasterPrecisionDiffText = String::fixedPrecision(profilerData.rasterPrecisionDiffPercent, 2);
+				const std::string rasterPrecisionPsnrText = std::isfinite(profilerData.rasterPrecisionPsnr) ?
+					(String::fixedPrecision(profilerData.rasterPrecisionPsnr, 1) + "dB") : "exact";
+				debugText.append("\nSingle precision: " + rasterPrecisionDiffText + "% pixels differ (" + rasterPrecisionPsnrText + ")");
+			}
 		}
 		else
 		{
@@ -843,10 +979,14 @@ void Game::loop()
 	// Primary game loop.
 	while (this->running)
 	{
-		frameTimer.startFrame(this->options.getGraphics_TargetFPS());
+		const int targetFPS = this->options.getGraphics_TargetFPS();
+		frameTimer.startFrame(targetFPS);
 		const double deltaTime = frameTimer.deltaTime;
 		const double clampedDeltaTime = frameTimer.clampedDeltaTime;
 
+		this->renderer.updateDynamicResolution(frameTimer.workTime, targetFPS, this->options.getGraphics_DynamicResolution(),
+			this->options.getGraphics_DynamicResolutionMinScale());
+
 		Profiler::startFrame();
 
 		this->fpsCounter.updateFrameTime(deltaTime);
@@ -1060,8 +1200,27 @@ void Game::loop()
 
 				const ObjectTextureID skyBgTextureID = renderSkyManager.getBgTextureID();
 
+				// Only pay for reference frames when the renderer details are visible.
+				const RasterPrecisionMode rasterPrecisionMode = static_cast<RasterPrecisionMode>(this->options.getGraphics_RasterPrecisionMode());
+				const ShadingMode shadingMode = static_cast<ShadingMode>(this->options.getGraphics_ShadingMode());
+				const bool enableRasterPrecisionComparison = this->options.getMisc_ProfilerLevel() >= 2;
+				const bool enableStageTimers = this->options.getMisc_ProfilerLevel() > Options::MIN_PROFILER_LEVEL;
+
 				frameSettings.init(Colors::Black, ambientPercent, visibleLightsBufferID, visibleLightCount, screenSpaceAnimPercent, paletteTextureID,
 					lightTableTextureID, ditherTextureID, skyBgTextureID, this->options.getGraphics_RenderThreadsMode(), ditheringMode);
+				frameSettings.renderThreadsSpinMicroseconds = this->options.getGraphics_RenderThreadsSpinMicroseconds();
+				frameSettings.enableRenderThreadsAffinity = this->options.getGraphics_RenderThreadsAffinity();
+				frameSettings.renderQueuedFrames = this->options.getGraphics_RenderQueuedFrames();
+				frameSettings.enableDrawCallSorting = this->options.getGraphics_RenderSortDrawCalls();
+				frameSettings.enableAdaptiveBinSizing = this->options.getGraphics_RenderAdaptiveBins();
+				frameSettings.enableInterlacing = this->options.getGraphics_RenderInterlacing();
+				frameSettings.enableMipmaps = this->options.getGraphics_RenderMipmaps();
+				frameSettings.enableTiledTexels = this->options.getGraphics_RenderTiledTextures();
+				frameSettings.enableStaticFrameReuse = this->options.getGraphics_RenderReuseStaticFrames();
+				frameSettings.rasterPrecisionMode = rasterPrecisionMode;
+				frameSettings.shadingMode = shadingMode;
+				frameSettings.enableRasterPrecisionComparison = enableRasterPrecisionComparison;
+				frameSettings.enableStageTimers = enableStageTimers;
 			}
 
 			this->uiManager.populateCommandList(uiDrawCommandList);
@@ -1081,6 +1240,20 @@ void Game::loop()
 			}
 
 			this->renderer.submitFrame(renderDrawCommandList, uiDrawCommandList, renderCamera, frameSettings);
+
+			if (isDebugProfilerVisible)
+			{
+				const RendererProfilerData &profilerData = this->renderer.getProfilerData();
+				if (!profilerData.workerStageTimes.empty())
+				{
+					if (static_cast<int>(this->profilerHistory.size()) >= PROFILER_HISTORY_FRAME_COUNT)
+					{
+						this->profilerHistory.pop_front();
+					}
+
+					this->profilerHistory.emplace_back(profilerData);
+				}
+			}
 		}
 		catch (const std::exception &e)
 		{
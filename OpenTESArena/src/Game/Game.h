@@ -1,5 +1,6 @@
 #pragma once
 
+#include <deque>
 #include <memory>
 #include <optional>
 #include <string>
@@ -62,6 +63,7 @@ public:
 	// Debug text displayed with varying profiler levels.
 	UiElementInstanceID debugTextBoxElementInstID;
 	DebugVoxelVisibilityQuadtreeState debugQuadtreeState;
+	std::deque<RendererProfilerData> profilerHistory; // Recent frames with render stage times, oldest first.
 
 	// Active game session (needs to be positioned after Renderer member due to order of texture destruction).
 	GameState gameState;
@@ -87,6 +89,9 @@ private:
 	// available index.
 	void saveScreenshot(const Surface &surface);
 
+	// Saves the recent render stage times as a CSV file in the log folder, one row per render thread per frame.
+	void saveProfilerHistory();
+
 	// Handles any change in the active UI context after an input event or game tick.
 	void handleContextChanges();
 
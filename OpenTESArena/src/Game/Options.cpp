@@ -23,13 +23,26 @@ namespace
 		{ Options::Key_Graphics_GraphicsAPI, Options::OptionType_Graphics_GraphicsAPI },
 		{ Options::Key_Graphics_TargetFPS, Options::OptionType_Graphics_TargetFPS },
 		{ Options::Key_Graphics_ResolutionScale, Options::OptionType_Graphics_ResolutionScale },
+		{ Options::Key_Graphics_DynamicResolution, Options::OptionType_Graphics_DynamicResolution },
+		{ Options::Key_Graphics_DynamicResolutionMinScale, Options::OptionType_Graphics_DynamicResolutionMinScale },
 		{ Options::Key_Graphics_VerticalFOV, Options::OptionType_Graphics_VerticalFOV },
 		{ Options::Key_Graphics_LetterboxMode, Options::OptionType_Graphics_LetterboxMode },
 		{ Options::Key_Graphics_CursorScale, Options::OptionType_Graphics_CursorScale },
 		{ Options::Key_Graphics_ModernInterface, Options::OptionType_Graphics_ModernInterface },
 		{ Options::Key_Graphics_TallPixelCorrection, Options::OptionType_Graphics_TallPixelCorrection },
 		{ Options::Key_Graphics_RenderThreadsMode, Options::OptionType_Graphics_RenderThreadsMode },
-		{ Options::Key_Graphics_DitheringMode, Options::OptionType_Graphics_DitheringMode }
+		{ Options::Key_Graphics_RenderThreadsSpinMicroseconds, Options::OptionType_Graphics_RenderThreadsSpinMicroseconds },
+		{ Options::Key_Graphics_RenderThreadsAffinity, Options::OptionType_Graphics_RenderThreadsAffinity },
+		{ Options::Key_Graphics_RenderQueuedFrames, Options::OptionType_Graphics_RenderQueuedFrames },
+		{ Options::Key_Graphics_RenderSortDrawCalls, Options::OptionType_Graphics_RenderSortDrawCalls },
+		{ Options::Key_Graphics_RenderAdaptiveBins, Options::OptionType_Graphics_RenderAdaptiveBins },
+		{ Options::Key_Graphics_RenderInterlacing, Options::OptionType_Graphics_RenderInterlacing },
+		{ Options::Key_Graphics_RenderMipmaps, Options::OptionType_Graphics_RenderMipmaps },
+		{ Options::Key_Graphics_RenderTiledTextures, Options::OptionType_Graphics_RenderTiledTextures },
+		{ Options::Key_Graphics_RenderReuseStaticFrames, Options::OptionType_Graphics_RenderReuseStaticFrames },
+		{ Options::Key_Graphics_DitheringMode, Options::OptionType_Graphics_DitheringMode },
+		{ Options::Key_Graphics_RasterPrecisionMode, Options::OptionType_Graphics_RasterPrecisionMode },
+		{ Options::Key_Graphics_ShadingMode, Options::OptionType_Graphics_ShadingMode }
 	};
 
 	constexpr std::pair<const char*, OptionType> AudioMappings[] =
@@ -76,8 +76,16 @@ public:
 	static constexpr int MAX_GRAPHICS_API = 1;
 	static constexpr int MIN_RENDER_THREADS_MODE = 0;
 	static constexpr int MAX_RENDER_THREADS_MODE = 5;
+	static constexpr int MIN_RENDER_THREADS_SPIN_MICROSECONDS = 0;
+	static constexpr int MAX_RENDER_THREADS_SPIN_MICROSECONDS = 10000;
+	static constexpr int MIN_RENDER_QUEUED_FRAMES = 0;
+	static constexpr int MAX_RENDER_QUEUED_FRAMES = 1;
 	static constexpr int MIN_DITHERING_MODE = 0;
 	static constexpr int MAX_DITHERING_MODE = 2;
+	static constexpr int MIN_RASTER_PRECISION_MODE = 0;
+	static constexpr int MAX_RASTER_PRECISION_MODE = 1;
+	static constexpr int MIN_SHADING_MODE = 0;
+	static constexpr int MAX_SHADING_MODE = 1;
 	static constexpr double MIN_HORIZONTAL_SENSITIVITY = 0.50;
 	static constexpr double MAX_HORIZONTAL_SENSITIVITY = 12.0;
 	static constexpr double MIN_VERTICAL_SENSITIVITY = 0.50;
@@ -164,13 +172,26 @@ void set##section##_##name(const std::string &value) \
 	OPTION_INT(Graphics, GraphicsAPI, MIN_GRAPHICS_API, MAX_GRAPHICS_API)
 	OPTION_INT(Graphics, TargetFPS, MIN_FPS, MAX_FPS)
 	OPTION_DOUBLE(Graphics, ResolutionScale, MIN_RESOLUTION_SCALE, MAX_RESOLUTION_SCALE)
+	OPTION_BOOL(Graphics, DynamicResolution)
+	OPTION_DOUBLE(Graphics, DynamicResolutionMinScale, MIN_RESOLUTION_SCALE, MAX_RESOLUTION_SCALE)
 	OPTION_DOUBLE(Graphics, VerticalFOV, MIN_VERTICAL_FOV, MAX_VERTICAL_FOV)
 	OPTION_INT(Graphics, LetterboxMode, MIN_LETTERBOX_MODE, MAX_LETTERBOX_MODE)
 	OPTION_DOUBLE(Graphics, CursorScale, MIN_CURSOR_SCALE, MAX_CURSOR_SCALE)
 	OPTION_BOOL(Graphics, ModernInterface)
 	OPTION_BOOL(Graphics, TallPixelCorrection)
 	OPTION_INT(Graphics, RenderThreadsMode, MIN_RENDER_THREADS_MODE, MAX_RENDER_THREADS_MODE)
+	OPTION_INT(Graphics, RenderThreadsSpinMicroseconds, MIN_RENDER_THREADS_SPIN_MICROSECONDS, MAX_RENDER_THREADS_SPIN_MICROSECONDS)
+	OPTION_BOOL(Graphics, RenderThreadsAffinity)
+	OPTION_INT(Graphics, RenderQueuedFrames, MIN_RENDER_QUEUED_FRAMES, MAX_RENDER_QUEUED_FRAMES)
+	OPTION_BOOL(Graphics, RenderSortDrawCalls)
+	OPTION_BOOL(Graphics, RenderAdaptiveBins)
+	OPTION_BOOL(Graphics, RenderInterlacing)
+	OPTION_BOOL(Graphics, RenderMipmaps)
+	OPTION_BOOL(Graphics, RenderTiledTextures)
+	OPTION_BOOL(Graphics, RenderReuseStaticFrames)
 	OPTION_INT(Graphics, DitheringMode, MIN_DITHERING_MODE, MAX_DITHERING_MODE)
+	OPTION_INT(Graphics, RasterPrecisionMode, MIN_RASTER_PRECISION_MODE, MAX_RASTER_PRECISION_MODE)
+	OPTION_INT(Graphics, ShadingMode, MIN_SHADING_MODE, MAX_SHADING_MODE)
 
 	OPTION_DOUBLE(Audio, MusicVolume, MIN_VOLUME, MAX_VOLUME)
 	OPTION_DOUBLE(Audio, SoundVolume, MIN_VOLUME, MAX_VOLUME)
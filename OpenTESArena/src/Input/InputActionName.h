@@ -92,4 +92,5 @@ namespace InputActionName
 
 	// Debug.
 	constexpr const char *DebugProfiler = "DebugProfiler";
+	constexpr const char *DebugProfilerSave = "DebugProfilerSave";
 }
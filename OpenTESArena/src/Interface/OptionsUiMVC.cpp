@@ -377,6 +377,34 @@ OptionsUiModel::OptionGroup OptionsUiModel::makeGraphicsOptionGroup(Game &game)
 		options.setGraphics_DitheringMode(value);
 	});
 
+	auto rasterPrecisionOption = std::make_unique<OptionsUiModel::IntOption>(
+		OptionsUiModel::RASTER_PRECISION_NAME,
+		"Selects the floating-point precision of the software renderer's\ntriangle setup and depth buffer. Single is faster but may have\nsmall differences along triangle edges.\n\nDouble\nSingle",
+		options.getGraphics_RasterPrecisionMode(),
+		1,
+		Options::MIN_RASTER_PRECISION_MODE,
+		Options::MAX_RASTER_PRECISION_MODE,
+		std::vector<std::string> { "Double", "Single" },
+		[&game](int value)
+	{
+		auto &options = game.options;
+		options.setGraphics_RasterPrecisionMode(value);
+	});
+
+	auto shadingModeOption = std::make_unique<OptionsUiModel::IntOption>(
+		OptionsUiModel::SHADING_MODE_NAME,
+		"Selects how the software renderer shades opaque geometry.\nVisibility Buffer finds each pixel's closest surface first and only\nshades that one, which helps when a lot of geometry overlaps.\n\nForward\nVisibility Buffer",
+		options.getGraphics_ShadingMode(),
+		1,
+		Options::MIN_SHADING_MODE,
+		Options::MAX_SHADING_MODE,
+		std::vector<std::string> { "Forward", "Visibility Buffer" },
+		[&game](int value)
+	{
+		auto &options = game.options;
+		options.setGraphics_ShadingMode(value);
+	});
+
 	OptionGroup group;
 	group.emplace_back(std::move(windowModeOption));
 	group.emplace_back(std::move(graphicsApiOption));
@@ -389,6 +417,8 @@ OptionsUiModel::OptionGroup OptionsUiModel::makeGraphicsOptionGroup(Game &game)
 	group.emplace_back(std::move(tallPixelCorrectionOption));
 	group.emplace_back(std::move(renderThreadsModeOption));
 	group.emplace_back(std::move(ditheringOption));
+	group.emplace_back(std::move(rasterPrecisionOption));
+	group.emplace_back(std::move(shadingModeOption));
 	return group;
 }
 
@@ -38,6 +38,8 @@ namespace OptionsUiModel
 	const std::string TALL_PIXEL_CORRECTION_NAME = "Tall Pixel Correction";
 	const std::string VERTICAL_FOV_NAME = "Vertical FOV";
 	const std::string DITHERING_NAME = "Dithering";
+	const std::string RASTER_PRECISION_NAME = "Raster Precision";
+	const std::string SHADING_MODE_NAME = "Shading Mode";
 
 	// Audio.
 	const std::string SOUND_CHANNELS_NAME = "Sound Channels";
@@ -5,6 +5,7 @@ RendererProfilerData2D::RendererProfilerData2D()
 	this->drawCallCount = 0;
 	this->uiTextureCount = 0;
 	this->uiTextureByteCount = 0;
+	this->presentTime = 0.0;
 }
 
 RendererProfilerData3D::RendererProfilerData3D()
@@ -13,12 +14,28 @@ RendererProfilerData3D::RendererProfilerData3D()
 	this->height = 0;
 	this->threadCount = 0;
 	this->drawCallCount = 0;
+	this->sortedDrawCallCount = 0;
+	this->reusedFrameCount = 0;
 	this->presentedTriangleCount = 0;
 	this->objectTextureCount = 0;
 	this->objectTextureByteCount = 0;
+	this->objectTextureMipByteCount = 0;
 	this->materialCount = 0;
 	this->totalLightCount = 0;
 	this->totalCoverageTests = 0;
+	this->totalCoverageBlockAccepts = 0;
 	this->totalDepthTests = 0;
 	this->totalColorWrites = 0;
+	this->totalShadedFragments = 0;
+	this->totalMipmappedFragments = 0;
+	this->totalLitFragments = 0;
+	this->totalFragmentLightTests = 0;
+	this->binArenaPeakByteCount = 0;
+	this->binWidth = 0;
+	this->binHeight = 0;
+	this->binCount = 0;
+	this->binnedTriangleCount = 0;
+	this->maxBinTriangleCount = 0;
+	this->rasterPrecisionDiffPercent = -1.0;
+	this->rasterPrecisionPsnr = 0.0;
 }
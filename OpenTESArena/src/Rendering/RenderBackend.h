@@ -2,7 +2,9 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <optional>
+#include <vector>
 
 #include "RenderMaterialUtils.h"
 #include "RenderMeshUtils.h"
@@ -22,12 +24,39 @@ struct RenderFrameSettings;
 struct RenderInitSettings;
 struct UiDrawCommandList;
 
+// Parts of a software renderer frame timed on each render thread when stage timers are on.
+enum class RendererProfilerStage
+{
+	VertexShading, // Mesh lookups, vertex transforms, and vertex shaders.
+	Clipping,
+	Binning, // Back-face culling and sorting triangles into rasterizer bins.
+	Clearing, // Depth buffer rows.
+	LightBins,
+	Rasterizing // Also visibility buffer resolves and interlaced row reprojection.
+};
+
+constexpr int RENDERER_PROFILER_STAGE_COUNT = 6;
+
+// Short names for the debug overlay and CSV columns, in RendererProfilerStage order.
+constexpr const char *RENDERER_PROFILER_STAGE_NAMES[] =
+{
+	"vertex",
+	"clip",
+	"bin",
+	"clear",
+	"lights",
+	"raster"
+};
+
+static_assert(std::size(RENDERER_PROFILER_STAGE_NAMES) == RENDERER_PROFILER_STAGE_COUNT);
+
 // Profiling info gathered from internal renderer state.
 struct RendererProfilerData2D
 {
 	int drawCallCount;
 	int uiTextureCount;
 	int64_t uiTextureByteCount;
+	double presentTime; // Seconds copying the scene and UI to the window and presenting it, 0 if not measured.
 
 	RendererProfilerData2D();
 };
@@ -37,14 +66,32 @@ struct RendererProfilerData3D
 	int width, height;
 	int threadCount;
 	int drawCallCount;
+	int sortedDrawCallCount; // Reordered front-to-back.
+	int reusedFrameCount; // Consecutive frames that presented the last rendered frame again because nothing changed.
 	int presentedTriangleCount;
 	int objectTextureCount;
 	int64_t objectTextureByteCount;
+	int64_t objectTextureMipByteCount; // Downsampled levels on top of objectTextureByteCount.
 	int materialCount;
 	int totalLightCount;
-	int64_t totalCoverageTests;
+	int64_t totalCoverageTests; // Per-pixel edge function tests.
+	int64_t totalCoverageBlockAccepts; // Pixels in 8x8 blocks completely inside a triangle, no per-pixel edge tests.
 	int64_t totalDepthTests;
 	int64_t totalColorWrites;
+	int64_t totalShadedFragments; // Fragments that were textured and lit, whether or not they were written.
+	int64_t totalMipmappedFragments; // Shaded fragments whose texture was sampled from a mip level below the full size.
+	int64_t totalLitFragments; // Shaded fragments with per-pixel lighting.
+	int64_t totalFragmentLightTests; // Lights visited by those fragments after light bin depth slicing.
+	int64_t binArenaPeakByteCount; // Sum of each worker's rasterizer bin memory high-water mark this frame.
+	int binWidth, binHeight; // Rasterizer bin layout this frame.
+	int binCount;
+	int64_t binnedTriangleCount; // Triangles summed over all bins, one triangle counts once per bin it touches.
+	int maxBinTriangleCount; // Triangles in the most expensive bin.
+	std::vector<double> workerBusyTimes, workerIdleTimes; // Seconds per render thread this frame.
+	std::vector<double> workerStageTimes; // RENDERER_PROFILER_STAGE_COUNT seconds per render thread this frame, empty if stage timers are off.
+	std::vector<int> workerCpuIDs; // Logical CPU each render thread is pinned to, -1 if it isn't.
+	double rasterPrecisionDiffPercent; // Pixels differing from the last double-precision reference frame, negative if not measured.
+	double rasterPrecisionPsnr; // Peak signal-to-noise ratio of the same comparison, infinite if identical.
 
 	RendererProfilerData3D();
 };
@@ -62,6 +109,9 @@ public:
 	virtual void resize(int windowWidth, int windowHeight, int sceneViewWidth, int sceneViewHeight, int internalWidth, int internalHeight) = 0;
 	virtual void handleRenderTargetsReset(int windowWidth, int windowHeight, int sceneViewWidth, int sceneViewHeight, int internalWidth, int internalHeight) = 0;
 
+	// Changes only the game world render resolution, window-sized render targets stay as they are.
+	virtual void resizeInternal(int internalWidth, int internalHeight) = 0;
+
 	// Gets various profiler information about internal renderer state.
 	virtual RendererProfilerData2D getProfilerData2D() const = 0;
 	virtual RendererProfilerData3D getProfilerData3D() const = 0;
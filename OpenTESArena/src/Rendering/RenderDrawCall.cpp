@@ -9,6 +9,7 @@ void RenderDrawCall::clear()
 {
 	this->transformBufferID = -1;
 	this->transformIndex = -1;
+	this->instanceCount = 1;
 	this->positionBufferID = -1;
 	this->normalBufferID = -1;
 	this->texCoordBufferID = -1;
@@ -9,6 +9,7 @@ struct RenderDrawCall
 {
 	UniformBufferID transformBufferID; // Translation/rotation/scale of this model.
 	int transformIndex;
+	int instanceCount; // Draws the mesh once per transform in [transformIndex, transformIndex + instanceCount).
 
 	VertexPositionBufferID positionBufferID;
 	VertexAttributeBufferID normalBufferID, texCoordBufferID;
@@ -19,6 +19,20 @@ int RenderDrawCommandList::getTotalDrawCallCount() const
 	return count;
 }
 
+int RenderDrawCommandList::getTotalInstanceCount() const
+{
+	int count = 0;
+	for (int i = 0; i < this->entryCount; i++)
+	{
+		for (const RenderDrawCall &drawCall : this->entries[i])
+		{
+			count += drawCall.instanceCount;
+		}
+	}
+
+	return count;
+}
+
 void RenderDrawCommandList::addDrawCalls(Span<const RenderDrawCall> drawCalls)
 {
 	if (drawCalls.getCount() == 0)
@@ -17,6 +17,7 @@ struct RenderDrawCommandList
 	RenderDrawCommandList();
 
 	int getTotalDrawCallCount() const;
+	int getTotalInstanceCount() const; // Sum of each draw call's instance count.
 
 	void addDrawCalls(Span<const RenderDrawCall> drawCalls);
 };
@@ -12,7 +12,20 @@ RenderFrameSettings::RenderFrameSettings()
 	this->ditherTextureID = -1;
 	this->skyBgTextureID = -1;
 	this->renderThreadsMode = -1;
+	this->renderThreadsSpinMicroseconds = 0;
+	this->enableRenderThreadsAffinity = false;
+	this->renderQueuedFrames = 0;
+	this->enableDrawCallSorting = false;
+	this->enableAdaptiveBinSizing = false;
+	this->enableInterlacing = false;
+	this->enableMipmaps = false;
+	this->enableTiledTexels = false;
+	this->enableStaticFrameReuse = false;
 	this->ditheringMode = static_cast<DitheringMode>(-1);
+	this->rasterPrecisionMode = static_cast<RasterPrecisionMode>(-1);
+	this->shadingMode = static_cast<ShadingMode>(-1);
+	this->enableRasterPrecisionComparison = false;
+	this->enableStageTimers = false;
 }
 
 void RenderFrameSettings::init(Color clearColor, double ambientPercent, UniformBufferID visibleLightsBufferID, int visibleLightCount,
@@ -19,10 +19,24 @@ struct RenderFrameSettings
 	double screenSpaceAnimPercent;
 	ObjectTextureID paletteTextureID, lightTableTextureID, ditherTextureID, skyBgTextureID;
 	int renderThreadsMode;
+	int renderThreadsSpinMicroseconds; // Busy-wait budget for render threads before they sleep between frame stages.
+	bool enableRenderThreadsAffinity; // Render threads are pinned to separate physical cores where the OS allows it.
+	int renderQueuedFrames; // Frames the renderer may still be drawing when submitFrame() returns, 0 is fully synchronous.
+	bool enableDrawCallSorting; // Front-to-back ordering of draw calls that don't depend on draw order.
+	bool enableAdaptiveBinSizing; // Rasterizer bin dimensions follow the previous frame's triangle density.
+	bool enableInterlacing; // Shades every other row each frame and reprojects the rest from the previous frame.
+	bool enableMipmaps; // Object textures are sampled from a downsampled level picked per triangle.
+	bool enableTiledTexels; // Object textures are sampled from a copy stored in square tiles instead of rows.
+	bool enableStaticFrameReuse; // The last frame is presented again instead of rendered if nothing it was drawn from changed.
 	DitheringMode ditheringMode;
+	RasterPrecisionMode rasterPrecisionMode;
+	ShadingMode shadingMode;
+	bool enableRasterPrecisionComparison; // Occasionally renders a double-precision reference frame to measure single-precision error.
+	bool enableStageTimers; // Render threads time each stage of the frame for the profiler.
 
 	RenderFrameSettings();
 
+	// Renderer options (thread tuning, sorting, precision, etc.) keep their defaults unless assigned afterwards.
 	void init(Color clearColor, double ambientPercent, UniformBufferID visibleLightsBufferID, int visibleLightCount, 
 		double screenSpaceAnimPercent, ObjectTextureID paletteTextureID, ObjectTextureID lightTableTextureID,
 		ObjectTextureID ditherTextureID, ObjectTextureID skyBgTextureID, int renderThreadsMode, DitheringMode ditheringMode);
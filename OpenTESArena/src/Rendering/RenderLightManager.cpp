@@ -5,6 +5,7 @@
 #include "Renderer.h"
 #include "RendererUtils.h"
 #include "RenderLightManager.h"
+#include "../Voxels/VoxelUtils.h"
 
 #include "components/utilities/Span.h"
 
@@ -15,6 +16,11 @@ namespace
 		const double entityCenterYPosition = entityPos.y + entityBBox.halfHeight;
 		return WorldDouble3(entityPos.x, entityCenterYPosition, entityPos.z);
 	}
+
+	bool IsSameRenderLight(const RenderLight &a, const RenderLight &b)
+	{
+		return (a.position == b.position) && (a.startRadius == b.startRadius) && (a.endRadius == b.endRadius);
+	}
 }
 
 RenderLight::RenderLight()
@@ -25,12 +31,18 @@ RenderLight::RenderLight()
 
 RenderLightEntry::RenderLightEntry()
 {
-	this->enabled = false;
+	this->isStreetlight = false;
+}
+
+RenderLightChunk::RenderLightChunk()
+{
+	this->isBBoxDirty = false;
 }
 
 RenderLightManager::RenderLightManager()
 {
 	this->visibleLightsBufferID = -1;
+	this->visibleLightCount = 0;
 }
 
 bool RenderLightManager::init(Renderer &renderer)
@@ -52,6 +64,8 @@ void RenderLightManager::shutdown(Renderer &renderer)
 		renderer.freeUniformBuffer(this->visibleLightsBufferID);
 		this->visibleLightsBufferID = -1;
 	}
+
+	this->uploadedLights.clear();
 }
 
 UniformBufferID RenderLightManager::getVisibleLightsBufferID() const
@@ -64,63 +78,176 @@ int RenderLightManager::getVisibleLightCount()
 	return this->visibleLightCount;
 }
 
+RenderLightChunk &RenderLightManager::getOrAddLightChunk(const ChunkInt2 &chunkPos)
+{
+	const auto lightChunkIter = std::find_if(this->lightChunks.begin(), this->lightChunks.end(),
+		[&chunkPos](const RenderLightChunk &lightChunk)
+	{
+		return lightChunk.position == chunkPos;
+	});
+
+	if (lightChunkIter != this->lightChunks.end())
+	{
+		return *lightChunkIter;
+	}
+
+	RenderLightChunk &lightChunk = this->lightChunks.emplace_back(RenderLightChunk());
+	lightChunk.position = chunkPos;
+	return lightChunk;
+}
+
+void RenderLightManager::addEntityLight(EntityInstanceID entityInstID, const EntityChunkManager &entityChunkManager)
+{
+	if (this->entityLights.find(entityInstID) != this->entityLights.end())
+	{
+		// Entity already has a light added.
+		return;
+	}
+
+	const EntityInstance &entityInst = entityChunkManager.entities.get(entityInstID);
+	if (entityInst.isQueuedForDestroy)
+	{
+		return;
+	}
+
+	const EntityDefinition &entityDef = entityChunkManager.getEntityDef(entityInst.defID);
+	const std::optional<double> entityLightRadius = EntityUtils::tryGetLightRadius(entityDef);
+	const bool entityHasLight = entityLightRadius.has_value();
+	if (!entityHasLight)
+	{
+		return;
+	}
+
+	RenderLightEntry entityLight;
+
+	// The original game doesn't seem to update a light's radius after transitioning levels, it just uses the "S:#" from the start level .INF.
+	const double lightEndRadius = *entityLightRadius;
+	entityLight.light.startRadius = lightEndRadius * 0.50;
+	entityLight.light.endRadius = lightEndRadius;
+	entityLight.isStreetlight = EntityUtils::isStreetlight(entityDef);
+
+	const WorldDouble3 entityPosition = entityChunkManager.positions.get(entityInst.positionID);
+	entityLight.chunkPos = VoxelUtils::worldPointToChunk(entityPosition);
+
+	auto entityLightIter = this->entityLights.emplace(entityInstID, std::move(entityLight)).first;
+	this->updateEntityLightPosition(entityInstID, entityLightIter->second, entityPosition, entityChunkManager);
+
+	RenderLightChunk &lightChunk = this->getOrAddLightChunk(entityLightIter->second.chunkPos);
+	lightChunk.entityInstIDs.emplace_back(entityInstID);
+	lightChunk.isBBoxDirty = true;
+}
+
+void RenderLightManager::removeEntityLight(EntityInstanceID entityInstID)
+{
+	const auto entityLightIter = this->entityLights.find(entityInstID);
+	if (entityLightIter == this->entityLights.end())
+	{
+		return;
+	}
+
+	RenderLightChunk &lightChunk = this->getOrAddLightChunk(entityLightIter->second.chunkPos);
+	const auto lightChunkEntityIter = std::find(lightChunk.entityInstIDs.begin(), lightChunk.entityInstIDs.end(), entityInstID);
+	DebugAssert(lightChunkEntityIter != lightChunk.entityInstIDs.end());
+	lightChunk.entityInstIDs.erase(lightChunkEntityIter);
+	lightChunk.isBBoxDirty = true;
+
+	this->entityLights.erase(entityLightIter);
+}
+
+void RenderLightManager::updateEntityLightPosition(EntityInstanceID entityInstID, RenderLightEntry &entityLight, const WorldDouble3 &entityPosition,
+	const EntityChunkManager &entityChunkManager)
+{
+	const EntityInstance &entityInst = entityChunkManager.entities.get(entityInstID);
+	const BoundingBox3D &entityBBox = entityChunkManager.boundingBoxes.get(entityInst.bboxID);
+	const WorldDouble3 lightPosition = GetLightPositionInEntity(entityPosition, entityBBox);
+	entityLight.light.position = lightPosition;
+	entityLight.entityPosition = entityPosition;
+
+	const double entityLightWidth = entityLight.light.endRadius * 2.0;
+	const double entityLightHeight = entityLightWidth;
+	const double entityLightDepth = entityLightWidth;
+	entityLight.bbox.init(lightPosition, entityLightWidth, entityLightHeight, entityLightDepth);
+
+	const ChunkInt2 newChunkPos = VoxelUtils::worldPointToChunk(entityPosition);
+	if (newChunkPos != entityLight.chunkPos)
+	{
+		RenderLightChunk &oldLightChunk = this->getOrAddLightChunk(entityLight.chunkPos);
+		const auto oldLightChunkEntityIter = std::find(oldLightChunk.entityInstIDs.begin(), oldLightChunk.entityInstIDs.end(), entityInstID);
+		if (oldLightChunkEntityIter != oldLightChunk.entityInstIDs.end())
+		{
+			oldLightChunk.entityInstIDs.erase(oldLightChunkEntityIter);
+			oldLightChunk.isBBoxDirty = true;
+		}
+
+		entityLight.chunkPos = newChunkPos;
+		RenderLightChunk &newLightChunk = this->getOrAddLightChunk(newChunkPos);
+		newLightChunk.entityInstIDs.emplace_back(entityInstID);
+	}
+
+	this->getOrAddLightChunk(entityLight.chunkPos).isBBoxDirty = true;
+}
+
 void RenderLightManager::loadScene(Renderer &renderer)
 {
-	
+
 }
 
 void RenderLightManager::update(const RenderCamera &camera, bool nightLightsAreActive, bool isFogActive, bool playerHasLight,
 	const EntityChunkManager &entityChunkManager, Renderer &renderer)
 {
-	for (const EntityInstanceID entityInstID : entityChunkManager.destroyedEntityIDs)
+	// Created before moved and destroyed in case an entity was several of them this frame.
+	for (const EntityInstanceID entityInstID : entityChunkManager.createdEntityIDs)
 	{
-		const auto entityLightIter = this->entityLights.find(entityInstID);
-		if (entityLightIter != this->entityLights.end())
-		{
-			this->entityLights.erase(entityLightIter);
-		}
+		this->addEntityLight(entityInstID, entityChunkManager);
 	}
 
-	// @todo shouldn't need to iterate over chunks, just the chunk manager's total
-	// - if iterating over the entityChunkManager's total entities, need to check if entityInst.isQueuedForDestroy because destroyedEntityIDs are not yet removed from that at this point in the frame
-	for (int i = 0; i < entityChunkManager.getChunkCount(); i++)
+	// Only lights whose entity moved get new bounds. Most are torches and streetlights that never move.
+	for (const EntityInstanceID entityInstID : entityChunkManager.movedEntityIDs)
 	{
-		const EntityChunk &entityChunk = entityChunkManager.getChunkAtIndex(i);
-		const ChunkInt2 entityChunkPos = entityChunk.position;
-		for (const EntityInstanceID entityInstID : entityChunk.entityIDs)
+		const auto entityLightIter = this->entityLights.find(entityInstID);
+		if (entityLightIter == this->entityLights.end())
 		{
-			const auto entityLightIter = this->entityLights.find(entityInstID);
-			if (entityLightIter != this->entityLights.end())
-			{
-				// Entity already has a light added.
-				continue;
-			}
+			continue;
+		}
 
-			const EntityInstance &entityInst = entityChunkManager.entities.get(entityInstID);
-			const EntityDefinition &entityDef = entityChunkManager.getEntityDef(entityInst.defID);
-			const std::optional<double> entityLightRadius = EntityUtils::tryGetLightRadius(entityDef);
-			const bool entityHasLight = entityLightRadius.has_value();
-			if (!entityHasLight)
-			{
-				continue;
-			}
+		RenderLightEntry &entityLight = entityLightIter->second;
+		const EntityInstance &entityInst = entityChunkManager.entities.get(entityInstID);
+		const WorldDouble3 &entityPosition = entityChunkManager.positions.get(entityInst.positionID);
+		if (entityPosition != entityLight.entityPosition)
+		{
+			this->updateEntityLightPosition(entityInstID, entityLight, entityPosition, entityChunkManager);
+		}
+	}
 
-			RenderLightEntry entityLight;
-			entityLight.light.position = Double3::Zero;
+	for (const EntityInstanceID entityInstID : entityChunkManager.destroyedEntityIDs)
+	{
+		this->removeEntityLight(entityInstID);
+	}
 
-			// The original game doesn't seem to update a light's radius after transitioning levels, it just uses the "S:#" from the start level .INF.
-			const double lightEndRadius = *entityLightRadius;
-			entityLight.light.startRadius = lightEndRadius * 0.50;
-			entityLight.light.endRadius = lightEndRadius;
+	for (int i = static_cast<int>(this->lightChunks.size()) - 1; i >= 0; i--)
+	{
+		RenderLightChunk &lightChunk = this->lightChunks[i];
+		if (!lightChunk.isBBoxDirty)
+		{
+			continue;
+		}
 
-			entityLight.enabled = false;
+		if (lightChunk.entityInstIDs.empty())
+		{
+			this->lightChunks.erase(this->lightChunks.begin() + i);
+			continue;
+		}
 
-			this->entityLights.emplace(entityInstID, std::move(entityLight));
+		lightChunk.bbox = this->entityLights.at(lightChunk.entityInstIDs.front()).bbox;
+		for (const EntityInstanceID entityInstID : lightChunk.entityInstIDs)
+		{
+			lightChunk.bbox.expandToInclude(this->entityLights.at(entityInstID).bbox);
 		}
+
+		lightChunk.isBBoxDirty = false;
 	}
 
-	std::vector<RenderLight> visibleLights;
-	visibleLights.reserve(this->entityLights.size());
+	this->visibleLights.clear();
 
 	if (playerHasLight)
 	{
@@ -137,44 +264,43 @@ void RenderLightManager::update(const RenderCamera &camera, bool nightLightsAreA
 			this->playerLight.endRadius = ArenaRenderUtils::PLAYER_LIGHT_END_RADIUS;
 		}
 
-		visibleLights.emplace_back(this->playerLight);
+		this->visibleLights.emplace_back(this->playerLight);
 	}
 
-	for (std::pair<const EntityInstanceID, RenderLightEntry> &pair : this->entityLights)
+	for (const RenderLightChunk &lightChunk : this->lightChunks)
 	{
-		const EntityInstanceID entityInstID = pair.first;
-		RenderLightEntry &entityLight = pair.second;
-
-		const EntityInstance &entityInst = entityChunkManager.entities.get(entityInstID);
-		const WorldDouble3 entityPosition = entityChunkManager.positions.get(entityInstID);
-		const BoundingBox3D &entityBBox = entityChunkManager.boundingBoxes.get(entityInst.bboxID);
-		const WorldDouble3 lightPosition = GetLightPositionInEntity(entityPosition, entityBBox);
-		entityLight.light.position = lightPosition - camera.floatingOriginPoint;
-
-		const EntityDefinition &entityDef = entityChunkManager.getEntityDef(entityInst.defID);
-		entityLight.enabled = !EntityUtils::isStreetlight(entityDef) || nightLightsAreActive;
-		if (!entityLight.enabled)
+		bool isChunkCompletelyVisible, isChunkCompletelyInvisible;
+		RendererUtils::getBBoxVisibilityInFrustum(lightChunk.bbox, camera, &isChunkCompletelyVisible, &isChunkCompletelyInvisible);
+		if (isChunkCompletelyInvisible)
 		{
 			continue;
 		}
 
-		const double entityLightWidth = entityLight.light.endRadius * 2.0;
-		const double entityLightHeight = entityLightWidth;
-		const double entityLightDepth = entityLightWidth;
-		BoundingBox3D entityLightBBox;
-		entityLightBBox.init(lightPosition, entityLightWidth, entityLightHeight, entityLightDepth);
-
-		bool isBBoxCompletelyVisible, isBBoxCompletelyInvisible;
-		RendererUtils::getBBoxVisibilityInFrustum(entityLightBBox, camera, &isBBoxCompletelyVisible, &isBBoxCompletelyInvisible);
-		if (isBBoxCompletelyInvisible)
+		for (const EntityInstanceID entityInstID : lightChunk.entityInstIDs)
 		{
-			continue;
+			const RenderLightEntry &entityLight = this->entityLights.at(entityInstID);
+			if (entityLight.isStreetlight && !nightLightsAreActive)
+			{
+				continue;
+			}
+
+			if (!isChunkCompletelyVisible)
+			{
+				bool isBBoxCompletelyVisible, isBBoxCompletelyInvisible;
+				RendererUtils::getBBoxVisibilityInFrustum(entityLight.bbox, camera, &isBBoxCompletelyVisible, &isBBoxCompletelyInvisible);
+				if (isBBoxCompletelyInvisible)
+				{
+					continue;
+				}
+			}
+
+			RenderLight visibleLight = entityLight.light;
+			visibleLight.position = entityLight.light.position - camera.floatingOriginPoint;
+			this->visibleLights.emplace_back(visibleLight);
 		}
-		
-		visibleLights.emplace_back(entityLight.light);
 	}
 
-	std::sort(visibleLights.begin(), visibleLights.end(),
+	std::sort(this->visibleLights.begin(), this->visibleLights.end(),
 		[&camera](const RenderLight &a, const RenderLight &b)
 	{
 		const double aDistSqr = (a.position - camera.floatingWorldPoint).lengthSquared();
@@ -182,13 +308,26 @@ void RenderLightManager::update(const RenderCamera &camera, bool nightLightsAreA
 		return aDistSqr < bDistSqr;
 	});
 
-	this->visibleLightCount = std::min(static_cast<int>(visibleLights.size()), RenderLightManager::MAX_VISIBLE_LIGHTS);
+	this->visibleLightCount = std::min(static_cast<int>(this->visibleLights.size()), RenderLightManager::MAX_VISIBLE_LIGHTS);
+
+	// Only write lights that differ from last frame. Usually just the player's light when walking around.
+	const int uploadedLightCount = static_cast<int>(this->uploadedLights.size());
+	for (int i = 0; i < this->visibleLightCount; i++)
+	{
+		const RenderLight &visibleLight = this->visibleLights[i];
+		if ((i < uploadedLightCount) && IsSameRenderLight(visibleLight, this->uploadedLights[i]))
+		{
+			continue;
+		}
+
+		renderer.populateUniformBufferIndexLight(this->visibleLightsBufferID, i, visibleLight);
+	}
 
-	Span<const RenderLight> visibleLightsView(visibleLights.data(), this->visibleLightCount);
-	renderer.populateUniformBufferLights(this->visibleLightsBufferID, visibleLightsView);
+	this->uploadedLights.assign(this->visibleLights.begin(), this->visibleLights.begin() + this->visibleLightCount);
 }
 
 void RenderLightManager::unloadScene(Renderer &renderer)
 {
 	this->entityLights.clear();
+	this->lightChunks.clear();
 }
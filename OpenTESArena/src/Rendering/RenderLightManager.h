@@ -5,6 +5,8 @@
 
 #include "RenderLightUtils.h"
 #include "../Entities/EntityChunkManager.h"
+#include "../Math/BoundingBox.h"
+#include "../World/Coord.h"
 
 #include "components/utilities/Span.h"
 
@@ -21,21 +23,45 @@ struct RenderLight
 	RenderLight();
 };
 
+// Persists for the lifetime of its entity, only recalculated when the entity moves.
 struct RenderLightEntry
 {
-	RenderLight light;
-	bool enabled;
+	RenderLight light; // Position is in world space, converted relative to the floating origin when visible.
+	WorldDouble3 entityPosition; // For detecting when the entity moved.
+	BoundingBox3D bbox; // World space bounds of the end radius.
+	ChunkInt2 chunkPos;
+	bool isStreetlight;
 
 	RenderLightEntry();
 };
 
+// Entity lights grouped by the chunk they're in, so whole chunks outside the frustum can be skipped.
+struct RenderLightChunk
+{
+	ChunkInt2 position;
+	std::vector<EntityInstanceID> entityInstIDs;
+	BoundingBox3D bbox; // Union of the chunk's light bounds, which may extend past the chunk.
+	bool isBBoxDirty;
+
+	RenderLightChunk();
+};
+
 class RenderLightManager
 {
 private:
 	RenderLight playerLight;
 	std::unordered_map<EntityInstanceID, RenderLightEntry> entityLights;
+	std::vector<RenderLightChunk> lightChunks;
+	std::vector<RenderLight> visibleLights; // Sorted nearest first, reused each frame.
+	std::vector<RenderLight> uploadedLights; // Contents of the visible lights buffer for only writing changed indices.
 	UniformBufferID visibleLightsBufferID;
 	int visibleLightCount;
+
+	RenderLightChunk &getOrAddLightChunk(const ChunkInt2 &chunkPos);
+	void addEntityLight(EntityInstanceID entityInstID, const EntityChunkManager &entityChunkManager);
+	void removeEntityLight(EntityInstanceID entityInstID);
+	void updateEntityLightPosition(EntityInstanceID entityInstID, RenderLightEntry &entityLight, const WorldDouble3 &entityPosition,
+		const EntityChunkManager &entityChunkManager);
 public:
 	static constexpr int MAX_VISIBLE_LIGHTS = 256;
 
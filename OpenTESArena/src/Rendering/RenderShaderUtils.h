@@ -46,6 +46,20 @@ enum class DitheringMode
 static constexpr int DITHER_MODE_COUNT = 3;
 static constexpr int DITHERING_MODERN_MASK_COUNT = 4;
 
+// Floating-point type used by the software rasterizer for triangle setup, barycentrics, and depth.
+enum class RasterPrecisionMode
+{
+	Double,
+	Single
+};
+
+// How the software rasterizer shades opaque geometry.
+enum class ShadingMode
+{
+	Forward, // Shades every fragment that passes the depth test.
+	VisibilityBuffer // Rasterizes triangle IDs and depth first, then shades each visible pixel once.
+};
+
 using UniformBufferID = int;
 
 // Per-draw-call type for framebuffer dependencies like if the previous framebuffer should be provided as an input texture.
@@ -565,10 +565,11 @@ void RenderWeatherManager::update(double dt, const WeatherInstance &weatherInst,
 	this->fogDrawCall.clear();
 
 	// @todo: this isn't doing anything that changes per-frame now, move it to loadScene()
-	auto populateParticleDrawCall = [this, &renderer](RenderDrawCall &drawCall, UniformBufferID transformBufferID, int transformIndex, RenderMaterialID materialID)
+	auto populateParticleDrawCall = [this, &renderer](RenderDrawCall &drawCall, UniformBufferID transformBufferID, int transformIndex, int instanceCount, RenderMaterialID materialID)
 	{
 		drawCall.transformBufferID = transformBufferID;
 		drawCall.transformIndex = transformIndex;
+		drawCall.instanceCount = instanceCount;
 		drawCall.positionBufferID = this->particlePositionBufferID;
 		drawCall.normalBufferID = this->particleNormalBufferID;
 		drawCall.texCoordBufferID = this->particleTexCoordBufferID;
@@ -578,14 +579,14 @@ void RenderWeatherManager::update(double dt, const WeatherInstance &weatherInst,
 		drawCall.multipassType = RenderMultipassType::None;
 	};
 
-	auto populateRainDrawCall = [this, &populateParticleDrawCall](RenderDrawCall &drawCall, int transformIndex)
+	auto populateRainDrawCall = [this, &populateParticleDrawCall](RenderDrawCall &drawCall, int transformIndex, int instanceCount)
 	{
-		populateParticleDrawCall(drawCall, this->rainTransformBufferID, transformIndex, this->rainMaterialID);
+		populateParticleDrawCall(drawCall, this->rainTransformBufferID, transformIndex, instanceCount, this->rainMaterialID);
 	};
 
-	auto populateSnowDrawCall = [this, &populateParticleDrawCall](RenderDrawCall &drawCall, int transformIndex, RenderMaterialID materialID)
+	auto populateSnowDrawCall = [this, &populateParticleDrawCall](RenderDrawCall &drawCall, int transformIndex, int instanceCount, RenderMaterialID materialID)
 	{
-		populateParticleDrawCall(drawCall, this->snowTransformBufferID, transformIndex, materialID);
+		populateParticleDrawCall(drawCall, this->snowTransformBufferID, transformIndex, instanceCount, materialID);
 	};
 
 	const Matrix4d particleRotationMatrix = MakeParticleRotationMatrix(camera.yaw, camera.pitch);
@@ -597,9 +598,10 @@ void RenderWeatherManager::update(double dt, const WeatherInstance &weatherInst,
 		const int rainParticleCount = rainParticles.getCount();
 		DebugAssert(rainParticleCount == ArenaWeatherUtils::RAINDROP_TOTAL_COUNT);
 
-		if (this->rainDrawCalls.getCount() != rainParticleCount)
+		// Every raindrop shares a mesh and material, so one draw call instances them over their contiguous transforms.
+		if (this->rainDrawCalls.getCount() != 1)
 		{
-			this->rainDrawCalls.init(rainParticleCount);
+			this->rainDrawCalls.init(1);
 		}
 
 		const Matrix4d raindropScaleMatrix = MakeParticleScaleMatrix(RainTextureWidth, RainTextureHeight);
@@ -611,9 +613,9 @@ void RenderWeatherManager::update(double dt, const WeatherInstance &weatherInst,
 			const Matrix4d raindropTranslationMatrix = MakeParticleTranslationMatrix(camera, rainParticle.xPercent, rainParticle.yPercent);
 			const Matrix4d raindropModelMatrix = raindropTranslationMatrix * (particleRotationMatrix * raindropScaleMatrix);
 			renderer.populateUniformBufferIndexMatrix4(this->rainTransformBufferID, raindropTransformIndex, raindropModelMatrix);
-
-			populateRainDrawCall(this->rainDrawCalls[i], raindropTransformIndex);
 		}
+
+		populateRainDrawCall(this->rainDrawCalls[0], 0, rainParticleCount);
 	}
 
 	if (weatherInst.hasSnow())
@@ -622,17 +624,19 @@ void RenderWeatherManager::update(double dt, const WeatherInstance &weatherInst,
 		const Span<const WeatherParticle> snowParticles = snowInst.particles;
 		const int snowParticleCount = snowParticles.getCount();
 
-		if (this->snowDrawCalls.getCount() != snowParticleCount)
-		{
-			this->snowDrawCalls.init(snowParticleCount);
-		}
-
 		constexpr int fastSnowParticleCount = ArenaWeatherUtils::SNOWFLAKE_FAST_COUNT;
 		constexpr int mediumSnowParticleCount = ArenaWeatherUtils::SNOWFLAKE_MEDIUM_COUNT;
 		constexpr int slowSnowParticleCount = ArenaWeatherUtils::SNOWFLAKE_SLOW_COUNT;
 		DebugAssert((fastSnowParticleCount + mediumSnowParticleCount + slowSnowParticleCount) == snowParticleCount);
 
 		constexpr int snowParticleTypeCount = ArenaWeatherUtils::SNOWFLAKE_TYPE_COUNT;
+
+		// Snowflakes of one size share a material and contiguous transforms, so each size is one instanced draw call.
+		if (this->snowDrawCalls.getCount() != snowParticleTypeCount)
+		{
+			this->snowDrawCalls.init(snowParticleTypeCount);
+		}
+
 		constexpr int snowParticleStarts[snowParticleTypeCount] =
 		{
 			0,
@@ -663,10 +667,10 @@ void RenderWeatherManager::update(double dt, const WeatherInstance &weatherInst,
 				const Matrix4d snowParticleTranslationMatrix = MakeParticleTranslationMatrix(camera, snowParticle.xPercent, snowParticle.yPercent);
 				const Matrix4d snowParticleModelMatrix = snowParticleTranslationMatrix * (particleRotationMatrix * snowParticleScaleMatrix);
 				renderer.populateUniformBufferIndexMatrix4(this->snowTransformBufferID, snowParticleTransformIndex, snowParticleModelMatrix);
-
-				const RenderMaterialID snowParticleMaterialID = this->snowMaterialIDs[snowParticleSizeIndex];
-				populateSnowDrawCall(this->snowDrawCalls[i], snowParticleTransformIndex, snowParticleMaterialID);
 			}
+
+			const RenderMaterialID snowParticleMaterialID = this->snowMaterialIDs[snowParticleSizeIndex];
+			populateSnowDrawCall(this->snowDrawCalls[snowParticleSizeIndex], snowParticleStart, snowParticleEnd - snowParticleStart, snowParticleMaterialID);
 		}
 	}
 
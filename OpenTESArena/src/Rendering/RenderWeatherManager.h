@@ -24,12 +24,12 @@ private:
 	UniformBufferID rainTransformBufferID; // Contains render transforms for each raindrop.
 	ObjectTextureID rainTextureID;
 	RenderMaterialID rainMaterialID;
-	Buffer<RenderDrawCall> rainDrawCalls;
+	Buffer<RenderDrawCall> rainDrawCalls; // One instanced draw call for all raindrops.
 
 	UniformBufferID snowTransformBufferID; // Contains render transforms for each snowflake. 
 	ObjectTextureID snowTextureIDs[3]; // Each snowflake size has its own texture.
 	RenderMaterialID snowMaterialIDs[3];
-	Buffer<RenderDrawCall> snowDrawCalls;
+	Buffer<RenderDrawCall> snowDrawCalls; // One instanced draw call per snowflake size.
 
 	VertexPositionBufferID fogPositionBufferID;
 	VertexAttributeBufferID fogNormalBufferID;
@@ -32,6 +32,15 @@ namespace
 	constexpr double PHYSICS_DEBUG_MAX_DISTANCE = 4.0;
 	constexpr double PHYSICS_DEBUG_MAX_DISTANCE_SQR = PHYSICS_DEBUG_MAX_DISTANCE * PHYSICS_DEBUG_MAX_DISTANCE;
 
+	// Dynamic resolution governor. Thresholds are percents of the target frame time.
+	constexpr double DYNAMIC_RESOLUTION_SMOOTHING = 0.10; // Weight of the newest frame time in the moving average.
+	constexpr double DYNAMIC_RESOLUTION_DECREASE_THRESHOLD = 0.95;
+	constexpr double DYNAMIC_RESOLUTION_INCREASE_THRESHOLD = 0.70;
+	constexpr double DYNAMIC_RESOLUTION_TARGET = 0.85; // Where a decrease aims for, between the thresholds to avoid oscillating.
+	constexpr double DYNAMIC_RESOLUTION_MAX_DECREASE = 0.20;
+	constexpr double DYNAMIC_RESOLUTION_INCREASE = 0.05; // Recovers slowly since not all frame time scales with pixel count.
+	constexpr int DYNAMIC_RESOLUTION_COOLDOWN_FRAMES = 15; // Lets the moving average settle after a change.
+
 	Int2 MakeInternalRendererDimensions(const Int2 &dimensions, double resolutionScale)
 	{
 		const double scaledWidthReal = static_cast<double>(dimensions.x) * resolutionScale;
@@ -99,44 +108,83 @@ RendererProfilerData::RendererProfilerData()
 	this->pixelCount = -1;
 	this->threadCount = -1;
 	this->drawCallCount = -1;
+	this->sortedDrawCallCount = -1;
+	this->reusedFrameCount = -1;
 	this->presentedTriangleCount = -1;
 	this->objectTextureCount = -1;
 	this->objectTextureByteCount = -1;
+	this->objectTextureMipByteCount = -1;
 	this->uiTextureCount = -1;
 	this->uiTextureByteCount = -1;
 	this->materialCount = -1;
 	this->totalLightCount = -1;
 	this->totalCoverageTests = -1;
+	this->totalCoverageBlockAccepts = -1;
 	this->totalDepthTests = -1;
 	this->totalColorWrites = -1;
+	this->totalShadedFragments = -1;
+	this->totalMipmappedFragments = -1;
+	this->totalLitFragments = -1;
+	this->totalFragmentLightTests = -1;
+	this->binArenaPeakByteCount = -1;
+	this->binWidth = -1;
+	this->binHeight = -1;
+	this->binCount = -1;
+	this->binnedTriangleCount = -1;
+	this->maxBinTriangleCount = -1;
+	this->rasterPrecisionDiffPercent = -1.0;
+	this->rasterPrecisionPsnr = 0.0;
 	this->renderTime = 0.0;
-}
-
-void RendererProfilerData::init(int width, int height, int threadCount, int drawCallCount, int presentedTriangleCount, int objectTextureCount, int64_t objectTextureByteCount,
-	int uiTextureCount, int64_t uiTextureByteCount, int materialCount, int totalLightCount, int64_t totalCoverageTests, int64_t totalDepthTests,
-	int64_t totalColorWrites, double renderTime)
-{
-	this->width = width;
-	this->height = height;
-	this->pixelCount = width * height;
-	this->threadCount = threadCount;
-	this->drawCallCount = drawCallCount;
-	this->presentedTriangleCount = presentedTriangleCount;
-	this->objectTextureCount = objectTextureCount;
-	this->objectTextureByteCount = objectTextureByteCount;
-	this->uiTextureCount = uiTextureCount;
-	this->uiTextureByteCount = uiTextureByteCount;
-	this->materialCount = materialCount;
-	this->totalLightCount = totalLightCount;
-	this->totalCoverageTests = totalCoverageTests;
-	this->totalDepthTests = totalDepthTests;
-	this->totalColorWrites = totalColorWrites;
+	this->presentTime = 0.0;
+}
+
+void RendererProfilerData::init(const RendererProfilerData2D &profilerData2D, const RendererProfilerData3D &profilerData3D, double renderTime)
+{
+	this->width = profilerData3D.width;
+	this->height = profilerData3D.height;
+	this->pixelCount = profilerData3D.width * profilerData3D.height;
+	this->threadCount = profilerData3D.threadCount;
+	this->drawCallCount = profilerData3D.drawCallCount;
+	this->sortedDrawCallCount = profilerData3D.sortedDrawCallCount;
+	this->reusedFrameCount = profilerData3D.reusedFrameCount;
+	this->presentedTriangleCount = profilerData3D.presentedTriangleCount;
+	this->objectTextureCount = profilerData3D.objectTextureCount;
+	this->objectTextureByteCount = profilerData3D.objectTextureByteCount;
+	this->objectTextureMipByteCount = profilerData3D.objectTextureMipByteCount;
+	this->uiTextureCount = profilerData2D.uiTextureCount;
+	this->uiTextureByteCount = profilerData2D.uiTextureByteCount;
+	this->materialCount = profilerData3D.materialCount;
+	this->totalLightCount = profilerData3D.totalLightCount;
+	this->totalCoverageTests = profilerData3D.totalCoverageTests;
+	this->totalCoverageBlockAccepts = profilerData3D.totalCoverageBlockAccepts;
+	this->totalDepthTests = profilerData3D.totalDepthTests;
+	this->totalColorWrites = profilerData3D.totalColorWrites;
+	this->totalShadedFragments = profilerData3D.totalShadedFragments;
+	this->totalMipmappedFragments = profilerData3D.totalMipmappedFragments;
+	this->totalLitFragments = profilerData3D.totalLitFragments;
+	this->totalFragmentLightTests = profilerData3D.totalFragmentLightTests;
+	this->binArenaPeakByteCount = profilerData3D.binArenaPeakByteCount;
+	this->binWidth = profilerData3D.binWidth;
+	this->binHeight = profilerData3D.binHeight;
+	this->binCount = profilerData3D.binCount;
+	this->binnedTriangleCount = profilerData3D.binnedTriangleCount;
+	this->maxBinTriangleCount = profilerData3D.maxBinTriangleCount;
+	this->workerBusyTimes = profilerData3D.workerBusyTimes;
+	this->workerIdleTimes = profilerData3D.workerIdleTimes;
+	this->workerStageTimes = profilerData3D.workerStageTimes;
+	this->workerCpuIDs = profilerData3D.workerCpuIDs;
+	this->rasterPrecisionDiffPercent = profilerData3D.rasterPrecisionDiffPercent;
+	this->rasterPrecisionPsnr = profilerData3D.rasterPrecisionPsnr;
 	this->renderTime = renderTime;
+	this->presentTime = profilerData2D.presentTime;
 }
 
 Renderer::Renderer()
 {
 	this->window = nullptr;
+	this->dynamicResolutionScale = 0.0;
+	this->dynamicResolutionFrameTime = 0.0;
+	this->dynamicResolutionCooldownFrames = 0;
 }
 
 Renderer::~Renderer()
@@ -219,11 +267,22 @@ const RendererProfilerData &Renderer::getProfilerData() const
 	return this->profilerData;
 }
 
+double Renderer::getResolutionScale() const
+{
+	const double resolutionScale = this->resolutionScaleFunc();
+	if (this->dynamicResolutionScale > 0.0)
+	{
+		return std::min(this->dynamicResolutionScale, resolutionScale);
+	}
+
+	return resolutionScale;
+}
+
 void Renderer::resize(int windowWidth, int windowHeight)
 {
 	const Int2 windowDims = this->window->getPixelDimensions();
 	const Int2 viewDims = this->window->getSceneViewDimensions();
-	const double resolutionScale = this->resolutionScaleFunc();
+	const double resolutionScale = this->getResolutionScale();
 	const Int2 internalDims = MakeInternalRendererDimensions(viewDims, resolutionScale);
 	this->backend->resize(windowDims.x, windowDims.y, viewDims.x, viewDims.y, internalDims.x, internalDims.y);
 }
@@ -232,11 +291,80 @@ void Renderer::handleRenderTargetsReset()
 {
 	const Int2 windowDims = this->window->getPixelDimensions();
 	const Int2 viewDims = this->window->getSceneViewDimensions();
-	const double resolutionScale = this->resolutionScaleFunc();
+	const double resolutionScale = this->getResolutionScale();
 	const Int2 internalDims = MakeInternalRendererDimensions(viewDims, resolutionScale);
 	this->backend->handleRenderTargetsReset(windowDims.x, windowDims.y, viewDims.x, viewDims.y, internalDims.x, internalDims.y);
 }
 
+void Renderer::updateDynamicResolution(double frameTime, int targetFPS, bool isEnabled, double minResolutionScale)
+{
+	DebugAssert(targetFPS > 0);
+	const Int2 viewDims = this->window->getSceneViewDimensions();
+	const double maxResolutionScale = this->resolutionScaleFunc();
+	const double oldResolutionScale = this->getResolutionScale();
+
+	double newResolutionScale = oldResolutionScale;
+	if (!isEnabled)
+	{
+		if (this->dynamicResolutionScale <= 0.0)
+		{
+			return;
+		}
+
+		this->dynamicResolutionScale = 0.0;
+		newResolutionScale = maxResolutionScale;
+	}
+	else if (this->dynamicResolutionScale <= 0.0)
+	{
+		// Start from the options resolution scale.
+		this->dynamicResolutionScale = maxResolutionScale;
+		this->dynamicResolutionFrameTime = frameTime;
+		this->dynamicResolutionCooldownFrames = DYNAMIC_RESOLUTION_COOLDOWN_FRAMES;
+		return;
+	}
+	else
+	{
+		this->dynamicResolutionFrameTime += (frameTime - this->dynamicResolutionFrameTime) * DYNAMIC_RESOLUTION_SMOOTHING;
+
+		if (this->dynamicResolutionCooldownFrames > 0)
+		{
+			this->dynamicResolutionCooldownFrames--;
+			return;
+		}
+
+		// Pixel count goes with the square of the scale. Assume the whole frame time does too, any of it that doesn't
+		// just makes the next step smaller once the moving average catches up.
+		const double targetFrameTime = 1.0 / static_cast<double>(targetFPS);
+		const double frameTimePercent = this->dynamicResolutionFrameTime / targetFrameTime;
+		if (frameTimePercent > DYNAMIC_RESOLUTION_DECREASE_THRESHOLD)
+		{
+			const double idealResolutionScale = oldResolutionScale * std::sqrt(DYNAMIC_RESOLUTION_TARGET / frameTimePercent);
+			newResolutionScale = std::max(idealResolutionScale, oldResolutionScale - DYNAMIC_RESOLUTION_MAX_DECREASE);
+		}
+		else if (frameTimePercent < DYNAMIC_RESOLUTION_INCREASE_THRESHOLD)
+		{
+			newResolutionScale = oldResolutionScale + DYNAMIC_RESOLUTION_INCREASE;
+		}
+
+		newResolutionScale = std::clamp(newResolutionScale, std::min(minResolutionScale, maxResolutionScale), maxResolutionScale);
+		this->dynamicResolutionScale = newResolutionScale;
+	}
+
+	const Int2 oldInternalDims = MakeInternalRendererDimensions(viewDims, oldResolutionScale);
+	const Int2 newInternalDims = MakeInternalRendererDimensions(viewDims, newResolutionScale);
+	if (newInternalDims == oldInternalDims)
+	{
+		return;
+	}
+
+	DebugLogFormat("Dynamic resolution %.0f%% -> %.0f%% (%dx%d -> %dx%d), frame time %.2fms of %.2fms.", oldResolutionScale * 100.0,
+		newResolutionScale * 100.0, oldInternalDims.x, oldInternalDims.y, newInternalDims.x, newInternalDims.y,
+		this->dynamicResolutionFrameTime * 1000.0, 1000.0 / static_cast<double>(targetFPS));
+
+	this->backend->resizeInternal(newInternalDims.x, newInternalDims.y);
+	this->dynamicResolutionCooldownFrames = DYNAMIC_RESOLUTION_COOLDOWN_FRAMES;
+}
+
 VertexPositionBufferID Renderer::createVertexPositionBuffer(int vertexCount, int componentsPerVertex)
 {
 	const int bytesPerFloat = this->backend->getBytesPerFloat();
@@ -574,6 +702,31 @@ bool Renderer::populateUniformBufferIndexMatrix4(UniformBufferID id, int uniform
 	return true;
 }
 
+bool Renderer::populateUniformBufferIndexLight(UniformBufferID id, int uniformIndex, const RenderLight &light)
+{
+	LockedBuffer lockedBuffer = this->backend->lockUniformBufferIndex(id, uniformIndex);
+	if (!lockedBuffer.isValid())
+	{
+		DebugLogErrorFormat("Couldn't lock uniform buffer %d at index %d.", id, uniformIndex);
+		return false;
+	}
+
+	const int bytesPerFloat = this->backend->getBytesPerFloat();
+	if (bytesPerFloat == sizeof(double))
+	{
+		Span<const std::byte> lightBytes(reinterpret_cast<const std::byte*>(&light), sizeof(RenderLight));
+		DebugAssert(lightBytes.getCount() == lockedBuffer.bytes.getCount());
+		std::copy(lightBytes.begin(), lightBytes.end(), lockedBuffer.bytes.begin());
+	}
+	else
+	{
+		WriteRenderLightFloat32(light, lockedBuffer.bytes.begin());
+	}
+
+	this->backend->unlockUniformBufferIndex(id, uniformIndex);
+	return true;
+}
+
 ObjectTextureID Renderer::createObjectTexture(int width, int height, int bytesPerTexel)
 {
 	return this->backend->createObjectTexture(width, height, bytesPerTexel);
@@ -850,8 +1003,5 @@ void Renderer::submitFrame(const RenderDrawCommandList &renderCommandList, const
 	// Update profiler stats.
 	const RendererProfilerData2D profilerData2D = this->backend->getProfilerData2D();
 	const RendererProfilerData3D profilerData3D = this->backend->getProfilerData3D();
-	this->profilerData.init(profilerData3D.width, profilerData3D.height, profilerData3D.threadCount, profilerData3D.drawCallCount,
-		profilerData3D.presentedTriangleCount, profilerData3D.objectTextureCount, profilerData3D.objectTextureByteCount, profilerData2D.uiTextureCount,
-		profilerData2D.uiTextureByteCount, profilerData3D.materialCount, profilerData3D.totalLightCount, profilerData3D.totalCoverageTests,
-		profilerData3D.totalDepthTests, profilerData3D.totalColorWrites, renderTotalTime);
+	this->profilerData.init(profilerData2D, profilerData3D, renderTotalTime);
 }
@@ -4,6 +4,7 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <vector>
 
 #include "Jolt/Jolt.h"
 #include "Jolt/Renderer/DebugRendererSimple.h"
@@ -33,6 +34,8 @@ struct RenderCamera;
 struct RenderDrawCommandList;
 struct RenderFrameSettings;
 struct RenderLight;
+struct RendererProfilerData2D;
+struct RendererProfilerData3D;
 struct TextureBuilder;
 struct UiDrawCommandList;
 struct Window;
@@ -56,6 +59,8 @@ struct RendererProfilerData
 
 	int threadCount;
 	int drawCallCount;
+	int sortedDrawCallCount; // Reordered front-to-back to reduce overdraw.
+	int reusedFrameCount; // Consecutive frames presented again without rendering.
 
 	// Geometry.
 	int presentedTriangleCount; // After clipping, only screen-space triangles with onscreen area.
@@ -63,6 +68,7 @@ struct RendererProfilerData
 	// Textures.
 	int objectTextureCount;
 	int64_t objectTextureByteCount;
+	int64_t objectTextureMipByteCount;
 	int uiTextureCount;
 	int64_t uiTextureByteCount;
 
@@ -74,16 +80,39 @@ struct RendererProfilerData
 
 	// Pixel writes/overdraw.
 	int64_t totalCoverageTests;
+	int64_t totalCoverageBlockAccepts;
 	int64_t totalDepthTests;
 	int64_t totalColorWrites;
+	int64_t totalShadedFragments;
+	int64_t totalMipmappedFragments;
+	int64_t totalLitFragments;
+	int64_t totalFragmentLightTests;
+
+	// Rasterizer bin memory high-water mark for the frame.
+	int64_t binArenaPeakByteCount;
+
+	// Rasterizer bin layout and how many triangles it had to bin.
+	int binWidth, binHeight;
+	int binCount;
+	int64_t binnedTriangleCount;
+	int maxBinTriangleCount;
+
+	// Render thread load balance, in seconds.
+	std::vector<double> workerBusyTimes;
+	std::vector<double> workerIdleTimes;
+	std::vector<double> workerStageTimes; // RENDERER_PROFILER_STAGE_COUNT per render thread, empty if stage timers are off.
+	std::vector<int> workerCpuIDs; // -1 for unpinned render threads.
+
+	// Single-precision rasterizer error against a double-precision reference frame.
+	double rasterPrecisionDiffPercent;
+	double rasterPrecisionPsnr;
 
 	double renderTime;
+	double presentTime; // Window copies and present, part of renderTime.
 
 	RendererProfilerData();
 
-	void init(int width, int height, int threadCount, int drawCallCount, int presentedTriangleCount, int objectTextureCount, int64_t objectTextureByteCount,
-		int uiTextureCount, int64_t uiTextureByteCount, int materialCount, int totalLightCount, int64_t totalCoverageTests, int64_t totalDepthTests,
-		int64_t totalColorWrites, double renderTime);
+	void init(const RendererProfilerData2D &profilerData2D, const RendererProfilerData3D &profilerData3D, double renderTime);
 };
 
 using RenderResolutionScaleFunc = std::function<double()>;
@@ -96,6 +125,11 @@ private:
 	std::unique_ptr<RenderBackend> backend;
 	RendererProfilerData profilerData;
 	RenderResolutionScaleFunc resolutionScaleFunc; // Gets an up-to-date resolution scale value from the game options.
+
+	// Dynamic resolution governor state. The options resolution scale is the upper bound.
+	double dynamicResolutionScale; // Current scale, 0 if dynamic resolution is off.
+	double dynamicResolutionFrameTime; // Smoothed frame time in seconds the scale is adjusted against.
+	int dynamicResolutionCooldownFrames; // Frames until the scale can change again.
 public:
 	// Only defined so members are initialized for Game ctor exception handling.
 	Renderer();
@@ -110,12 +144,19 @@ public:
 	// Gets profiler data (timings, renderer properties, etc.).
 	const RendererProfilerData &getProfilerData() const;
 
+	// Gets the game world resolution scale in use, which dynamic resolution can lower from the options value.
+	double getResolutionScale() const;
+
 	// Resizes the renderer dimensions.
 	void resize(int windowWidth, int windowHeight);
 
 	// Handles resetting render target textures when switching in and out of exclusive fullscreen.
 	void handleRenderTargetsReset();
 
+	// Raises or lowers the game world render resolution between the min scale and the options resolution scale so the
+	// frame time (not counting frame limiter sleep) stays under the target frame time.
+	void updateDynamicResolution(double frameTime, int targetFPS, bool isEnabled, double minResolutionScale);
+
 	// Buffer management functions.
 	VertexPositionBufferID createVertexPositionBuffer(int vertexCount, int componentsPerVertex);
 	void freeVertexPositionBuffer(VertexPositionBufferID id);
@@ -140,6 +181,7 @@ public:
 	bool populateUniformBufferLights(UniformBufferID id, Span<const RenderLight> lights);
 	bool populateUniformBufferIndex(UniformBufferID id, int uniformIndex, Span<const std::byte> uniformBytes);
 	bool populateUniformBufferIndexMatrix4(UniformBufferID id, int uniformIndex, const Matrix4d &matrix);
+	bool populateUniformBufferIndexLight(UniformBufferID id, int uniformIndex, const RenderLight &light);
 
 	// Texture management functions.
 	ObjectTextureID createObjectTexture(int width, int height, int bytesPerTexel);
@@ -1,3 +1,5 @@
+#include <chrono>
+
 #include "SDL_hints.h"
 #include "SDL_render.h"
 
@@ -95,6 +97,7 @@ Sdl2DSoft3DRenderBackend::Sdl2DSoft3DRenderBackend()
 	this->renderer = nullptr;
 	this->nativeTexture = nullptr;
 	this->gameWorldTexture = nullptr;
+	this->presentTime = 0.0;
 }
 
 Sdl2DSoft3DRenderBackend::~Sdl2DSoft3DRenderBackend()
@@ -221,9 +224,37 @@ void Sdl2DSoft3DRenderBackend::handleRenderTargetsReset(int windowWidth, int win
 	this->renderer3D.resize(internalWidth, internalHeight);
 }
 
+void Sdl2DSoft3DRenderBackend::resizeInternal(int internalWidth, int internalHeight)
+{
+	int gameWorldTextureWidth = 0;
+	int gameWorldTextureHeight = 0;
+	if (this->gameWorldTexture != nullptr)
+	{
+		SDL_QueryTexture(this->gameWorldTexture, nullptr, nullptr, &gameWorldTextureWidth, &gameWorldTextureHeight);
+	}
+
+	if ((gameWorldTextureWidth != internalWidth) || (gameWorldTextureHeight != internalHeight))
+	{
+		if (this->gameWorldTexture != nullptr)
+		{
+			SDL_DestroyTexture(this->gameWorldTexture);
+		}
+
+		this->gameWorldTexture = SDL_CreateTexture(this->renderer, RendererUtils::DEFAULT_PIXELFORMAT, SDL_TEXTUREACCESS_STREAMING, internalWidth, internalHeight);
+		if (this->gameWorldTexture == nullptr)
+		{
+			DebugLogErrorFormat("Couldn't recreate game world texture for internal resize to %dx%d (%s).", internalWidth, internalHeight, SDL_GetError());
+		}
+	}
+
+	this->renderer3D.resize(internalWidth, internalHeight);
+}
+
 RendererProfilerData2D Sdl2DSoft3DRenderBackend::getProfilerData2D() const
 {
-	return this->renderer2D.getProfilerData();
+	RendererProfilerData2D profilerData = this->renderer2D.getProfilerData();
+	profilerData.presentTime = this->presentTime;
+	return profilerData;
 }
 
 RendererProfilerData3D Sdl2DSoft3DRenderBackend::getProfilerData3D() const
@@ -433,6 +464,7 @@ void Sdl2DSoft3DRenderBackend::submitFrame(const RenderDrawCommandList &renderCo
 	SDL_RenderClear(this->renderer);
 
 	// Render the game world (no UI).
+	std::chrono::high_resolution_clock::duration gameWorldCopyTime = std::chrono::high_resolution_clock::duration::zero();
 	if (renderCommandList.entryCount > 0)
 	{
 		uint32_t *outputBuffer;
@@ -454,7 +486,10 @@ void Sdl2DSoft3DRenderBackend::submitFrame(const RenderDrawCommandList &renderCo
 		gameWorldDrawRect.y = 0;
 		gameWorldDrawRect.w = viewDims.x;
 		gameWorldDrawRect.h = viewDims.y;
+
+		const auto gameWorldCopyStartTime = std::chrono::high_resolution_clock::now();
 		SDL_RenderCopy(this->renderer, this->gameWorldTexture, nullptr, &gameWorldDrawRect);
+		gameWorldCopyTime = std::chrono::high_resolution_clock::now() - gameWorldCopyStartTime;
 	}
 
 	for (int entryIndex = 0; entryIndex < uiCommandList.entryCount; entryIndex++)
@@ -463,7 +498,11 @@ void Sdl2DSoft3DRenderBackend::submitFrame(const RenderDrawCommandList &renderCo
 		this->renderer2D.draw(uiRenderElements);
 	}
 
+	const auto presentStartTime = std::chrono::high_resolution_clock::now();
 	SDL_SetRenderTarget(this->renderer, nullptr);
 	SDL_RenderCopy(this->renderer, this->nativeTexture, nullptr, nullptr);
 	SDL_RenderPresent(this->renderer);
+
+	const auto presentDuration = (std::chrono::high_resolution_clock::now() - presentStartTime) + gameWorldCopyTime;
+	this->presentTime = static_cast<double>(presentDuration.count()) / static_cast<double>(std::nano::den);
 }
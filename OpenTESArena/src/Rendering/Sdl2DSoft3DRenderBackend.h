@@ -13,6 +13,7 @@ private:
 	SDL_Texture *gameWorldTexture; // Internal rendering frame buffer, variable dimensions.
 	SdlUiRenderer renderer2D;
 	SoftwareRenderer renderer3D;
+	double presentTime; // Seconds spent in the last frame's window copies and present.
 public:
 	Sdl2DSoft3DRenderBackend();
 	virtual ~Sdl2DSoft3DRenderBackend();
@@ -23,6 +24,7 @@ public:
 
 	void resize(int windowWidth, int windowHeight, int sceneViewWidth, int sceneViewHeight, int internalWidth, int internalHeight) override;
 	void handleRenderTargetsReset(int windowWidth, int windowHeight, int sceneViewWidth, int sceneViewHeight, int internalWidth, int internalHeight) override;
+	void resizeInternal(int internalWidth, int internalHeight) override;
 
 	// Gets various profiler information about internal renderer state.
 	RendererProfilerData2D getProfilerData2D() const override;
@@ -74,8 +76,8 @@ public:
 	void setMaterialInstanceMeshLightPercent(RenderMaterialInstanceID id, double value) override;
 	void setMaterialInstanceTexCoordAnimPercent(RenderMaterialInstanceID id, double value) override;
 
-	// Renders a frame to the target window. Currently this is blocking and should be safe to present
-	// the frame upon returning.
+	// Renders a frame to the target window. With queued frames, the 3D scene shown is the previously submitted
+	// one while this frame's scene keeps rendering after returning. The UI is always current.
 	void submitFrame(const RenderDrawCommandList &renderCommandList, const UiDrawCommandList &uiCommandList,
 		const RenderCamera &camera, const RenderFrameSettings &frameSettings) override;
 };
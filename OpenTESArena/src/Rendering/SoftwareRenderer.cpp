@@ -1,11 +1,30 @@
 #include <algorithm>
-#include <condition_variable>
+#include <atomic>
+#include <bit>
+#include <chrono>
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
 #include <deque>
-#include <mutex>
+#include <limits>
+#include <memory>
 #include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define SOFTWARE_RENDERER_SIMD_X64
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define SOFTWARE_RENDERER_SIMD_ARM64
+#include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SOFTWARE_RENDERER_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define SOFTWARE_RENDERER_TARGET_AVX2
+#endif
 
 #include "ArenaRenderUtils.h"
 #include "RenderBackend.h"
@@ -25,6 +44,7 @@
 #include "../Utilities/Color.h"
 #include "../Utilities/Endian.h"
 #include "../Utilities/Palette.h"
+#include "../Utilities/Platform.h"
 #include "../World/ChunkUtils.h"
 
 #include "components/debug/Debug.h"
@@ -44,6 +64,460 @@ namespace
 	}
 }
 
+// SIMD math functions. The scalar templates further down are the reference implementations and are used
+// whenever a kernel here is null. Kernels are selected once at init based on CPU support.
+namespace
+{
+	enum class SimdBackend
+	{
+		Scalar,
+		SSE2,
+		AVX2,
+		NEON
+	};
+
+	using Matrix4MultiplyVector4Func = void(*)(
+		const double *__restrict mxxs, const double *__restrict mxys, const double *__restrict mxzs, const double *__restrict mxws,
+		const double *__restrict myxs, const double *__restrict myys, const double *__restrict myzs, const double *__restrict myws,
+		const double *__restrict mzxs, const double *__restrict mzys, const double *__restrict mzzs, const double *__restrict mzws,
+		const double *__restrict mwxs, const double *__restrict mwys, const double *__restrict mwzs, const double *__restrict mwws,
+		const double *__restrict xs, const double *__restrict ys, const double *__restrict zs, const double *__restrict ws,
+		double *__restrict outXs, double *__restrict outYs, double *__restrict outZs, double *__restrict outWs);
+
+	using Matrix4MultiplyVectorIgnoreW4Func = void(*)(
+		const double *__restrict mxxs, const double *__restrict mxys, const double *__restrict mxzs,
+		const double *__restrict myxs, const double *__restrict myys, const double *__restrict myzs,
+		const double *__restrict mzxs, const double *__restrict mzys, const double *__restrict mzzs,
+		const double *__restrict mwxs, const double *__restrict mwys, const double *__restrict mwzs,
+		const double *__restrict xs, const double *__restrict ys, const double *__restrict zs, const double *__restrict ws,
+		double *__restrict outXs, double *__restrict outYs, double *__restrict outZs);
+
+	using Matrix4MultiplyMatrix1Func = void(*)(
+		const double *__restrict m0xxs, const double *__restrict m0xys, const double *__restrict m0xzs, const double *__restrict m0xws,
+		const double *__restrict m0yxs, const double *__restrict m0yys, const double *__restrict m0yzs, const double *__restrict m0yws,
+		const double *__restrict m0zxs, const double *__restrict m0zys, const double *__restrict m0zzs, const double *__restrict m0zws,
+		const double *__restrict m0wxs, const double *__restrict m0wys, const double *__restrict m0wzs, const double *__restrict m0wws,
+		const double *__restrict m1xxs, const double *__restrict m1xys, const double *__restrict m1xzs, const double *__restrict m1xws,
+		const double *__restrict m1yxs, const double *__restrict m1yys, const double *__restrict m1yzs, const double *__restrict m1yws,
+		const double *__restrict m1zxs, const double *__restrict m1zys, const double *__restrict m1zzs, const double *__restrict m1zws,
+		const double *__restrict m1wxs, const double *__restrict m1wys, const double *__restrict m1wzs, const double *__restrict m1wws,
+		double *__restrict outMxxs, double *__restrict outMxys, double *__restrict outMxzs, double *__restrict outMxws,
+		double *__restrict outMyxs, double *__restrict outMyys, double *__restrict outMyzs, double *__restrict outMyws,
+		double *__restrict outMzxs, double *__restrict outMzys, double *__restrict outMzzs, double *__restrict outMzws,
+		double *__restrict outMwxs, double *__restrict outMwys, double *__restrict outMwzs, double *__restrict outMwws);
+
+	// Writes a bitmask per vertex of the clip planes it's outside of. Bits 0-2 are x/y/z < -w, bits 3-5 are x/y/z > w.
+	using TriangleClipOutcodesFunc = void(*)(const double *__restrict v0XYZW, const double *__restrict v1XYZW,
+		const double *__restrict v2XYZW, int *__restrict outOutcodes);
+
+	struct SimdKernels
+	{
+		SimdBackend backend;
+		Matrix4MultiplyVector4Func matrix4MultiplyVector4;
+		Matrix4MultiplyVectorIgnoreW4Func matrix4MultiplyVectorIgnoreW4;
+		Matrix4MultiplyMatrix1Func matrix4MultiplyMatrix1;
+		TriangleClipOutcodesFunc triangleClipOutcodes;
+
+		SimdKernels()
+		{
+			this->backend = SimdBackend::Scalar;
+			this->matrix4MultiplyVector4 = nullptr;
+			this->matrix4MultiplyVectorIgnoreW4 = nullptr;
+			this->matrix4MultiplyMatrix1 = nullptr;
+			this->triangleClipOutcodes = nullptr;
+		}
+	};
+
+	SimdKernels g_simdKernels;
+
+	std::string GetSimdBackendName(SimdBackend backend)
+	{
+		switch (backend)
+		{
+		case SimdBackend::Scalar:
+			return "Scalar";
+		case SimdBackend::SSE2:
+			return "SSE2";
+		case SimdBackend::AVX2:
+			return "AVX2";
+		case SimdBackend::NEON:
+			return "NEON";
+		default:
+			DebugUnhandledReturn(std::string);
+		}
+	}
+
+	// Four doubles as two 128-bit registers. SSE2 and NEON are both baseline on 64-bit targets so these don't
+	// need any per-function target attributes, and the kernels below are shared between them.
+#if defined(SOFTWARE_RENDERER_SIMD_X64)
+	struct Simd128Ops
+	{
+		struct Vec
+		{
+			__m128d lo, hi;
+		};
+
+		static Vec load(const double *ptr)
+		{
+			return { _mm_loadu_pd(ptr), _mm_loadu_pd(ptr + 2) };
+		}
+
+		static Vec set(double x, double y, double z, double w)
+		{
+			return { _mm_set_pd(y, x), _mm_set_pd(w, z) };
+		}
+
+		static Vec set1(double value)
+		{
+			const __m128d v = _mm_set1_pd(value);
+			return { v, v };
+		}
+
+		static void store(double *ptr, Vec v)
+		{
+			_mm_storeu_pd(ptr, v.lo);
+			_mm_storeu_pd(ptr + 2, v.hi);
+		}
+
+		static Vec add(Vec a, Vec b)
+		{
+			return { _mm_add_pd(a.lo, b.lo), _mm_add_pd(a.hi, b.hi) };
+		}
+
+		static Vec sub(Vec a, Vec b)
+		{
+			return { _mm_sub_pd(a.lo, b.lo), _mm_sub_pd(a.hi, b.hi) };
+		}
+
+		static Vec mul(Vec a, Vec b)
+		{
+			return { _mm_mul_pd(a.lo, b.lo), _mm_mul_pd(a.hi, b.hi) };
+		}
+
+		// Lanes where !(v >= 0), includes NaN.
+		static int notGreaterEqualZeroMask(Vec v)
+		{
+			const __m128d zero = _mm_setzero_pd();
+			return _mm_movemask_pd(_mm_cmpnge_pd(v.lo, zero)) | (_mm_movemask_pd(_mm_cmpnge_pd(v.hi, zero)) << 2);
+		}
+
+		// Lanes where !(v <= 0), includes NaN.
+		static int notLessEqualZeroMask(Vec v)
+		{
+			const __m128d zero = _mm_setzero_pd();
+			return _mm_movemask_pd(_mm_cmpnle_pd(v.lo, zero)) | (_mm_movemask_pd(_mm_cmpnle_pd(v.hi, zero)) << 2);
+		}
+	};
+
+	constexpr SimdBackend SIMD_128_BACKEND = SimdBackend::SSE2;
+#elif defined(SOFTWARE_RENDERER_SIMD_ARM64)
+	struct Simd128Ops
+	{
+		struct Vec
+		{
+			float64x2_t lo, hi;
+		};
+
+		static Vec load(const double *ptr)
+		{
+			return { vld1q_f64(ptr), vld1q_f64(ptr + 2) };
+		}
+
+		static Vec set(double x, double y, double z, double w)
+		{
+			const double values[] = { x, y, z, w };
+			return load(values);
+		}
+
+		static Vec set1(double value)
+		{
+			const float64x2_t v = vdupq_n_f64(value);
+			return { v, v };
+		}
+
+		static void store(double *ptr, Vec v)
+		{
+			vst1q_f64(ptr, v.lo);
+			vst1q_f64(ptr + 2, v.hi);
+		}
+
+		static Vec add(Vec a, Vec b)
+		{
+			return { vaddq_f64(a.lo, b.lo), vaddq_f64(a.hi, b.hi) };
+		}
+
+		static Vec sub(Vec a, Vec b)
+		{
+			return { vsubq_f64(a.lo, b.lo), vsubq_f64(a.hi, b.hi) };
+		}
+
+		static Vec mul(Vec a, Vec b)
+		{
+			return { vmulq_f64(a.lo, b.lo), vmulq_f64(a.hi, b.hi) };
+		}
+
+		static int laneMaskToBits(uint64x2_t lo, uint64x2_t hi)
+		{
+			return ((vgetq_lane_u64(lo, 0) != 0) ? 1 : 0) | ((vgetq_lane_u64(lo, 1) != 0) ? 2 : 0) |
+				((vgetq_lane_u64(hi, 0) != 0) ? 4 : 0) | ((vgetq_lane_u64(hi, 1) != 0) ? 8 : 0);
+		}
+
+		static int notGreaterEqualZeroMask(Vec v)
+		{
+			const float64x2_t zero = vdupq_n_f64(0.0);
+			return laneMaskToBits(vcgeq_f64(v.lo, zero), vcgeq_f64(v.hi, zero)) ^ 0xF;
+		}
+
+		static int notLessEqualZeroMask(Vec v)
+		{
+			const float64x2_t zero = vdupq_n_f64(0.0);
+			return laneMaskToBits(vcleq_f64(v.lo, zero), vcleq_f64(v.hi, zero)) ^ 0xF;
+		}
+	};
+
+	constexpr SimdBackend SIMD_128_BACKEND = SimdBackend::NEON;
+#endif
+
+#if defined(SOFTWARE_RENDERER_SIMD_X64) || defined(SOFTWARE_RENDERER_SIMD_ARM64)
+	// Same operation order as the scalar versions so results are identical.
+	template<typename Ops>
+	void Simd_Matrix4_MultiplyVector4(
+		const double *__restrict mxxs, const double *__restrict mxys, const double *__restrict mxzs, const double *__restrict mxws,
+		const double *__restrict myxs, const double *__restrict myys, const double *__restrict myzs, const double *__restrict myws,
+		const double *__restrict mzxs, const double *__restrict mzys, const double *__restrict mzzs, const double *__restrict mzws,
+		const double *__restrict mwxs, const double *__restrict mwys, const double *__restrict mwzs, const double *__restrict mwws,
+		const double *__restrict xs, const double *__restrict ys, const double *__restrict zs, const double *__restrict ws,
+		double *__restrict outXs, double *__restrict outYs, double *__restrict outZs, double *__restrict outWs)
+	{
+		const typename Ops::Vec x = Ops::load(xs);
+		const typename Ops::Vec y = Ops::load(ys);
+		const typename Ops::Vec z = Ops::load(zs);
+		const typename Ops::Vec w = Ops::load(ws);
+		Ops::store(outXs, Ops::add(Ops::load(outXs), Ops::add(Ops::add(Ops::add(Ops::mul(Ops::load(mxxs), x), Ops::mul(Ops::load(myxs), y)), Ops::mul(Ops::load(mzxs), z)), Ops::mul(Ops::load(mwxs), w))));
+		Ops::store(outYs, Ops::add(Ops::load(outYs), Ops::add(Ops::add(Ops::add(Ops::mul(Ops::load(mxys), x), Ops::mul(Ops::load(myys), y)), Ops::mul(Ops::load(mzys), z)), Ops::mul(Ops::load(mwys), w))));
+		Ops::store(outZs, Ops::add(Ops::load(outZs), Ops::add(Ops::add(Ops::add(Ops::mul(Ops::load(mxzs), x), Ops::mul(Ops::load(myzs), y)), Ops::mul(Ops::load(mzzs), z)), Ops::mul(Ops::load(mwzs), w))));
+		Ops::store(outWs, Ops::add(Ops::load(outWs), Ops::add(Ops::add(Ops::add(Ops::mul(Ops::load(mxws), x), Ops::mul(Ops::load(myws), y)), Ops::mul(Ops::load(mzws), z)), Ops::mul(Ops::load(mwws), w))));
+	}
+
+	template<typename Ops>
+	void Simd_Matrix4_MultiplyVectorIgnoreW4(
+		const double *__restrict mxxs, const double *__restrict mxys, const double *__restrict mxzs,
+		const double *__restrict myxs, const double *__restrict myys, const double *__restrict myzs,
+		const double *__restrict mzxs, const double *__restrict mzys, const double *__restrict mzzs,
+		const double *__restrict mwxs, const double *__restrict mwys, const double *__restrict mwzs,
+		const double *__restrict xs, const double *__restrict ys, const double *__restrict zs, const double *__restrict ws,
+		double *__restrict outXs, double *__restrict outYs, double *__restrict outZs)
+	{
+		const typename Ops::Vec x = Ops::load(xs);
+		const typename Ops::Vec y = Ops::load(ys);
+		const typename Ops::Vec z = Ops::load(zs);
+		const typename Ops::Vec w = Ops::load(ws);
+		Ops::store(outXs, Ops::add(Ops::load(outXs), Ops::add(Ops::add(Ops::add(Ops::mul(Ops::load(mxxs), x), Ops::mul(Ops::load(myxs), y)), Ops::mul(Ops::load(mzxs), z)), Ops::mul(Ops::load(mwxs), w))));
+		Ops::store(outYs, Ops::add(Ops::load(outYs), Ops::add(Ops::add(Ops::add(Ops::mul(Ops::load(mxys), x), Ops::mul(Ops::load(myys), y)), Ops::mul(Ops::load(mzys), z)), Ops::mul(Ops::load(mwys), w))));
+		Ops::store(outZs, Ops::add(Ops::load(outZs), Ops::add(Ops::add(Ops::add(Ops::mul(Ops::load(mxzs), x), Ops::mul(Ops::load(myzs), y)), Ops::mul(Ops::load(mzzs), z)), Ops::mul(Ops::load(mwzs), w))));
+	}
+
+	// Single matrix product with the columns of m0 held in registers.
+	template<typename Ops>
+	void Simd_Matrix4_MultiplyMatrix1(
+		const double *__restrict m0xxs, const double *__restrict m0xys, const double *__restrict m0xzs, const double *__restrict m0xws,
+		const double *__restrict m0yxs, const double *__restrict m0yys, const double *__restrict m0yzs, const double *__restrict m0yws,
+		const double *__restrict m0zxs, const double *__restrict m0zys, const double *__restrict m0zzs, const double *__restrict m0zws,
+		const double *__restrict m0wxs, const double *__restrict m0wys, const double *__restrict m0wzs, const double *__restrict m0wws,
+		const double *__restrict m1xxs, const double *__restrict m1xys, const double *__restrict m1xzs, const double *__restrict m1xws,
+		const double *__restrict m1yxs, const double *__restrict m1yys, const double *__restrict m1yzs, const double *__restrict m1yws,
+		const double *__restrict m1zxs, const double *__restrict m1zys, const double *__restrict m1zzs, const double *__restrict m1zws,
+		const double *__restrict m1wxs, const double *__restrict m1wys, const double *__restrict m1wzs, const double *__restrict m1wws,
+		double *__restrict outMxxs, double *__restrict outMxys, double *__restrict outMxzs, double *__restrict outMxws,
+		double *__restrict outMyxs, double *__restrict outMyys, double *__restrict outMyzs, double *__restrict outMyws,
+		double *__restrict outMzxs, double *__restrict outMzys, double *__restrict outMzzs, double *__restrict outMzws,
+		double *__restrict outMwxs, double *__restrict outMwys, double *__restrict outMwzs, double *__restrict outMwws)
+	{
+		const typename Ops::Vec m0x = Ops::set(*m0xxs, *m0xys, *m0xzs, *m0xws);
+		const typename Ops::Vec m0y = Ops::set(*m0yxs, *m0yys, *m0yzs, *m0yws);
+		const typename Ops::Vec m0z = Ops::set(*m0zxs, *m0zys, *m0zzs, *m0zws);
+		const typename Ops::Vec m0w = Ops::set(*m0wxs, *m0wys, *m0wzs, *m0wws);
+
+		double results[4];
+		Ops::store(results, Ops::add(Ops::add(Ops::add(Ops::mul(m0x, Ops::set1(*m1xxs)), Ops::mul(m0y, Ops::set1(*m1xys))), Ops::mul(m0z, Ops::set1(*m1xzs))), Ops::mul(m0w, Ops::set1(*m1xws))));
+		*outMxxs = results[0];
+		*outMxys = results[1];
+		*outMxzs = results[2];
+		*outMxws = results[3];
+
+		Ops::store(results, Ops::add(Ops::add(Ops::add(Ops::mul(m0x, Ops::set1(*m1yxs)), Ops::mul(m0y, Ops::set1(*m1yys))), Ops::mul(m0z, Ops::set1(*m1yzs))), Ops::mul(m0w, Ops::set1(*m1yws))));
+		*outMyxs = results[0];
+		*outMyys = results[1];
+		*outMyzs = results[2];
+		*outMyws = results[3];
+
+		Ops::store(results, Ops::add(Ops::add(Ops::add(Ops::mul(m0x, Ops::set1(*m1zxs)), Ops::mul(m0y, Ops::set1(*m1zys))), Ops::mul(m0z, Ops::set1(*m1zzs))), Ops::mul(m0w, Ops::set1(*m1zws))));
+		*outMzxs = results[0];
+		*outMzys = results[1];
+		*outMzzs = results[2];
+		*outMzws = results[3];
+
+		Ops::store(results, Ops::add(Ops::add(Ops::add(Ops::mul(m0x, Ops::set1(*m1wxs)), Ops::mul(m0y, Ops::set1(*m1wys))), Ops::mul(m0z, Ops::set1(*m1wzs))), Ops::mul(m0w, Ops::set1(*m1wws))));
+		*outMwxs = results[0];
+		*outMwys = results[1];
+		*outMwzs = results[2];
+		*outMwws = results[3];
+	}
+
+	template<typename Ops>
+	int Simd_GetClipOutcode(const double *__restrict xyzw)
+	{
+		const typename Ops::Vec v = Ops::load(xyzw);
+		const typename Ops::Vec w = Ops::set1(xyzw[3]);
+		const int belowMask = Ops::notGreaterEqualZeroMask(Ops::add(v, w));
+		const int aboveMask = Ops::notLessEqualZeroMask(Ops::sub(v, w));
+		return (belowMask & 0x7) | ((aboveMask & 0x7) << 3);
+	}
+
+	template<typename Ops>
+	void Simd_GetTriangleClipOutcodes(const double *__restrict v0XYZW, const double *__restrict v1XYZW, const double *__restrict v2XYZW,
+		int *__restrict outOutcodes)
+	{
+		outOutcodes[0] = Simd_GetClipOutcode<Ops>(v0XYZW);
+		outOutcodes[1] = Simd_GetClipOutcode<Ops>(v1XYZW);
+		outOutcodes[2] = Simd_GetClipOutcode<Ops>(v2XYZW);
+	}
+#endif
+
+#if defined(SOFTWARE_RENDERER_SIMD_X64)
+	// AVX2 isn't baseline for generic x86-64 builds so these functions are compiled for it individually and only
+	// called after the CPU check passes. They can't share the templates above due to target attribute rules.
+	SOFTWARE_RENDERER_TARGET_AVX2 __m256d Avx2_Dot4(__m256d m0, __m256d x, __m256d m1, __m256d y, __m256d m2, __m256d z, __m256d m3, __m256d w)
+	{
+		return _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(m0, x), _mm256_mul_pd(m1, y)), _mm256_mul_pd(m2, z)), _mm256_mul_pd(m3, w));
+	}
+
+	SOFTWARE_RENDERER_TARGET_AVX2 void Avx2_Matrix4_MultiplyVector4(
+		const double *__restrict mxxs, const double *__restrict mxys, const double *__restrict mxzs, const double *__restrict mxws,
+		const double *__restrict myxs, const double *__restrict myys, const double *__restrict myzs, const double *__restrict myws,
+		const double *__restrict mzxs, const double *__restrict mzys, const double *__restrict mzzs, const double *__restrict mzws,
+		const double *__restrict mwxs, const double *__restrict mwys, const double *__restrict mwzs, const double *__restrict mwws,
+		const double *__restrict xs, const double *__restrict ys, const double *__restrict zs, const double *__restrict ws,
+		double *__restrict outXs, double *__restrict outYs, double *__restrict outZs, double *__restrict outWs)
+	{
+		const __m256d x = _mm256_loadu_pd(xs);
+		const __m256d y = _mm256_loadu_pd(ys);
+		const __m256d z = _mm256_loadu_pd(zs);
+		const __m256d w = _mm256_loadu_pd(ws);
+		_mm256_storeu_pd(outXs, _mm256_add_pd(_mm256_loadu_pd(outXs), Avx2_Dot4(_mm256_loadu_pd(mxxs), x, _mm256_loadu_pd(myxs), y, _mm256_loadu_pd(mzxs), z, _mm256_loadu_pd(mwxs), w)));
+		_mm256_storeu_pd(outYs, _mm256_add_pd(_mm256_loadu_pd(outYs), Avx2_Dot4(_mm256_loadu_pd(mxys), x, _mm256_loadu_pd(myys), y, _mm256_loadu_pd(mzys), z, _mm256_loadu_pd(mwys), w)));
+		_mm256_storeu_pd(outZs, _mm256_add_pd(_mm256_loadu_pd(outZs), Avx2_Dot4(_mm256_loadu_pd(mxzs), x, _mm256_loadu_pd(myzs), y, _mm256_loadu_pd(mzzs), z, _mm256_loadu_pd(mwzs), w)));
+		_mm256_storeu_pd(outWs, _mm256_add_pd(_mm256_loadu_pd(outWs), Avx2_Dot4(_mm256_loadu_pd(mxws), x, _mm256_loadu_pd(myws), y, _mm256_loadu_pd(mzws), z, _mm256_loadu_pd(mwws), w)));
+	}
+
+	SOFTWARE_RENDERER_TARGET_AVX2 void Avx2_Matrix4_MultiplyVectorIgnoreW4(
+		const double *__restrict mxxs, const double *__restrict mxys, const double *__restrict mxzs,
+		const double *__restrict myxs, const double *__restrict myys, const double *__restrict myzs,
+		const double *__restrict mzxs, const double *__restrict mzys, const double *__restrict mzzs,
+		const double *__restrict mwxs, const double *__restrict mwys, const double *__restrict mwzs,
+		const double *__restrict xs, const double *__restrict ys, const double *__restrict zs, const double *__restrict ws,
+		double *__restrict outXs, double *__restrict outYs, double *__restrict outZs)
+	{
+		const __m256d x = _mm256_loadu_pd(xs);
+		const __m256d y = _mm256_loadu_pd(ys);
+		const __m256d z = _mm256_loadu_pd(zs);
+		const __m256d w = _mm256_loadu_pd(ws);
+		_mm256_storeu_pd(outXs, _mm256_add_pd(_mm256_loadu_pd(outXs), Avx2_Dot4(_mm256_loadu_pd(mxxs), x, _mm256_loadu_pd(myxs), y, _mm256_loadu_pd(mzxs), z, _mm256_loadu_pd(mwxs), w)));
+		_mm256_storeu_pd(outYs, _mm256_add_pd(_mm256_loadu_pd(outYs), Avx2_Dot4(_mm256_loadu_pd(mxys), x, _mm256_loadu_pd(myys), y, _mm256_loadu_pd(mzys), z, _mm256_loadu_pd(mwys), w)));
+		_mm256_storeu_pd(outZs, _mm256_add_pd(_mm256_loadu_pd(outZs), Avx2_Dot4(_mm256_loadu_pd(mxzs), x, _mm256_loadu_pd(myzs), y, _mm256_loadu_pd(mzzs), z, _mm256_loadu_pd(mwzs), w)));
+	}
+
+	SOFTWARE_RENDERER_TARGET_AVX2 void Avx2_Matrix4_MultiplyMatrix1(
+		const double *__restrict m0xxs, const double *__restrict m0xys, const double *__restrict m0xzs, const double *__restrict m0xws,
+		const double *__restrict m0yxs, const double *__restrict m0yys, const double *__restrict m0yzs, const double *__restrict m0yws,
+		const double *__restrict m0zxs, const double *__restrict m0zys, const double *__restrict m0zzs, const double *__restrict m0zws,
+		const double *__restrict m0wxs, const double *__restrict m0wys, const double *__restrict m0wzs, const double *__restrict m0wws,
+		const double *__restrict m1xxs, const double *__restrict m1xys, const double *__restrict m1xzs, const double *__restrict m1xws,
+		const double *__restrict m1yxs, const double *__restrict m1yys, const double *__restrict m1yzs, const double *__restrict m1yws,
+		const double *__restrict m1zxs, const double *__restrict m1zys, const double *__restrict m1zzs, const double *__restrict m1zws,
+		const double *__restrict m1wxs, const double *__restrict m1wys, const double *__restrict m1wzs, const double *__restrict m1wws,
+		double *__restrict outMxxs, double *__restrict outMxys, double *__restrict outMxzs, double *__restrict outMxws,
+		double *__restrict outMyxs, double *__restrict outMyys, double *__restrict outMyzs, double *__restrict outMyws,
+		double *__restrict outMzxs, double *__restrict outMzys, double *__restrict outMzzs, double *__restrict outMzws,
+		double *__restrict outMwxs, double *__restrict outMwys, double *__restrict outMwzs, double *__restrict outMwws)
+	{
+		const __m256d m0x = _mm256_set_pd(*m0xws, *m0xzs, *m0xys, *m0xxs);
+		const __m256d m0y = _mm256_set_pd(*m0yws, *m0yzs, *m0yys, *m0yxs);
+		const __m256d m0z = _mm256_set_pd(*m0zws, *m0zzs, *m0zys, *m0zxs);
+		const __m256d m0w = _mm256_set_pd(*m0wws, *m0wzs, *m0wys, *m0wxs);
+
+		double results[4];
+		_mm256_storeu_pd(results, Avx2_Dot4(m0x, _mm256_set1_pd(*m1xxs), m0y, _mm256_set1_pd(*m1xys), m0z, _mm256_set1_pd(*m1xzs), m0w, _mm256_set1_pd(*m1xws)));
+		*outMxxs = results[0];
+		*outMxys = results[1];
+		*outMxzs = results[2];
+		*outMxws = results[3];
+
+		_mm256_storeu_pd(results, Avx2_Dot4(m0x, _mm256_set1_pd(*m1yxs), m0y, _mm256_set1_pd(*m1yys), m0z, _mm256_set1_pd(*m1yzs), m0w, _mm256_set1_pd(*m1yws)));
+		*outMyxs = results[0];
+		*outMyys = results[1];
+		*outMyzs = results[2];
+		*outMyws = results[3];
+
+		_mm256_storeu_pd(results, Avx2_Dot4(m0x, _mm256_set1_pd(*m1zxs), m0y, _mm256_set1_pd(*m1zys), m0z, _mm256_set1_pd(*m1zzs), m0w, _mm256_set1_pd(*m1zws)));
+		*outMzxs = results[0];
+		*outMzys = results[1];
+		*outMzzs = results[2];
+		*outMzws = results[3];
+
+		_mm256_storeu_pd(results, Avx2_Dot4(m0x, _mm256_set1_pd(*m1wxs), m0y, _mm256_set1_pd(*m1wys), m0z, _mm256_set1_pd(*m1wzs), m0w, _mm256_set1_pd(*m1wws)));
+		*outMwxs = results[0];
+		*outMwys = results[1];
+		*outMwzs = results[2];
+		*outMwws = results[3];
+	}
+
+	SOFTWARE_RENDERER_TARGET_AVX2 int Avx2_GetClipOutcode(const double *__restrict xyzw)
+	{
+		const __m256d zero = _mm256_setzero_pd();
+		const __m256d v = _mm256_loadu_pd(xyzw);
+		const __m256d w = _mm256_broadcast_sd(xyzw + 3);
+		const int belowMask = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_add_pd(v, w), zero, _CMP_NGE_UQ));
+		const int aboveMask = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_sub_pd(v, w), zero, _CMP_NLE_UQ));
+		return (belowMask & 0x7) | ((aboveMask & 0x7) << 3);
+	}
+
+	SOFTWARE_RENDERER_TARGET_AVX2 void Avx2_GetTriangleClipOutcodes(const double *__restrict v0XYZW, const double *__restrict v1XYZW,
+		const double *__restrict v2XYZW, int *__restrict outOutcodes)
+	{
+		outOutcodes[0] = Avx2_GetClipOutcode(v0XYZW);
+		outOutcodes[1] = Avx2_GetClipOutcode(v1XYZW);
+		outOutcodes[2] = Avx2_GetClipOutcode(v2XYZW);
+	}
+#endif
+
+	void InitSimdKernels()
+	{
+		g_simdKernels = SimdKernels();
+
+#if defined(SOFTWARE_RENDERER_SIMD_X64) || defined(SOFTWARE_RENDERER_SIMD_ARM64)
+		g_simdKernels.backend = SIMD_128_BACKEND;
+		g_simdKernels.matrix4MultiplyVector4 = Simd_Matrix4_MultiplyVector4<Simd128Ops>;
+		g_simdKernels.matrix4MultiplyVectorIgnoreW4 = Simd_Matrix4_MultiplyVectorIgnoreW4<Simd128Ops>;
+		g_simdKernels.matrix4MultiplyMatrix1 = Simd_Matrix4_MultiplyMatrix1<Simd128Ops>;
+		g_simdKernels.triangleClipOutcodes = Simd_GetTriangleClipOutcodes<Simd128Ops>;
+#endif
+
+#if defined(SOFTWARE_RENDERER_SIMD_X64)
+		if (Platform::hasAVX())
+		{
+			g_simdKernels.backend = SimdBackend::AVX2;
+			g_simdKernels.matrix4MultiplyVector4 = Avx2_Matrix4_MultiplyVector4;
+			g_simdKernels.matrix4MultiplyVectorIgnoreW4 = Avx2_Matrix4_MultiplyVectorIgnoreW4;
+			g_simdKernels.matrix4MultiplyMatrix1 = Avx2_Matrix4_MultiplyMatrix1;
+			g_simdKernels.triangleClipOutcodes = Avx2_GetTriangleClipOutcodes;
+		}
+#endif
+
+		DebugLogFormat("Software renderer SIMD: %s", GetSimdBackendName(g_simdKernels.backend).c_str());
+	}
+}
+
 // Optimized math functions.
 namespace
 {
@@ -472,6 +946,16 @@ namespace
 		const double *__restrict xs, const double *__restrict ys, const double *__restrict zs, const double *__restrict ws,
 		double *__restrict outXs, double *__restrict outYs, double *__restrict outZs, double *__restrict outWs)
 	{
+		if constexpr (N == TYPICAL_LOOP_UNROLL)
+		{
+			if (g_simdKernels.matrix4MultiplyVector4 != nullptr)
+			{
+				g_simdKernels.matrix4MultiplyVector4(mxxs, mxys, mxzs, mxws, myxs, myys, myzs, myws, mzxs, mzys, mzzs, mzws,
+					mwxs, mwys, mwzs, mwws, xs, ys, zs, ws, outXs, outYs, outZs, outWs);
+				return;
+			}
+		}
+
 		for (int i = 0; i < N; i++)
 		{
 			outXs[i] += (mxxs[i] * xs[i]) + (myxs[i] * ys[i]) + (mzxs[i] * zs[i]) + (mwxs[i] * ws[i]);
@@ -502,6 +986,16 @@ namespace
 		const double *__restrict xs, const double *__restrict ys, const double *__restrict zs, const double *__restrict ws,
 		double *__restrict outXs, double *__restrict outYs, double *__restrict outZs)
 	{
+		if constexpr (N == TYPICAL_LOOP_UNROLL)
+		{
+			if (g_simdKernels.matrix4MultiplyVectorIgnoreW4 != nullptr)
+			{
+				g_simdKernels.matrix4MultiplyVectorIgnoreW4(mxxs, mxys, mxzs, myxs, myys, myzs, mzxs, mzys, mzzs, mwxs, mwys, mwzs,
+					xs, ys, zs, ws, outXs, outYs, outZs);
+				return;
+			}
+		}
+
 		for (int i = 0; i < N; i++)
 		{
 			outXs[i] += (mxxs[i] * xs[i]) + (myxs[i] * ys[i]) + (mzxs[i] * zs[i]) + (mwxs[i] * ws[i]);
@@ -532,6 +1026,18 @@ namespace
 		double *__restrict outMzxs, double *__restrict outMzys, double *__restrict outMzzs, double *__restrict outMzws,
 		double *__restrict outMwxs, double *__restrict outMwys, double *__restrict outMwzs, double *__restrict outMwws)
 	{
+		if constexpr (N == 1)
+		{
+			if (g_simdKernels.matrix4MultiplyMatrix1 != nullptr)
+			{
+				g_simdKernels.matrix4MultiplyMatrix1(m0xxs, m0xys, m0xzs, m0xws, m0yxs, m0yys, m0yzs, m0yws, m0zxs, m0zys, m0zzs, m0zws,
+					m0wxs, m0wys, m0wzs, m0wws, m1xxs, m1xys, m1xzs, m1xws, m1yxs, m1yys, m1yzs, m1yws, m1zxs, m1zys, m1zzs, m1zws,
+					m1wxs, m1wys, m1wzs, m1wws, outMxxs, outMxys, outMxzs, outMxws, outMyxs, outMyys, outMyzs, outMyws,
+					outMzxs, outMzys, outMzzs, outMzws, outMwxs, outMwys, outMwzs, outMwws);
+				return;
+			}
+		}
+
 		for (int i = 0; i < N; i++)
 		{
 			outMxxs[i] = (m0xxs[i] * m1xxs[i]) + (m0yxs[i] * m1xys[i]) + (m0zxs[i] * m1xzs[i]) + (m0wxs[i] * m1xws[i]);
@@ -760,6 +1266,27 @@ namespace
 		bool enableDepthWrite;
 	};
 
+	// One instance of a draw call, instances of the same draw call share its cache and only differ in transform.
+	struct DrawCallInstance
+	{
+		int drawCallCacheIndex;
+		SoftwareWorldMeshCache *worldMeshCache; // Null if the mesh's vertices are looked up and transformed as usual.
+		bool shouldBuildWorldMeshCache;
+	};
+
+	// Where an instance's per-instance packet data comes from, only valid while submitting.
+	struct DrawCallInstanceSource
+	{
+		const RenderDrawCall *drawCall;
+		const Matrix4d *modelMatrix;
+	};
+
+	struct DrawCallSortKey
+	{
+		double viewDepth;
+		bool isOrderIndependent;
+	};
+
 	// Transform for the mesh to be processed with.
 	struct TransformCache
 	{
@@ -856,6 +1383,7 @@ namespace
 		double uv0XDivW, uv0YDivW;
 		double uv1XDivW, uv1YDivW;
 		double uv2XDivW, uv2YDivW;
+		int workerDrawCallIndex; // For finding the draw call again when shading is deferred.
 	};
 
 	double NdcXToScreenSpace(double ndcX, double frameWidth)
@@ -893,6 +1421,28 @@ namespace
 		return (frameBufferDimension + (binDimension - 1)) / binDimension;
 	}
 
+	// Adaptive bin sizing moves away from the resolution-based dimensions in powers of two within these limits.
+	constexpr int RASTERIZER_ADAPTIVE_BIN_MIN_DIMENSION = RASTERIZER_BIN_MIN_WIDTH / 2;
+	constexpr int RASTERIZER_ADAPTIVE_BIN_MAX_DIMENSION = RASTERIZER_BIN_MAX_WIDTH;
+	static_assert(RASTERIZER_BIN_MIN_WIDTH == RASTERIZER_BIN_MIN_HEIGHT);
+	static_assert(RASTERIZER_BIN_MAX_WIDTH == RASTERIZER_BIN_MAX_HEIGHT);
+	static_assert(MathUtils::isMultipleOf(RASTERIZER_ADAPTIVE_BIN_MIN_DIMENSION, TYPICAL_LOOP_UNROLL));
+
+	int GetScaledRasterizerBinDimension(int binDimension, int binScaleLevel)
+	{
+		const int scaledBinDimension = (binScaleLevel >= 0) ? (binDimension << binScaleLevel) : (binDimension >> -binScaleLevel);
+		return std::clamp(scaledBinDimension, RASTERIZER_ADAPTIVE_BIN_MIN_DIMENSION, RASTERIZER_ADAPTIVE_BIN_MAX_DIMENSION);
+	}
+
+	// Bin scale level is how many times the resolution-based bin dimensions are doubled (or halved if negative).
+	void GetRasterizerBinDimensions(int frameBufferWidth, int frameBufferHeight, int binScaleLevel, int *outBinWidth, int *outBinHeight)
+	{
+		const int defaultBinWidth = GetRasterizerBinDimension(frameBufferWidth, RASTERIZER_TYPICAL_BINS_PER_FRAME_BUFFER_WIDTH, RASTERIZER_BIN_MIN_WIDTH, RASTERIZER_BIN_MAX_WIDTH);
+		const int defaultBinHeight = GetRasterizerBinDimension(frameBufferHeight, RASTERIZER_TYPICAL_BINS_PER_FRAME_BUFFER_HEIGHT, RASTERIZER_BIN_MIN_HEIGHT, RASTERIZER_BIN_MAX_HEIGHT);
+		*outBinWidth = GetScaledRasterizerBinDimension(defaultBinWidth, binScaleLevel);
+		*outBinHeight = GetScaledRasterizerBinDimension(defaultBinHeight, binScaleLevel);
+	}
+
 	int GetRasterizerBinIndexStart(int frameBufferPixel, int binDimension)
 	{
 		return frameBufferPixel / binDimension;
@@ -924,12 +1474,20 @@ namespace
 namespace
 {
 	static constexpr int MAX_LIGHTS_IN_FRUSTUM = 256; // Total allowed in frustum each frame, already sorted by distance to camera.
-	static constexpr int MAX_LIGHTS_PER_LIGHT_BIN = 32; // Fraction of max frustum lights for a light bin.
+	static constexpr int MAX_LIGHTS_PER_LIGHT_BIN = 64; // Fraction of max frustum lights for a light bin.
+
+	// Light bins are split into depth slices (froxels) so a fragment only visits lights whose radius reaches its depth.
+	constexpr int LIGHT_BIN_DEPTH_SLICE_COUNT = 16; // Two per doubling of depth from 1 to 256, everything farther is in the last slice.
+	constexpr double LIGHT_BIN_DEPTH_SLICE_NEAR = 1.0;
+
+	using LightBinLightMask = uint64_t; // One bit per light in a light bin.
+	static_assert((sizeof(LightBinLightMask) * 8) >= MAX_LIGHTS_PER_LIGHT_BIN);
 
 	struct LightBin
 	{
-		int lightIndices[MAX_LIGHTS_PER_LIGHT_BIN]; // Points into visible SoftwareLight list.
+		int lightIndices[MAX_LIGHTS_PER_LIGHT_BIN]; // Points into visible SoftwareLight list, same order (nearest to camera first).
 		int lightCount;
+		LightBinLightMask depthSliceLightMasks[LIGHT_BIN_DEPTH_SLICE_COUNT]; // Lights in this bin that touch each depth slice.
 	};
 
 	constexpr int LIGHT_BIN_MIN_WIDTH = 16;
@@ -977,6 +1535,20 @@ namespace
 		return frameBufferPixelY / binHeight;
 	}
 
+	// Exponential so slices near the camera are thin. Reads the half-octave from the exponent and top mantissa bit instead of calling log2().
+	int GetLightBinDepthSlice(double viewDepth)
+	{
+		if (viewDepth <= LIGHT_BIN_DEPTH_SLICE_NEAR)
+		{
+			return 0;
+		}
+
+		const uint64_t depthBits = std::bit_cast<uint64_t>(viewDepth / LIGHT_BIN_DEPTH_SLICE_NEAR);
+		const int depthExponent = static_cast<int>((depthBits >> 52) & 0x7FF) - 1023;
+		const int depthHalfOctave = static_cast<int>((depthBits >> 51) & 1);
+		return std::min((depthExponent * 2) + depthHalfOctave, LIGHT_BIN_DEPTH_SLICE_COUNT - 1);
+	}
+
 	int GetLightBinPixelXInclusive(int frameBufferPixelX, int binWidth)
 	{
 		return frameBufferPixelX % binWidth;
@@ -1003,6 +1575,10 @@ namespace
 // Frame buffer globals.
 namespace
 {
+	// How far past the frame buffer edges a triangle may reach before it's clipped to the side planes. The rasterizer
+	// clamps to the frame buffer anyway, this only bounds screen-space magnitudes for single-precision edge math.
+	constexpr double GUARD_BAND_PIXELS = 2048.0;
+
 	int g_frameBufferWidth;
 	int g_frameBufferHeight;
 	int g_frameBufferPixelCount;
@@ -1010,14 +1586,20 @@ namespace
 	double g_frameBufferHeightReal;
 	double g_frameBufferWidthRealRecip;
 	double g_frameBufferHeightRealRecip;
+	double g_guardBandNdcX, g_guardBandNdcY; // Side plane limits as a multiple of W.
 	DitheringMode g_ditheringMode;
+	RasterPrecisionMode g_rasterPrecisionMode;
+	ShadingMode g_shadingMode;
 	uint8_t *g_paletteIndexBuffer;
 	double *g_depthBuffer;
+	float *g_singlePrecisionDepthBuffer;
 	uint32_t *g_colorBuffer;
+	int32_t *g_visibilityBuffer; // Triangle ID per pixel waiting to be shaded in visibility buffer mode, -1 if none.
 	SoftwareObjectTexturePool *g_objectTextures;
 
 	void PopulateRasterizerGlobals(int frameBufferWidth, int frameBufferHeight, uint8_t *paletteIndexBuffer, double *depthBuffer,
-		DitheringMode ditheringMode, uint32_t *colorBuffer, SoftwareObjectTexturePool *objectTextures)
+		float *singlePrecisionDepthBuffer, DitheringMode ditheringMode, RasterPrecisionMode rasterPrecisionMode, ShadingMode shadingMode,
+		uint32_t *colorBuffer, int32_t *visibilityBuffer, SoftwareObjectTexturePool *objectTextures)
 	{
 		g_frameBufferWidth = frameBufferWidth;
 		g_frameBufferHeight = frameBufferHeight;
@@ -1026,23 +1608,68 @@ namespace
 		g_frameBufferHeightReal = static_cast<double>(frameBufferHeight);
 		g_frameBufferWidthRealRecip = 1.0 / g_frameBufferWidthReal;
 		g_frameBufferHeightRealRecip = 1.0 / g_frameBufferHeightReal;
+		g_guardBandNdcX = 1.0 + ((2.0 * GUARD_BAND_PIXELS) * g_frameBufferWidthRealRecip);
+		g_guardBandNdcY = 1.0 + ((2.0 * GUARD_BAND_PIXELS) * g_frameBufferHeightRealRecip);
 		g_ditheringMode = ditheringMode;
+		g_rasterPrecisionMode = rasterPrecisionMode;
+		g_shadingMode = shadingMode;
 		g_paletteIndexBuffer = paletteIndexBuffer;
 		g_depthBuffer = depthBuffer;
+		g_singlePrecisionDepthBuffer = singlePrecisionDepthBuffer;
 		g_colorBuffer = colorBuffer;
+		g_visibilityBuffer = visibilityBuffer;
 		g_objectTextures = objectTextures;
 	}
 
+	// Floating-point type of the rasterizer's coverage, barycentric, and depth math.
+	template<RasterPrecisionMode rasterPrecisionMode>
+	using RasterReal = std::conditional_t<rasterPrecisionMode == RasterPrecisionMode::Single, float, double>;
+
+	template<RasterPrecisionMode rasterPrecisionMode>
+	RasterReal<rasterPrecisionMode> *GetDepthBuffer()
+	{
+		if constexpr (rasterPrecisionMode == RasterPrecisionMode::Single)
+		{
+			return g_singlePrecisionDepthBuffer;
+		}
+		else
+		{
+			return g_depthBuffer;
+		}
+	}
+
+	// Interlaced rendering. Every other row is shaded each frame and the rest are reprojected from the last frame.
+	constexpr double INTERLACE_HISTORY_DEPTH_TOLERANCE = 0.05; // Relative view depth difference still treated as the same surface.
+
+	int g_interlaceRowParity = -1; // Rows shaded this frame have this parity, -1 if all rows are.
+	bool g_shouldFinishInterlacedBins = false; // Set for the last rasterizing phase of a frame that saves history.
+	Buffer2D<uint8_t> g_interlaceHistoryPaletteIndexBuffers[2]; // The last frame is read from one while this frame is saved to the other.
+	Buffer2D<float> g_interlaceHistoryDepthBuffers[2]; // View depth of each history pixel for rejecting disocclusions.
+	int g_interlaceHistoryReadIndex = 0;
+	bool g_isInterlaceHistoryValid = false;
+	Matrix4d g_interlaceHistoryViewProjMatrix;
+	Matrix4d g_interlaceReprojectionMatrix; // This frame's NDC space to the history frame's clip space.
+
 	// For measuring overdraw.
 	std::atomic<int64_t> g_totalCoverageTests = 0;
+	std::atomic<int64_t> g_totalCoverageBlockAccepts = 0;
 	std::atomic<int64_t> g_totalDepthTests = 0;
 	std::atomic<int64_t> g_totalColorWrites = 0;
+	std::atomic<int64_t> g_totalShadedFragments = 0;
+	std::atomic<int64_t> g_totalMipmappedFragments = 0;
+	std::atomic<int64_t> g_totalLitFragments = 0;
+	std::atomic<int64_t> g_totalFragmentLightTests = 0;
 
 	void ClearFrameBufferOperationCounts()
 	{
 		g_totalCoverageTests = 0;
+		g_totalCoverageBlockAccepts = 0;
 		g_totalDepthTests = 0;
 		g_totalColorWrites = 0;
+		g_totalShadedFragments = 0;
+		g_totalMipmappedFragments = 0;
+		g_totalLitFragments = 0;
+		g_totalFragmentLightTests = 0;
 	}
 }
 
@@ -1161,6 +1788,8 @@ namespace
 	struct FragmentShaderTexture
 	{
 		const uint8_t *texels;
+		const uint8_t *tiledTexels; // For perspective-correct sampling if tiled texels are enabled, otherwise null.
+		int tileCountX;
 		int width, height;
 		int widthMinusOne, heightMinusOne;
 		double widthReal, heightReal;
@@ -1168,6 +1797,8 @@ namespace
 		FragmentShaderTexture()
 		{
 			this->texels = nullptr;
+			this->tiledTexels = nullptr;
+			this->tileCountX = 0;
 			this->width = 0;
 			this->height = 0;
 			this->widthMinusOne = 0;
@@ -1179,6 +1810,8 @@ namespace
 		void init(const uint8_t *texels, int width, int height)
 		{
 			this->texels = texels;
+			this->tiledTexels = nullptr;
+			this->tileCountX = 0;
 			this->width = width;
 			this->height = height;
 			this->widthMinusOne = width - 1;
@@ -1186,6 +1819,19 @@ namespace
 			this->widthReal = static_cast<double>(width);
 			this->heightReal = static_cast<double>(height);
 		}
+
+		void initMipLevel(const SoftwareObjectTexture &texture, int mipLevel, bool isTiled)
+		{
+			DebugAssert(mipLevel >= 0);
+			DebugAssert(mipLevel < texture.mipLevelCount);
+			this->init(texture.mipLevelTexels[mipLevel], texture.mipLevelWidths[mipLevel], texture.mipLevelHeights[mipLevel]);
+
+			if (isTiled)
+			{
+				this->tiledTexels = texture.mipLevelTiledTexels[mipLevel];
+				this->tileCountX = texture.mipLevelTileCountXs[mipLevel];
+			}
+		}
 	};
 
 	struct FragmentShaderPalette
@@ -1250,35 +1896,43 @@ namespace
 
 	double g_ambientPercent;
 	double g_screenSpaceAnimPercent;
+	bool g_enableMipmaps;
+	bool g_enableTiledTexels;
 	Double2 g_horizonScreenSpacePoint; // For puddle reflections.
 	const SoftwareObjectTexture *g_paletteTexture; // 8-bit -> 32-bit color conversion palette.
 	const SoftwareObjectTexture *g_lightTableTexture; // Shading/transparency look-ups.
 	const SoftwareObjectTexture *g_ditherTexture; // Screen-space dithering for lighting.
 	const SoftwareObjectTexture *g_skyBgTexture; // Fallback sky texture for horizon reflection shader.
 
-	void PopulateVisibleLights(const SoftwareUniformBuffer &visibleLightsBuffer, int visibleLightCount)
+	// Reads visible lights from the uniform buffer and caches values to reduce shading work.
+	void ReadVisibleLights(const SoftwareUniformBuffer &visibleLightsBuffer, int visibleLightCount, std::vector<SoftwareLight> &outLights)
 	{
-		std::fill(std::begin(g_visibleLights), std::end(g_visibleLights), SoftwareLight());
-		g_visibleLightCount = std::min(visibleLightCount, MAX_LIGHTS_IN_FRUSTUM);
+		outLights.resize(std::min(visibleLightCount, MAX_LIGHTS_IN_FRUSTUM));
 
-		// Read visible lights from uniform buffer and cache values to reduce shading work.
 		const std::byte *visibleLightsBytes = visibleLightsBuffer.begin();
-		for (int i = 0; i < g_visibleLightCount; i++)
+		for (int i = 0; i < static_cast<int>(outLights.size()); i++)
 		{
 			const double *currentVisibleLightValues = reinterpret_cast<const double*>(visibleLightsBytes + (visibleLightsBuffer.bytesPerElement * i));
 			const Double3 currentVisibleLightPosition(currentVisibleLightValues[0], currentVisibleLightValues[1], currentVisibleLightValues[2]);
 			const double currentVisibleLightStartRadius = currentVisibleLightValues[3];
 			const double currentVisibleLightEndRadius = currentVisibleLightValues[4];
 
-			SoftwareLight &optimizedVisibleLight = g_visibleLights[i];
+			SoftwareLight &optimizedVisibleLight = outLights[i];
 			optimizedVisibleLight.init(currentVisibleLightPosition, currentVisibleLightStartRadius, currentVisibleLightEndRadius);
 		}
 	}
 
-	void InitLightBins(int frameBufferWidth, int frameBufferHeight)
+	void PopulateVisibleLights(const std::vector<SoftwareLight> &visibleLights)
 	{
-		const int lightBinWidth = GetLightBinWidth(frameBufferWidth);
-		const int lightBinHeight = GetLightBinHeight(frameBufferHeight);
+		std::fill(std::begin(g_visibleLights), std::end(g_visibleLights), SoftwareLight());
+		g_visibleLightCount = static_cast<int>(visibleLights.size());
+		std::copy(visibleLights.begin(), visibleLights.end(), std::begin(g_visibleLights));
+	}
+
+	void InitLightBins(int frameBufferWidth, int frameBufferHeight)
+	{
+		const int lightBinWidth = GetLightBinWidth(frameBufferWidth);
+		const int lightBinHeight = GetLightBinHeight(frameBufferHeight);
 		const int lightBinCountX = GetLightBinCountX(frameBufferWidth, lightBinWidth);
 		const int lightBinCountY = GetLightBinCountY(frameBufferHeight, lightBinHeight);
 		if ((g_lightBins.getWidth() != lightBinCountX) || (g_lightBins.getHeight() != lightBinCountY))
@@ -1307,6 +1961,7 @@ namespace
 
 		LightBin &lightBin = g_lightBins.get(binX, binY);
 		lightBin.lightCount = 0;
+		std::fill(std::begin(lightBin.depthSliceLightMasks), std::end(lightBin.depthSliceLightMasks), 0);
 
 		Double3 frustumDirLeft, frustumDirRight, frustumDirBottom, frustumDirTop;
 		Double3 frustumNormalLeft, frustumNormalRight, frustumNormalBottom, frustumNormalTop;
@@ -1336,23 +1991,66 @@ namespace
 				continue;
 			}
 
+			// The bin's side planes already passed, so the light's sphere only needs testing against each froxel's near and far depths.
+			const double lightViewDepth = ((lightPosition.x - camera.floatingWorldPoint.x) * camera.forward.x) +
+				((lightPosition.y - camera.floatingWorldPoint.y) * camera.forward.y) + ((lightPosition.z - camera.floatingWorldPoint.z) * camera.forward.z);
+			const int lightDepthSliceStart = GetLightBinDepthSlice(lightViewDepth - light.endRadius);
+			const int lightDepthSliceEnd = GetLightBinDepthSlice(lightViewDepth + light.endRadius);
+			const LightBinLightMask lightBit = static_cast<LightBinLightMask>(1) << lightBin.lightCount;
+			for (int depthSlice = lightDepthSliceStart; depthSlice <= lightDepthSliceEnd; depthSlice++)
+			{
+				lightBin.depthSliceLightMasks[depthSlice] |= lightBit;
+			}
+
 			lightBin.lightIndices[lightBin.lightCount] = visibleLightIndex;
 			lightBin.lightCount++;
 		}
 	}
 
-	void PopulateFragmentShaderGlobals(double ambientPercent, double screenSpaceAnimPercent, const Double3 &horizonNdcPoint,
+	void PopulateFragmentShaderGlobals(double ambientPercent, double screenSpaceAnimPercent, bool enableMipmaps, bool enableTiledTexels, const Double3 &horizonNdcPoint,
 		const SoftwareObjectTexture &paletteTexture, const SoftwareObjectTexture &lightTableTexture, const SoftwareObjectTexture &ditherTexture,
 		const SoftwareObjectTexture &skyBgTexture)
 	{
 		g_ambientPercent = ambientPercent;
 		g_screenSpaceAnimPercent = screenSpaceAnimPercent;
+		g_enableMipmaps = enableMipmaps;
+		g_enableTiledTexels = enableTiledTexels;
 		g_horizonScreenSpacePoint = RendererUtils::ndcToScreenSpace(horizonNdcPoint, g_frameBufferWidthReal, g_frameBufferHeightReal);
 		g_paletteTexture = &paletteTexture;
 		g_lightTableTexture = &lightTableTexture;
 		g_ditherTexture = &ditherTexture;
 		g_skyBgTexture = &skyBgTexture;
 	}
+
+	// Picks the mip level closest to one texel per pixel, averaged over the whole triangle so it's constant while rasterizing.
+	int GetTriangleMipLevel(const RasterizerTriangle &triangle, const SoftwareObjectTexture &texture)
+	{
+		if (!g_enableMipmaps || (texture.mipLevelCount <= 1))
+		{
+			return 0;
+		}
+
+		const double screenSpaceArea = std::abs((triangle.screenSpace01X * triangle.screenSpace20Y) - (triangle.screenSpace01Y * triangle.screenSpace20X));
+		if (screenSpaceArea <= 0.0)
+		{
+			return 0;
+		}
+
+		const double uv01X = triangle.uv1X - triangle.uv0X;
+		const double uv01Y = triangle.uv1Y - triangle.uv0Y;
+		const double uv02X = triangle.uv2X - triangle.uv0X;
+		const double uv02Y = triangle.uv2Y - triangle.uv0Y;
+		const double texelArea = std::abs((uv01X * uv02Y) - (uv01Y * uv02X)) * texture.widthReal * texture.heightReal;
+		const double texelsPerPixel = texelArea / screenSpaceArea;
+		if (texelsPerPixel < 4.0)
+		{
+			return 0;
+		}
+
+		// Each level has a quarter of the texels.
+		const int mipLevel = static_cast<int>(0.50 * std::log2(texelsPerPixel));
+		return std::min(mipLevel, texture.mipLevelCount - 1);
+	}
 }
 
 // Mesh processing, vertex shader execution.
@@ -1385,6 +2083,26 @@ namespace
 		double uv1Ys[MAX_VERTEX_SHADING_CACHE_TRIANGLES];
 		double uv2Xs[MAX_VERTEX_SHADING_CACHE_TRIANGLES];
 		double uv2Ys[MAX_VERTEX_SHADING_CACHE_TRIANGLES];
+
+		// What the vertex shader reads, either the arrays above or a world mesh cache's arrays.
+		const double *meshV0Xs;
+		const double *meshV0Ys;
+		const double *meshV0Zs;
+		const double *meshV0Ws;
+		const double *meshV1Xs;
+		const double *meshV1Ys;
+		const double *meshV1Zs;
+		const double *meshV1Ws;
+		const double *meshV2Xs;
+		const double *meshV2Ys;
+		const double *meshV2Zs;
+		const double *meshV2Ws;
+		const double *meshUV0Xs;
+		const double *meshUV0Ys;
+		const double *meshUV1Xs;
+		const double *meshUV1Ys;
+		const double *meshUV2Xs;
+		const double *meshUV2Ys;
 		int triangleCount;
 	};
 
@@ -1479,9 +2197,121 @@ namespace
 			writeIndex++;
 		}
 
+		vertexShaderInputCache.meshV0Xs = vertexShaderInputCache.unshadedV0Xs;
+		vertexShaderInputCache.meshV0Ys = vertexShaderInputCache.unshadedV0Ys;
+		vertexShaderInputCache.meshV0Zs = vertexShaderInputCache.unshadedV0Zs;
+		vertexShaderInputCache.meshV0Ws = vertexShaderInputCache.unshadedV0Ws;
+		vertexShaderInputCache.meshV1Xs = vertexShaderInputCache.unshadedV1Xs;
+		vertexShaderInputCache.meshV1Ys = vertexShaderInputCache.unshadedV1Ys;
+		vertexShaderInputCache.meshV1Zs = vertexShaderInputCache.unshadedV1Zs;
+		vertexShaderInputCache.meshV1Ws = vertexShaderInputCache.unshadedV1Ws;
+		vertexShaderInputCache.meshV2Xs = vertexShaderInputCache.unshadedV2Xs;
+		vertexShaderInputCache.meshV2Ys = vertexShaderInputCache.unshadedV2Ys;
+		vertexShaderInputCache.meshV2Zs = vertexShaderInputCache.unshadedV2Zs;
+		vertexShaderInputCache.meshV2Ws = vertexShaderInputCache.unshadedV2Ws;
+		vertexShaderInputCache.meshUV0Xs = vertexShaderInputCache.uv0Xs;
+		vertexShaderInputCache.meshUV0Ys = vertexShaderInputCache.uv0Ys;
+		vertexShaderInputCache.meshUV1Xs = vertexShaderInputCache.uv1Xs;
+		vertexShaderInputCache.meshUV1Ys = vertexShaderInputCache.uv1Ys;
+		vertexShaderInputCache.meshUV2Xs = vertexShaderInputCache.uv2Xs;
+		vertexShaderInputCache.meshUV2Ys = vertexShaderInputCache.uv2Ys;
 		vertexShaderInputCache.triangleCount = meshTriangleCount;
 	}
 
+	// Shared by mesh buffers and textures so a freed and recreated buffer ID never matches a stale world mesh cache key,
+	// and so a frame's highest resource version only stays the same if nothing it reads was written to.
+	uint32_t g_nextResourceVersion = 1;
+
+	// Component arrays of SoftwareWorldMeshCache::values in order.
+	enum class WorldMeshCacheArray
+	{
+		V0X, V0Y, V0Z, V0W,
+		V1X, V1Y, V1Z, V1W,
+		V2X, V2Y, V2Z, V2W,
+		UV0X, UV0Y,
+		UV1X, UV1Y,
+		UV2X, UV2Y,
+		Count
+	};
+
+	double *GetWorldMeshCacheArray(SoftwareWorldMeshCache &worldMeshCache, WorldMeshCacheArray array)
+	{
+		return worldMeshCache.values.begin() + (static_cast<int>(array) * worldMeshCache.triangleCount);
+	}
+
+	// Does the mesh buffer lookups and model matrix transform once, the results are reused until the cache key changes.
+	void BuildWorldMeshCache(const DrawCallCache &drawCallCache, const TransformCache &transformCache, SoftwareWorldMeshCache &worldMeshCache)
+	{
+		const double *positionsPtr = drawCallCache.positionBuffer->positions.begin();
+		const double *texCoordsPtr = drawCallCache.texCoordBuffer->attributes.begin();
+		const SoftwareIndexBuffer &indexBuffer = *drawCallCache.indexBuffer;
+		const int32_t *indicesPtr = indexBuffer.indices.begin();
+		const int meshTriangleCount = indexBuffer.triangleCount;
+		DebugAssert(meshTriangleCount <= MAX_DRAW_CALL_MESH_TRIANGLES);
+
+		const int valueCount = meshTriangleCount * static_cast<int>(WorldMeshCacheArray::Count);
+		if (worldMeshCache.values.getCount() != valueCount)
+		{
+			worldMeshCache.values.init(valueCount);
+		}
+
+		worldMeshCache.triangleCount = meshTriangleCount;
+
+		double *vertexXs[3] = { GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::V0X), GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::V1X), GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::V2X) };
+		double *vertexYs[3] = { GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::V0Y), GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::V1Y), GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::V2Y) };
+		double *vertexZs[3] = { GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::V0Z), GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::V1Z), GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::V2Z) };
+		double *vertexWs[3] = { GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::V0W), GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::V1W), GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::V2W) };
+		double *uvXs[3] = { GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::UV0X), GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::UV1X), GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::UV2X) };
+		double *uvYs[3] = { GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::UV0Y), GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::UV1Y), GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::UV2Y) };
+
+		for (int triangleIndex = 0; triangleIndex < meshTriangleCount; triangleIndex++)
+		{
+			constexpr int indicesPerTriangle = 3;
+			constexpr int positionComponentsPerVertex = 3;
+			constexpr int texCoordComponentsPerVertex = 2;
+
+			for (int triangleVertexIndex = 0; triangleVertexIndex < indicesPerTriangle; triangleVertexIndex++)
+			{
+				const int32_t index = indicesPtr[(triangleIndex * indicesPerTriangle) + triangleVertexIndex];
+				const double *position = positionsPtr + (index * positionComponentsPerVertex);
+				const double *texCoord = texCoordsPtr + (index * texCoordComponentsPerVertex);
+				const double x = position[0];
+				const double y = position[1];
+				const double z = position[2];
+				vertexXs[triangleVertexIndex][triangleIndex] = (transformCache.modelMatrixXX * x) + (transformCache.modelMatrixYX * y) + (transformCache.modelMatrixZX * z) + transformCache.modelMatrixWX;
+				vertexYs[triangleVertexIndex][triangleIndex] = (transformCache.modelMatrixXY * x) + (transformCache.modelMatrixYY * y) + (transformCache.modelMatrixZY * z) + transformCache.modelMatrixWY;
+				vertexZs[triangleVertexIndex][triangleIndex] = (transformCache.modelMatrixXZ * x) + (transformCache.modelMatrixYZ * y) + (transformCache.modelMatrixZZ * z) + transformCache.modelMatrixWZ;
+				vertexWs[triangleVertexIndex][triangleIndex] = (transformCache.modelMatrixXW * x) + (transformCache.modelMatrixYW * y) + (transformCache.modelMatrixZW * z) + transformCache.modelMatrixWW;
+				uvXs[triangleVertexIndex][triangleIndex] = texCoord[0];
+				uvYs[triangleVertexIndex][triangleIndex] = texCoord[1];
+			}
+		}
+	}
+
+	// Points the vertex shader at world space triangles so the view-projection matrix is the only transform left.
+	void ProcessWorldMeshCacheLookups(SoftwareWorldMeshCache &worldMeshCache, VertexShaderInputCache &vertexShaderInputCache)
+	{
+		vertexShaderInputCache.meshV0Xs = GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::V0X);
+		vertexShaderInputCache.meshV0Ys = GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::V0Y);
+		vertexShaderInputCache.meshV0Zs = GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::V0Z);
+		vertexShaderInputCache.meshV0Ws = GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::V0W);
+		vertexShaderInputCache.meshV1Xs = GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::V1X);
+		vertexShaderInputCache.meshV1Ys = GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::V1Y);
+		vertexShaderInputCache.meshV1Zs = GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::V1Z);
+		vertexShaderInputCache.meshV1Ws = GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::V1W);
+		vertexShaderInputCache.meshV2Xs = GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::V2X);
+		vertexShaderInputCache.meshV2Ys = GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::V2Y);
+		vertexShaderInputCache.meshV2Zs = GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::V2Z);
+		vertexShaderInputCache.meshV2Ws = GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::V2W);
+		vertexShaderInputCache.meshUV0Xs = GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::UV0X);
+		vertexShaderInputCache.meshUV0Ys = GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::UV0Y);
+		vertexShaderInputCache.meshUV1Xs = GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::UV1X);
+		vertexShaderInputCache.meshUV1Ys = GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::UV1Y);
+		vertexShaderInputCache.meshUV2Xs = GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::UV2X);
+		vertexShaderInputCache.meshUV2Ys = GetWorldMeshCacheArray(worldMeshCache, WorldMeshCacheArray::UV2Y);
+		vertexShaderInputCache.triangleCount = worldMeshCache.triangleCount;
+	}
+
 	void CalculateVertexShaderTransforms(TransformCache &transformCache)
 	{
 		Matrix4_MultiplyMatrixN<1>(
@@ -1499,6 +2329,104 @@ namespace
 			&transformCache.modelViewProjMatrixWX, &transformCache.modelViewProjMatrixWY, &transformCache.modelViewProjMatrixWZ, &transformCache.modelViewProjMatrixWW);
 	}
 
+	// Vertices are already in world space, the model matrix is identity.
+	void CalculateWorldMeshVertexShaderTransforms(TransformCache &transformCache)
+	{
+		transformCache.modelViewProjMatrixXX = g_viewProjMatrix.x.x;
+		transformCache.modelViewProjMatrixXY = g_viewProjMatrix.x.y;
+		transformCache.modelViewProjMatrixXZ = g_viewProjMatrix.x.z;
+		transformCache.modelViewProjMatrixXW = g_viewProjMatrix.x.w;
+		transformCache.modelViewProjMatrixYX = g_viewProjMatrix.y.x;
+		transformCache.modelViewProjMatrixYY = g_viewProjMatrix.y.y;
+		transformCache.modelViewProjMatrixYZ = g_viewProjMatrix.y.z;
+		transformCache.modelViewProjMatrixYW = g_viewProjMatrix.y.w;
+		transformCache.modelViewProjMatrixZX = g_viewProjMatrix.z.x;
+		transformCache.modelViewProjMatrixZY = g_viewProjMatrix.z.y;
+		transformCache.modelViewProjMatrixZZ = g_viewProjMatrix.z.z;
+		transformCache.modelViewProjMatrixZW = g_viewProjMatrix.z.w;
+		transformCache.modelViewProjMatrixWX = g_viewProjMatrix.w.x;
+		transformCache.modelViewProjMatrixWY = g_viewProjMatrix.w.y;
+		transformCache.modelViewProjMatrixWZ = g_viewProjMatrix.w.z;
+		transformCache.modelViewProjMatrixWW = g_viewProjMatrix.w.w;
+	}
+
+	// Shades N consecutive triangles starting at the given index and appends them to the output cache.
+	template<VertexShaderType vertexShaderType, int N>
+	void ProcessVertexShadersN(const TransformCache &transformCache, const VertexShaderInputCache &vertexShaderInputCache, int triangleIndex,
+		VertexShaderOutputCache &vertexShaderOutputCache)
+	{
+		const double *unshadedV0Xs = vertexShaderInputCache.meshV0Xs + triangleIndex;
+		const double *unshadedV0Ys = vertexShaderInputCache.meshV0Ys + triangleIndex;
+		const double *unshadedV0Zs = vertexShaderInputCache.meshV0Zs + triangleIndex;
+		const double *unshadedV0Ws = vertexShaderInputCache.meshV0Ws + triangleIndex;
+		const double *unshadedV1Xs = vertexShaderInputCache.meshV1Xs + triangleIndex;
+		const double *unshadedV1Ys = vertexShaderInputCache.meshV1Ys + triangleIndex;
+		const double *unshadedV1Zs = vertexShaderInputCache.meshV1Zs + triangleIndex;
+		const double *unshadedV1Ws = vertexShaderInputCache.meshV1Ws + triangleIndex;
+		const double *unshadedV2Xs = vertexShaderInputCache.meshV2Xs + triangleIndex;
+		const double *unshadedV2Ys = vertexShaderInputCache.meshV2Ys + triangleIndex;
+		const double *unshadedV2Zs = vertexShaderInputCache.meshV2Zs + triangleIndex;
+		const double *unshadedV2Ws = vertexShaderInputCache.meshV2Ws + triangleIndex;
+		double shadedV0Xs[N] = { 0.0 };
+		double shadedV0Ys[N] = { 0.0 };
+		double shadedV0Zs[N] = { 0.0 };
+		double shadedV0Ws[N] = { 0.0 };
+		double shadedV1Xs[N] = { 0.0 };
+		double shadedV1Ys[N] = { 0.0 };
+		double shadedV1Zs[N] = { 0.0 };
+		double shadedV1Ws[N] = { 0.0 };
+		double shadedV2Xs[N] = { 0.0 };
+		double shadedV2Ys[N] = { 0.0 };
+		double shadedV2Zs[N] = { 0.0 };
+		double shadedV2Ws[N] = { 0.0 };
+
+		if constexpr (vertexShaderType == VertexShaderType::Basic)
+		{
+			VertexShader_BasicN<N>(transformCache, unshadedV0Xs, unshadedV0Ys, unshadedV0Zs, unshadedV0Ws, shadedV0Xs, shadedV0Ys, shadedV0Zs, shadedV0Ws);
+			VertexShader_BasicN<N>(transformCache, unshadedV1Xs, unshadedV1Ys, unshadedV1Zs, unshadedV1Ws, shadedV1Xs, shadedV1Ys, shadedV1Zs, shadedV1Ws);
+			VertexShader_BasicN<N>(transformCache, unshadedV2Xs, unshadedV2Ys, unshadedV2Zs, unshadedV2Ws, shadedV2Xs, shadedV2Ys, shadedV2Zs, shadedV2Ws);
+		}
+		else if (vertexShaderType == VertexShaderType::Entity)
+		{
+			VertexShader_EntityN<N>(transformCache, unshadedV0Xs, unshadedV0Ys, unshadedV0Zs, unshadedV0Ws, shadedV0Xs, shadedV0Ys, shadedV0Zs, shadedV0Ws);
+			VertexShader_EntityN<N>(transformCache, unshadedV1Xs, unshadedV1Ys, unshadedV1Zs, unshadedV1Ws, shadedV1Xs, shadedV1Ys, shadedV1Zs, shadedV1Ws);
+			VertexShader_EntityN<N>(transformCache, unshadedV2Xs, unshadedV2Ys, unshadedV2Zs, unshadedV2Ws, shadedV2Xs, shadedV2Ys, shadedV2Zs, shadedV2Ws);
+		}
+
+		int &writeIndex = vertexShaderOutputCache.triangleWriteCount;
+		DebugAssert((writeIndex + N) <= MAX_DRAW_CALL_MESH_TRIANGLES);
+
+		for (int i = 0; i < N; i++)
+		{
+			auto &resultV0XYZW = vertexShaderOutputCache.shadedV0XYZWArray[writeIndex + i];
+			auto &resultV1XYZW = vertexShaderOutputCache.shadedV1XYZWArray[writeIndex + i];
+			auto &resultV2XYZW = vertexShaderOutputCache.shadedV2XYZWArray[writeIndex + i];
+			auto &resultUV0XY = vertexShaderOutputCache.uv0XYArray[writeIndex + i];
+			auto &resultUV1XY = vertexShaderOutputCache.uv1XYArray[writeIndex + i];
+			auto &resultUV2XY = vertexShaderOutputCache.uv2XYArray[writeIndex + i];
+			resultV0XYZW[0] = shadedV0Xs[i];
+			resultV0XYZW[1] = shadedV0Ys[i];
+			resultV0XYZW[2] = shadedV0Zs[i];
+			resultV0XYZW[3] = shadedV0Ws[i];
+			resultV1XYZW[0] = shadedV1Xs[i];
+			resultV1XYZW[1] = shadedV1Ys[i];
+			resultV1XYZW[2] = shadedV1Zs[i];
+			resultV1XYZW[3] = shadedV1Ws[i];
+			resultV2XYZW[0] = shadedV2Xs[i];
+			resultV2XYZW[1] = shadedV2Ys[i];
+			resultV2XYZW[2] = shadedV2Zs[i];
+			resultV2XYZW[3] = shadedV2Ws[i];
+			resultUV0XY[0] = vertexShaderInputCache.meshUV0Xs[triangleIndex + i];
+			resultUV0XY[1] = vertexShaderInputCache.meshUV0Ys[triangleIndex + i];
+			resultUV1XY[0] = vertexShaderInputCache.meshUV1Xs[triangleIndex + i];
+			resultUV1XY[1] = vertexShaderInputCache.meshUV1Ys[triangleIndex + i];
+			resultUV2XY[0] = vertexShaderInputCache.meshUV2Xs[triangleIndex + i];
+			resultUV2XY[1] = vertexShaderInputCache.meshUV2Ys[triangleIndex + i];
+		}
+
+		writeIndex += N;
+	}
+
 	// Converts the mesh's world space vertices to clip space.
 	template<VertexShaderType vertexShaderType>
 	void ProcessVertexShadersInternal(const TransformCache &transformCache, const VertexShaderInputCache &vertexShaderInputCache,
@@ -1506,77 +2434,19 @@ namespace
 	{
 		vertexShaderOutputCache.triangleWriteCount = 0;
 
-		// Run vertex shaders on each triangle and store the results for clipping.
+		// Run vertex shaders on groups of triangles so the matrix math fills SIMD lanes, then finish the remainder one at a time.
 		const int triangleCount = vertexShaderInputCache.triangleCount;
+		const int unrollAdjustedTriangleCount = GetUnrollAdjustedLoopCount(triangleCount, TYPICAL_LOOP_UNROLL);
 		int triangleIndex = 0;
-		while (triangleIndex < triangleCount)
+		while (triangleIndex < unrollAdjustedTriangleCount)
 		{
-			const double unshadedV0Xs[1] = { vertexShaderInputCache.unshadedV0Xs[triangleIndex] };
-			const double unshadedV0Ys[1] = { vertexShaderInputCache.unshadedV0Ys[triangleIndex] };
-			const double unshadedV0Zs[1] = { vertexShaderInputCache.unshadedV0Zs[triangleIndex] };
-			const double unshadedV0Ws[1] = { vertexShaderInputCache.unshadedV0Ws[triangleIndex] };
-			const double unshadedV1Xs[1] = { vertexShaderInputCache.unshadedV1Xs[triangleIndex] };
-			const double unshadedV1Ys[1] = { vertexShaderInputCache.unshadedV1Ys[triangleIndex] };
-			const double unshadedV1Zs[1] = { vertexShaderInputCache.unshadedV1Zs[triangleIndex] };
-			const double unshadedV1Ws[1] = { vertexShaderInputCache.unshadedV1Ws[triangleIndex] };
-			const double unshadedV2Xs[1] = { vertexShaderInputCache.unshadedV2Xs[triangleIndex] };
-			const double unshadedV2Ys[1] = { vertexShaderInputCache.unshadedV2Ys[triangleIndex] };
-			const double unshadedV2Zs[1] = { vertexShaderInputCache.unshadedV2Zs[triangleIndex] };
-			const double unshadedV2Ws[1] = { vertexShaderInputCache.unshadedV2Ws[triangleIndex] };
-			double shadedV0Xs[1] = { 0.0 };
-			double shadedV0Ys[1] = { 0.0 };
-			double shadedV0Zs[1] = { 0.0 };
-			double shadedV0Ws[1] = { 0.0 };
-			double shadedV1Xs[1] = { 0.0 };
-			double shadedV1Ys[1] = { 0.0 };
-			double shadedV1Zs[1] = { 0.0 };
-			double shadedV1Ws[1] = { 0.0 };
-			double shadedV2Xs[1] = { 0.0 };
-			double shadedV2Ys[1] = { 0.0 };
-			double shadedV2Zs[1] = { 0.0 };
-			double shadedV2Ws[1] = { 0.0 };
-
-			if constexpr (vertexShaderType == VertexShaderType::Basic)
-			{
-				VertexShader_BasicN<1>(transformCache, unshadedV0Xs, unshadedV0Ys, unshadedV0Zs, unshadedV0Ws, shadedV0Xs, shadedV0Ys, shadedV0Zs, shadedV0Ws);
-				VertexShader_BasicN<1>(transformCache, unshadedV1Xs, unshadedV1Ys, unshadedV1Zs, unshadedV1Ws, shadedV1Xs, shadedV1Ys, shadedV1Zs, shadedV1Ws);
-				VertexShader_BasicN<1>(transformCache, unshadedV2Xs, unshadedV2Ys, unshadedV2Zs, unshadedV2Ws, shadedV2Xs, shadedV2Ys, shadedV2Zs, shadedV2Ws);
-			}
-			else if (vertexShaderType == VertexShaderType::Entity)
-			{
-				VertexShader_EntityN<1>(transformCache, unshadedV0Xs, unshadedV0Ys, unshadedV0Zs, unshadedV0Ws, shadedV0Xs, shadedV0Ys, shadedV0Zs, shadedV0Ws);
-				VertexShader_EntityN<1>(transformCache, unshadedV1Xs, unshadedV1Ys, unshadedV1Zs, unshadedV1Ws, shadedV1Xs, shadedV1Ys, shadedV1Zs, shadedV1Ws);
-				VertexShader_EntityN<1>(transformCache, unshadedV2Xs, unshadedV2Ys, unshadedV2Zs, unshadedV2Ws, shadedV2Xs, shadedV2Ys, shadedV2Zs, shadedV2Ws);
-			}
+			ProcessVertexShadersN<vertexShaderType, TYPICAL_LOOP_UNROLL>(transformCache, vertexShaderInputCache, triangleIndex, vertexShaderOutputCache);
+			triangleIndex += TYPICAL_LOOP_UNROLL;
+		}
 
-			int &writeIndex = vertexShaderOutputCache.triangleWriteCount;
-			DebugAssert(writeIndex < MAX_DRAW_CALL_MESH_TRIANGLES);
-
-			auto &resultV0XYZW = vertexShaderOutputCache.shadedV0XYZWArray[writeIndex];
-			auto &resultV1XYZW = vertexShaderOutputCache.shadedV1XYZWArray[writeIndex];
-			auto &resultV2XYZW = vertexShaderOutputCache.shadedV2XYZWArray[writeIndex];
-			auto &resultUV0XY = vertexShaderOutputCache.uv0XYArray[writeIndex];
-			auto &resultUV1XY = vertexShaderOutputCache.uv1XYArray[writeIndex];
-			auto &resultUV2XY = vertexShaderOutputCache.uv2XYArray[writeIndex];
-			resultV0XYZW[0] = shadedV0Xs[0];
-			resultV0XYZW[1] = shadedV0Ys[0];
-			resultV0XYZW[2] = shadedV0Zs[0];
-			resultV0XYZW[3] = shadedV0Ws[0];
-			resultV1XYZW[0] = shadedV1Xs[0];
-			resultV1XYZW[1] = shadedV1Ys[0];
-			resultV1XYZW[2] = shadedV1Zs[0];
-			resultV1XYZW[3] = shadedV1Ws[0];
-			resultV2XYZW[0] = shadedV2Xs[0];
-			resultV2XYZW[1] = shadedV2Ys[0];
-			resultV2XYZW[2] = shadedV2Zs[0];
-			resultV2XYZW[3] = shadedV2Ws[0];
-			resultUV0XY[0] = vertexShaderInputCache.uv0Xs[triangleIndex];
-			resultUV0XY[1] = vertexShaderInputCache.uv0Ys[triangleIndex];
-			resultUV1XY[0] = vertexShaderInputCache.uv1Xs[triangleIndex];
-			resultUV1XY[1] = vertexShaderInputCache.uv1Ys[triangleIndex];
-			resultUV2XY[0] = vertexShaderInputCache.uv2Xs[triangleIndex];
-			resultUV2XY[1] = vertexShaderInputCache.uv2Ys[triangleIndex];
-			writeIndex++;
+		while (triangleIndex < triangleCount)
+		{
+			ProcessVertexShadersN<vertexShaderType, 1>(transformCache, vertexShaderInputCache, triangleIndex, vertexShaderOutputCache);
 			triangleIndex++;
 		}
 	}
@@ -1601,6 +2471,50 @@ namespace
 		}
 	}
 
+	// Bitmask of the clip planes this vertex is outside of, using the same inside tests as ProcessClippingWithPlane().
+	int GetClipOutcode(const double *__restrict xyzw)
+	{
+		const double w = xyzw[3];
+		int outcode = 0;
+		outcode |= !((xyzw[0] + w) >= 0.0) ? (1 << 0) : 0;
+		outcode |= !((xyzw[1] + w) >= 0.0) ? (1 << 1) : 0;
+		outcode |= !((xyzw[2] + w) >= 0.0) ? (1 << 2) : 0;
+		outcode |= !((xyzw[0] - w) <= 0.0) ? (1 << 3) : 0;
+		outcode |= !((xyzw[1] - w) <= 0.0) ? (1 << 4) : 0;
+		outcode |= !((xyzw[2] - w) <= 0.0) ? (1 << 5) : 0;
+		return outcode;
+	}
+
+	// Same bit layout as GetClipOutcode() but the side planes are pushed out to the guard band.
+	int GetGuardBandClipOutcode(const double *__restrict xyzw)
+	{
+		const double w = xyzw[3];
+		const double guardBandWX = w * g_guardBandNdcX;
+		const double guardBandWY = w * g_guardBandNdcY;
+		int outcode = 0;
+		outcode |= !((xyzw[0] + guardBandWX) >= 0.0) ? (1 << 0) : 0;
+		outcode |= !((xyzw[1] + guardBandWY) >= 0.0) ? (1 << 1) : 0;
+		outcode |= !((xyzw[2] + w) >= 0.0) ? (1 << 2) : 0;
+		outcode |= !((xyzw[0] - guardBandWX) <= 0.0) ? (1 << 3) : 0;
+		outcode |= !((xyzw[1] - guardBandWY) <= 0.0) ? (1 << 4) : 0;
+		outcode |= !((xyzw[2] - w) <= 0.0) ? (1 << 5) : 0;
+		return outcode;
+	}
+
+	void GetTriangleClipOutcodes(const double *__restrict v0XYZW, const double *__restrict v1XYZW, const double *__restrict v2XYZW,
+		int *__restrict outOutcodes)
+	{
+		if (g_simdKernels.triangleClipOutcodes != nullptr)
+		{
+			g_simdKernels.triangleClipOutcodes(v0XYZW, v1XYZW, v2XYZW, outOutcodes);
+			return;
+		}
+
+		outOutcodes[0] = GetClipOutcode(v0XYZW);
+		outOutcodes[1] = GetClipOutcode(v1XYZW);
+		outOutcodes[2] = GetClipOutcode(v2XYZW);
+	}
+
 	template<int clipPlaneIndex>
 	void ProcessClippingWithPlane(ClippingOutputCache &clippingOutputCache, int &clipListSize, int &clipListFrontIndex)
 	{
@@ -1910,6 +2824,38 @@ namespace
 			const auto &uv0XY = uv0XYs[triangleIndex];
 			const auto &uv1XY = uv1XYs[triangleIndex];
 			const auto &uv2XY = uv2XYs[triangleIndex];
+
+			// Classify against all planes at once. Most triangles are either completely inside the frustum or completely
+			// outside one plane, and neither case needs the per-plane clipping below.
+			int outcodes[3];
+			GetTriangleClipOutcodes(shadedV0XYZW, shadedV1XYZW, shadedV2XYZW, outcodes);
+			if ((outcodes[0] & outcodes[1] & outcodes[2]) != 0)
+			{
+				continue;
+			}
+
+			// Crossing a side plane is fine as long as the triangle stays within the guard band. Vertices behind the near
+			// plane can't be tested against the guard band until clipped, so those keep the full frustum clip.
+			constexpr int nearPlaneOutcodeBit = 1 << 2;
+			int clipPlaneOutcodes = outcodes[0] | outcodes[1] | outcodes[2];
+			if ((clipPlaneOutcodes != 0) && ((clipPlaneOutcodes & nearPlaneOutcodeBit) == 0))
+			{
+				clipPlaneOutcodes = GetGuardBandClipOutcode(shadedV0XYZW) | GetGuardBandClipOutcode(shadedV1XYZW) | GetGuardBandClipOutcode(shadedV2XYZW);
+			}
+
+			if (clipPlaneOutcodes == 0)
+			{
+				const int dstIndex = clipSpaceMeshTriangleCount;
+				std::copy(std::begin(shadedV0XYZW), std::end(shadedV0XYZW), std::begin(clipSpaceMeshV0XYZWs[dstIndex]));
+				std::copy(std::begin(shadedV1XYZW), std::end(shadedV1XYZW), std::begin(clipSpaceMeshV1XYZWs[dstIndex]));
+				std::copy(std::begin(shadedV2XYZW), std::end(shadedV2XYZW), std::begin(clipSpaceMeshV2XYZWs[dstIndex]));
+				std::copy(std::begin(uv0XY), std::end(uv0XY), std::begin(clipSpaceMeshUV0XYs[dstIndex]));
+				std::copy(std::begin(uv1XY), std::end(uv1XY), std::begin(clipSpaceMeshUV1XYs[dstIndex]));
+				std::copy(std::begin(uv2XY), std::end(uv2XY), std::begin(clipSpaceMeshUV2XYs[dstIndex]));
+				clipSpaceMeshTriangleCount++;
+				continue;
+			}
+
 			auto &firstClipSpaceTriangleV0XYZW = clipSpaceTriangleV0XYZWs[0];
 			auto &firstClipSpaceTriangleV1XYZW = clipSpaceTriangleV1XYZWs[0];
 			auto &firstClipSpaceTriangleV2XYZW = clipSpaceTriangleV2XYZWs[0];
@@ -1940,13 +2886,37 @@ namespace
 			int clipListSize = 1; // Triangles to process based on this vertex-shaded triangle.
 			int clipListFrontIndex = 0;
 
-			// Check each dimension against -W and W components.
-			ProcessClippingWithPlane<0>(clippingOutputCache, clipListSize, clipListFrontIndex);
-			ProcessClippingWithPlane<1>(clippingOutputCache, clipListSize, clipListFrontIndex);
-			ProcessClippingWithPlane<2>(clippingOutputCache, clipListSize, clipListFrontIndex);
-			ProcessClippingWithPlane<3>(clippingOutputCache, clipListSize, clipListFrontIndex);
-			ProcessClippingWithPlane<4>(clippingOutputCache, clipListSize, clipListFrontIndex);
-			ProcessClippingWithPlane<5>(clippingOutputCache, clipListSize, clipListFrontIndex);
+			// Check each dimension against -W and W components, skipping planes no vertex is outside of. Clipping only
+			// generates points on the triangle's edges so it can't push anything outside a skipped plane.
+			if ((clipPlaneOutcodes & (1 << 0)) != 0)
+			{
+				ProcessClippingWithPlane<0>(clippingOutputCache, clipListSize, clipListFrontIndex);
+			}
+
+			if ((clipPlaneOutcodes & (1 << 3)) != 0)
+			{
+				ProcessClippingWithPlane<1>(clippingOutputCache, clipListSize, clipListFrontIndex);
+			}
+
+			if ((clipPlaneOutcodes & (1 << 1)) != 0)
+			{
+				ProcessClippingWithPlane<2>(clippingOutputCache, clipListSize, clipListFrontIndex);
+			}
+
+			if ((clipPlaneOutcodes & (1 << 4)) != 0)
+			{
+				ProcessClippingWithPlane<3>(clippingOutputCache, clipListSize, clipListFrontIndex);
+			}
+
+			if ((clipPlaneOutcodes & (1 << 2)) != 0)
+			{
+				ProcessClippingWithPlane<4>(clippingOutputCache, clipListSize, clipListFrontIndex);
+			}
+
+			if ((clipPlaneOutcodes & (1 << 5)) != 0)
+			{
+				ProcessClippingWithPlane<5>(clippingOutputCache, clipListSize, clipListFrontIndex);
+			}
 
 			// Add the clip results to the mesh, skipping the incomplete triangles the front index advanced beyond.
 			const int resultTriangleCount = clipListSize - clipListFrontIndex;
@@ -2042,62 +3012,145 @@ namespace
 			this->triangleIndicesCount = 0;
 		}
 	};
+
+	// Fixed-size block of bin triangle data. Bins chain these together so their memory scales with how many
+	// triangles actually touch them instead of the worst case.
+	static constexpr int RASTERIZER_BIN_TRIANGLE_CHUNK_SIZE = 256;
+	static constexpr int RASTERIZER_BIN_MAX_TRIANGLES = 16384;
+	static constexpr int RASTERIZER_BIN_MAX_TRIANGLE_CHUNKS = RASTERIZER_BIN_MAX_TRIANGLES / RASTERIZER_BIN_TRIANGLE_CHUNK_SIZE;
+	static_assert(MathUtils::isPowerOf2(RASTERIZER_BIN_TRIANGLE_CHUNK_SIZE));
+	static_assert(MathUtils::isMultipleOf(RASTERIZER_BIN_MAX_TRIANGLES, RASTERIZER_BIN_TRIANGLE_CHUNK_SIZE));
+
+	struct RasterizerBinTriangleChunk
+	{
+		int triangleIndicesToRasterize[RASTERIZER_BIN_TRIANGLE_CHUNK_SIZE]; // Points into this worker's triangles to rasterize.
+		int triangleBinPixelAlignedXStarts[RASTERIZER_BIN_TRIANGLE_CHUNK_SIZE];
+		int triangleBinPixelAlignedXEnds[RASTERIZER_BIN_TRIANGLE_CHUNK_SIZE];
+		int triangleBinPixelAlignedYStarts[RASTERIZER_BIN_TRIANGLE_CHUNK_SIZE];
+		int triangleBinPixelAlignedYEnds[RASTERIZER_BIN_TRIANGLE_CHUNK_SIZE];
+	};
+
+	// Per-worker linear allocator of bin triangle chunks. Chunks are only ever added, never freed, so after a few
+	// frames the arena settles at the worker's peak coverage and reset() is just an index change.
+	struct RasterizerBinArena
+	{
+		std::vector<std::unique_ptr<RasterizerBinTriangleChunk>> chunks;
+		int usedChunkCount;
+		int peakUsedChunkCount; // High-water mark since the last resetPeak(), spans all draw call loops in a frame.
+
+		RasterizerBinArena()
+		{
+			this->usedChunkCount = 0;
+			this->peakUsedChunkCount = 0;
+		}
+
+		RasterizerBinTriangleChunk *allocChunk()
+		{
+			if (this->usedChunkCount == static_cast<int>(this->chunks.size()))
+			{
+				this->chunks.emplace_back(std::make_unique<RasterizerBinTriangleChunk>());
+			}
+
+			RasterizerBinTriangleChunk *chunk = this->chunks[this->usedChunkCount].get();
+			this->usedChunkCount++;
+			this->peakUsedChunkCount = std::max(this->peakUsedChunkCount, this->usedChunkCount);
+			return chunk;
+		}
+
+		void reset()
+		{
+			this->usedChunkCount = 0;
+		}
+
+		void resetPeak()
+		{
+			this->peakUsedChunkCount = 0;
+		}
+
+		int64_t getPeakByteCount() const
+		{
+			return static_cast<int64_t>(this->peakUsedChunkCount) * sizeof(RasterizerBinTriangleChunk);
+		}
+	};
 }
 
 // Each bin points to front-facing triangles that at least partially touch a screen-space tile
 // (has to be outside a namespace due to being in SoftwareRenderer).
 struct RasterizerBin
 {
-	static constexpr int MAX_FRUSTUM_TRIANGLES = 16384;
+	std::vector<RasterizerBinEntry> entries; // Draw call index + the portion of a mesh pointing into the triangle chunks.
 
-	RasterizerBinEntry entries[MAX_WORKER_DRAW_CALLS_PER_LOOP]; // Draw call index + the portion of a mesh pointing into triangleIndicesToRasterize.
-	int entryCount;
-
-	int triangleIndicesToRasterize[MAX_FRUSTUM_TRIANGLES]; // Points into this worker's triangles to rasterize.
-	int triangleBinPixelAlignedXStarts[MAX_FRUSTUM_TRIANGLES];
-	int triangleBinPixelAlignedXEnds[MAX_FRUSTUM_TRIANGLES];
-	int triangleBinPixelAlignedYStarts[MAX_FRUSTUM_TRIANGLES];
-	int triangleBinPixelAlignedYEnds[MAX_FRUSTUM_TRIANGLES];
+	RasterizerBinTriangleChunk *triangleChunks[RASTERIZER_BIN_MAX_TRIANGLE_CHUNKS]; // Allocated from the worker's arena as triangles are added.
+	int triangleChunkCount;
 	int triangleCount; // Triangles this bin should try to render. Determines where the next bin entry can allocate its triangle range.
 
 	RasterizerBin()
 	{
+		std::fill(std::begin(this->triangleChunks), std::end(this->triangleChunks), nullptr);
 		this->clear();
 	}
 
 	void clear()
 	{
-		this->entryCount = 0;
+		this->entries.clear();
+		this->triangleChunkCount = 0;
 		this->triangleCount = 0;
 	}
 
+	const RasterizerBinTriangleChunk &getTriangleChunk(int binTriangleIndex) const
+	{
+		const int chunkIndex = binTriangleIndex / RASTERIZER_BIN_TRIANGLE_CHUNK_SIZE;
+		DebugAssert(chunkIndex < this->triangleChunkCount);
+		return *this->triangleChunks[chunkIndex];
+	}
+
+	// Appends a triangle to the end of the bin, pulling a new chunk from the arena if the last one is full.
+	int addTriangle(int triangleIndex, int binPixelStartX, int binPixelEndX, int binPixelStartY, int binPixelEndY, RasterizerBinArena &arena)
+	{
+		const int binTriangleIndex = this->triangleCount;
+		DebugAssertMsg(binTriangleIndex < RASTERIZER_BIN_MAX_TRIANGLES, "Too many triangles in bin.");
+
+		const int chunkIndex = binTriangleIndex / RASTERIZER_BIN_TRIANGLE_CHUNK_SIZE;
+		const int chunkTriangleIndex = binTriangleIndex % RASTERIZER_BIN_TRIANGLE_CHUNK_SIZE;
+		if (chunkIndex == this->triangleChunkCount)
+		{
+			DebugAssertIndex(this->triangleChunks, chunkIndex);
+			this->triangleChunks[chunkIndex] = arena.allocChunk();
+			this->triangleChunkCount++;
+		}
+
+		RasterizerBinTriangleChunk &chunk = *this->triangleChunks[chunkIndex];
+		chunk.triangleIndicesToRasterize[chunkTriangleIndex] = triangleIndex;
+		chunk.triangleBinPixelAlignedXStarts[chunkTriangleIndex] = binPixelStartX;
+		chunk.triangleBinPixelAlignedXEnds[chunkTriangleIndex] = binPixelEndX;
+		chunk.triangleBinPixelAlignedYStarts[chunkTriangleIndex] = binPixelStartY;
+		chunk.triangleBinPixelAlignedYEnds[chunkTriangleIndex] = binPixelEndY;
+
+		this->triangleCount++;
+		return binTriangleIndex;
+	}
+
 	RasterizerBinEntry &getOrAddEntry(int workerDrawCallIndex, int triangleIndicesStartIndex)
 	{
 		DebugAssert(workerDrawCallIndex >= 0);
 		DebugAssert(workerDrawCallIndex < MAX_WORKER_DRAW_CALLS_PER_LOOP);
 		DebugAssert(triangleIndicesStartIndex >= 0);
-		DebugAssert(triangleIndicesStartIndex < (MAX_FRUSTUM_TRIANGLES - 1));
+		DebugAssert(triangleIndicesStartIndex < RASTERIZER_BIN_MAX_TRIANGLES);
 
-		RasterizerBinEntry *entryPtr = nullptr;
-		for (int i = 0; i < this->entryCount; i++)
+		// Draw calls are binned in order, so only the most recent entry can match.
+		if (!this->entries.empty())
 		{
-			RasterizerBinEntry &curEntry = this->entries[i];
-			if (curEntry.workerDrawCallIndex == workerDrawCallIndex)
+			RasterizerBinEntry &lastEntry = this->entries.back();
+			if (lastEntry.workerDrawCallIndex == workerDrawCallIndex)
 			{
-				entryPtr = &curEntry;
-				break;
+				return lastEntry;
 			}
 		}
 
-		if (entryPtr == nullptr)
-		{
-			DebugAssertMsg(this->entryCount < std::size(this->entries), "Too many bin entries, can't insert for worker draw call index " + std::to_string(workerDrawCallIndex) + ".");
-			entryPtr = &this->entries[this->entryCount];
-			entryPtr->init(workerDrawCallIndex, triangleIndicesStartIndex);
-			this->entryCount++;
-		}
-
-		return *entryPtr;
+		DebugAssertMsg(this->entries.size() < MAX_WORKER_DRAW_CALLS_PER_LOOP, "Too many bin entries, can't insert for worker draw call index " + std::to_string(workerDrawCallIndex) + ".");
+		RasterizerBinEntry &entry = this->entries.emplace_back();
+		entry.init(workerDrawCallIndex, triangleIndicesStartIndex);
+		return entry;
 	}
 };
 
@@ -2112,12 +3165,15 @@ namespace
 		int triangleCount;
 
 		Buffer2D<RasterizerBin> bins;
+		RasterizerBinArena binArena; // Backing memory for bin triangles, reset whenever bins are emptied.
 		int binWidth, binHeight;
 		int binCountX, binCountY;
+		int visibilityIDBase; // Offset that makes this worker's triangle indices unique in the visibility buffer.
 
 		RasterizerInputCache()
 		{
 			this->triangleCount = 0;
+			this->visibilityIDBase = 0;
 			this->binWidth = 0;
 			this->binHeight = 0;
 			this->binCountX = 0;
@@ -2129,10 +3185,19 @@ namespace
 			this->triangleCount = 0;
 		}
 
-		void createBins(int frameBufferWidth, int frameBufferHeight)
+		bool hasBinLayout(int frameBufferWidth, int frameBufferHeight, int binWidth, int binHeight) const
+		{
+			return (this->binWidth == binWidth) && (this->binHeight == binHeight) &&
+				(this->binCountX == GetRasterizerBinCount(frameBufferWidth, binWidth)) &&
+				(this->binCountY == GetRasterizerBinCount(frameBufferHeight, binHeight));
+		}
+
+		void createBins(int frameBufferWidth, int frameBufferHeight, int binWidth, int binHeight)
 		{
-			this->binWidth = GetRasterizerBinDimension(frameBufferWidth, RASTERIZER_TYPICAL_BINS_PER_FRAME_BUFFER_WIDTH, RASTERIZER_BIN_MIN_WIDTH, RASTERIZER_BIN_MAX_WIDTH);
-			this->binHeight = GetRasterizerBinDimension(frameBufferHeight, RASTERIZER_TYPICAL_BINS_PER_FRAME_BUFFER_HEIGHT, RASTERIZER_BIN_MIN_HEIGHT, RASTERIZER_BIN_MAX_HEIGHT);
+			DebugAssert(binWidth <= RASTERIZER_BIN_MAX_WIDTH);
+			DebugAssert(binHeight <= RASTERIZER_BIN_MAX_HEIGHT);
+			this->binWidth = binWidth;
+			this->binHeight = binHeight;
 			this->binCountX = GetRasterizerBinCount(frameBufferWidth, this->binWidth);
 			this->binCountY = GetRasterizerBinCount(frameBufferHeight, this->binHeight);
 			this->bins.init(this->binCountX, this->binCountY);
@@ -2144,6 +3209,8 @@ namespace
 			{
 				bin.clear();
 			}
+
+			this->binArena.reset();
 		}
 	};
 
@@ -2154,6 +3221,63 @@ namespace
 	static_assert(MathUtils::isMultipleOf(FRAME_BUFFER_LOOP_UNROLL, RASTERIZER_TILE_WIDTH));
 	static_assert(MathUtils::isMultipleOf(FRAME_BUFFER_LOOP_UNROLL, RASTERIZER_TILE_HEIGHT));
 
+	// 2x2 tiles, trivially accepted or rejected per triangle before any per-pixel edge tests.
+	static constexpr int RASTERIZER_BLOCK_WIDTH = RASTERIZER_TILE_WIDTH * 2;
+	static constexpr int RASTERIZER_BLOCK_HEIGHT = RASTERIZER_TILE_HEIGHT * 2;
+	static_assert(MathUtils::isMultipleOf(RASTERIZER_ADAPTIVE_BIN_MIN_DIMENSION, RASTERIZER_BLOCK_WIDTH));
+	static_assert(MathUtils::isMultipleOf(RASTERIZER_ADAPTIVE_BIN_MIN_DIMENSION, RASTERIZER_BLOCK_HEIGHT));
+
+	enum class RasterizerBlockCoverage : uint8_t
+	{
+		None,
+		Partial,
+		Full
+	};
+
+	// Edge functions are affine, so their range over a block's pixel centers comes from the first and last pixel center on each
+	// axis. These are rounded the same way as the per-pixel test so a block's result always agrees with its pixels.
+	template<typename Real>
+	void GetRasterizerBlockEdgeRange(Real pixelCenterFirstX, Real pixelCenterLastX, Real pixelCenterFirstY, Real pixelCenterLastY,
+		Real edgePointX, Real edgePointY, Real edgePerpX, Real edgePerpY, Real *outMin, Real *outMax)
+	{
+		const Real dotFirstX = (pixelCenterFirstX - edgePointX) * edgePerpX;
+		const Real dotLastX = (pixelCenterLastX - edgePointX) * edgePerpX;
+		const Real dotFirstY = (pixelCenterFirstY - edgePointY) * edgePerpY;
+		const Real dotLastY = (pixelCenterLastY - edgePointY) * edgePerpY;
+		*outMin = std::min(dotFirstX, dotLastX) + std::min(dotFirstY, dotLastY);
+		*outMax = std::max(dotFirstX, dotLastX) + std::max(dotFirstY, dotLastY);
+	}
+
+	template<typename Real>
+	RasterizerBlockCoverage GetRasterizerBlockCoverage(Real pixelCenterFirstX, Real pixelCenterLastX, Real pixelCenterFirstY, Real pixelCenterLastY,
+		Real screenSpace0X, Real screenSpace0Y, Real screenSpace1X, Real screenSpace1Y, Real screenSpace2X, Real screenSpace2Y,
+		Real screenSpace01PerpX, Real screenSpace01PerpY, Real screenSpace12PerpX, Real screenSpace12PerpY, Real screenSpace20PerpX, Real screenSpace20PerpY)
+	{
+		Real edgeMins[3], edgeMaxs[3];
+		GetRasterizerBlockEdgeRange(pixelCenterFirstX, pixelCenterLastX, pixelCenterFirstY, pixelCenterLastY, screenSpace0X, screenSpace0Y,
+			screenSpace01PerpX, screenSpace01PerpY, &edgeMins[0], &edgeMaxs[0]);
+		GetRasterizerBlockEdgeRange(pixelCenterFirstX, pixelCenterLastX, pixelCenterFirstY, pixelCenterLastY, screenSpace1X, screenSpace1Y,
+			screenSpace12PerpX, screenSpace12PerpY, &edgeMins[1], &edgeMaxs[1]);
+		GetRasterizerBlockEdgeRange(pixelCenterFirstX, pixelCenterLastX, pixelCenterFirstY, pixelCenterLastY, screenSpace2X, screenSpace2Y,
+			screenSpace20PerpX, screenSpace20PerpY, &edgeMins[2], &edgeMaxs[2]);
+
+		RasterizerBlockCoverage coverage = RasterizerBlockCoverage::Full;
+		for (int i = 0; i < 3; i++)
+		{
+			if (edgeMaxs[i] < static_cast<Real>(0.0))
+			{
+				return RasterizerBlockCoverage::None;
+			}
+
+			if (edgeMins[i] < static_cast<Real>(0.0))
+			{
+				coverage = RasterizerBlockCoverage::Partial;
+			}
+		}
+
+		return coverage;
+	}
+
 	// Rasterizer cache for drawing the current triangle.
 	struct RasterizerPixelTile
 	{
@@ -2163,6 +3287,92 @@ namespace
 		bool previousBrightnessTests[RASTERIZER_TILE_PIXEL_COUNT];
 	};
 
+	// Hierarchical depth, conservative min/max of the depth buffer per rasterizer tile and per bin so triangles can be
+	// rejected (or accepted) before per-pixel coverage and depth work. Only the worker rasterizing a bin touches its tiles.
+	Buffer<double> g_depthTileMins;
+	Buffer<double> g_depthTileMaxs;
+	int g_depthTileCountX;
+	Buffer<double> g_depthBinMins;
+	Buffer<double> g_depthBinMaxs;
+
+	// Whether a bin has visibility buffer pixels that haven't been shaded yet.
+	Buffer<bool> g_visibilityBinHasPending;
+
+	void ClearDepthHierarchy(int frameBufferWidth, int frameBufferHeight, int binCount)
+	{
+		DebugAssert(MathUtils::isMultipleOf(frameBufferWidth, RASTERIZER_TILE_WIDTH));
+		DebugAssert(MathUtils::isMultipleOf(frameBufferHeight, RASTERIZER_TILE_HEIGHT));
+		const int tileCountX = frameBufferWidth / RASTERIZER_TILE_WIDTH;
+		const int tileCountY = frameBufferHeight / RASTERIZER_TILE_HEIGHT;
+		const int tileCount = tileCountX * tileCountY;
+		if (g_depthTileMins.getCount() != tileCount)
+		{
+			g_depthTileMins.init(tileCount);
+			g_depthTileMaxs.init(tileCount);
+		}
+
+		if (g_depthBinMins.getCount() != binCount)
+		{
+			g_depthBinMins.init(binCount);
+			g_depthBinMaxs.init(binCount);
+		}
+
+		g_depthTileCountX = tileCountX;
+		g_depthTileMins.fill(Constants::Infinity);
+		g_depthTileMaxs.fill(Constants::Infinity);
+		g_depthBinMins.fill(Constants::Infinity);
+		g_depthBinMaxs.fill(Constants::Infinity);
+
+		if (g_visibilityBinHasPending.getCount() != binCount)
+		{
+			g_visibilityBinHasPending.init(binCount);
+		}
+
+		g_visibilityBinHasPending.fill(false);
+	}
+
+	template<typename Real>
+	void UpdateDepthTile(const Real *depthBuffer, int frameBufferPixelX, int frameBufferPixelY, int depthTileIndex, int rowStart, int rowStep)
+	{
+		Real tileDepthMin = std::numeric_limits<Real>::infinity();
+		Real tileDepthMax = -std::numeric_limits<Real>::infinity();
+		for (int y = rowStart; y < RASTERIZER_TILE_HEIGHT; y += rowStep)
+		{
+			const Real *depthBufferRow = depthBuffer + frameBufferPixelX + ((frameBufferPixelY + y) * g_frameBufferWidth);
+			for (int x = 0; x < RASTERIZER_TILE_WIDTH; x++)
+			{
+				tileDepthMin = std::min(tileDepthMin, depthBufferRow[x]);
+				tileDepthMax = std::max(tileDepthMax, depthBufferRow[x]);
+			}
+		}
+
+		g_depthTileMins[depthTileIndex] = static_cast<double>(tileDepthMin);
+		g_depthTileMaxs[depthTileIndex] = static_cast<double>(tileDepthMax);
+	}
+
+	void UpdateDepthBin(int binX, int binY, int binWidth, int binHeight, int binIndex)
+	{
+		const int frameBufferPixelStartX = BinPixelToFrameBufferPixel(binX, 0, binWidth);
+		const int frameBufferPixelEndX = std::min(BinPixelToFrameBufferPixel(binX, binWidth, binWidth), g_frameBufferWidth);
+		const int frameBufferPixelStartY = BinPixelToFrameBufferPixel(binY, 0, binHeight);
+		const int frameBufferPixelEndY = std::min(BinPixelToFrameBufferPixel(binY, binHeight, binHeight), g_frameBufferHeight);
+
+		double binDepthMin = Constants::Infinity;
+		double binDepthMax = -Constants::Infinity;
+		for (int tileY = frameBufferPixelStartY / RASTERIZER_TILE_HEIGHT; tileY < (frameBufferPixelEndY / RASTERIZER_TILE_HEIGHT); tileY++)
+		{
+			for (int tileX = frameBufferPixelStartX / RASTERIZER_TILE_WIDTH; tileX < (frameBufferPixelEndX / RASTERIZER_TILE_WIDTH); tileX++)
+			{
+				const int depthTileIndex = tileX + (tileY * g_depthTileCountX);
+				binDepthMin = std::min(binDepthMin, g_depthTileMins[depthTileIndex]);
+				binDepthMax = std::max(binDepthMax, g_depthTileMaxs[depthTileIndex]);
+			}
+		}
+
+		g_depthBinMins[binIndex] = binDepthMin;
+		g_depthBinMaxs[binIndex] = binDepthMax;
+	}
+
 	void ProcessClipSpaceTrianglesForBinning(int workerDrawCallIndex, bool enableBackFaceCulling, const ClippingOutputCache &clippingOutputCache, RasterizerInputCache &rasterizerInputCache)
 	{
 		const auto &clipSpaceMeshV0XYZWs = clippingOutputCache.clipSpaceMeshV0XYZWArray;
@@ -2345,6 +3555,7 @@ namespace
 			outputTriangle.uv1YDivW = uv1YDivW;
 			outputTriangle.uv2XDivW = uv2XDivW;
 			outputTriangle.uv2YDivW = uv2YDivW;
+			outputTriangle.workerDrawCallIndex = workerDrawCallIndex;
 
 			// Write this triangle's index to all affected rasterizer bins.
 			const int binPixelWidth = rasterizerInputCache.binWidth;
@@ -2377,9 +3588,6 @@ namespace
 				for (int binX = bboxStartBinX; binX < bboxEndBinX; binX++)
 				{
 					RasterizerBin &bin = rasterizerInputCache.bins.get(binX, binY);
-					const int binTriangleIndex = bin.triangleCount;
-					DebugAssertIndex(bin.triangleIndicesToRasterize, binTriangleIndex);
-					bin.triangleIndicesToRasterize[binTriangleIndex] = outputTriangleIndex;
 
 					const int binFrameBufferPixelStartX = BinPixelToFrameBufferPixel(binX, 0, binPixelWidth);
 					const int binFrameBufferPixelEndX = BinPixelToFrameBufferPixel(binX, binPixelWidth, binPixelWidth);
@@ -2399,16 +3607,10 @@ namespace
 					DebugAssert(MathUtils::isMultipleOf(binPixelStartX, TYPICAL_LOOP_UNROLL));
 					DebugAssert(MathUtils::isMultipleOf(binPixelEndX, TYPICAL_LOOP_UNROLL));
 
-					bin.triangleBinPixelAlignedXStarts[binTriangleIndex] = binPixelStartX;
-					bin.triangleBinPixelAlignedXEnds[binTriangleIndex] = binPixelEndX;
-					bin.triangleBinPixelAlignedYStarts[binTriangleIndex] = binPixelStartY;
-					bin.triangleBinPixelAlignedYEnds[binTriangleIndex] = binPixelEndY;
-
+					const int binTriangleIndex = bin.addTriangle(outputTriangleIndex, binPixelStartX, binPixelEndX, binPixelStartY, binPixelEndY, rasterizerInputCache.binArena);
 					RasterizerBinEntry &binEntry = bin.getOrAddEntry(workerDrawCallIndex, binTriangleIndex);
 					binEntry.triangleIndicesCount++;
-					DebugAssert(binEntry.triangleIndicesCount <= std::size(bin.triangleIndicesToRasterize));
-
-					bin.triangleCount++;
+					DebugAssert(binEntry.triangleIndicesCount <= bin.triangleCount);
 				}
 			}
 
@@ -2447,14 +3649,30 @@ namespace
 			texelY[i] = static_cast<int>(vFract[i] * texture.heightReal);
 		}
 
-		for (int i = 0; i < N; i++)
+		// Same layout for the whole draw call so this is well predicted.
+		if (texture.tiledTexels != nullptr)
 		{
-			texelIndex[i] = texelX[i] + (texelY[i] * texture.width);
-		}
+			for (int i = 0; i < N; i++)
+			{
+				texelIndex[i] = SoftwareObjectTexture::getTiledTexelIndex(texelX[i], texelY[i], texture.tileCountX);
+			}
 
-		for (int i = 0; i < N; i++)
+			for (int i = 0; i < N; i++)
+			{
+				outTexel[i] = texture.tiledTexels[texelIndex[i]];
+			}
+		}
+		else
 		{
-			outTexel[i] = texture.texels[texelIndex[i]];
+			for (int i = 0; i < N; i++)
+			{
+				texelIndex[i] = texelX[i] + (texelY[i] * texture.width);
+			}
+
+			for (int i = 0; i < N; i++)
+			{
+				outTexel[i] = texture.texels[texelIndex[i]];
+			}
 		}
 	}
 
@@ -2560,10 +3778,14 @@ namespace
 		}
 	}
 
-	template<RenderLightingType lightingType, FragmentShaderType fragmentShaderType, bool enableDepthRead, bool enableDepthWrite, DitheringMode ditheringMode>
+	// Visibility pass only does coverage and depth, and leaves each closest triangle's ID behind for ResolveVisibilityBufferBin().
+	template<RenderLightingType lightingType, FragmentShaderType fragmentShaderType, bool enableDepthRead, bool enableDepthWrite, DitheringMode ditheringMode,
+		RasterPrecisionMode rasterPrecisionMode, bool isVisibilityPass>
 	void RasterizeMeshInternal(const DrawCallCache &drawCallCache, const RasterizerInputCache &rasterizerInputCache, const RasterizerBin &bin,
 		const RasterizerBinEntry &binEntry, int binX, int binY, int binIndex)
 	{
+		static_assert(!isVisibilityPass || (enableDepthRead && enableDepthWrite));
+
 		// Early-out conditions.
 		constexpr bool requiresMainAlphaTest =
 			(fragmentShaderType == FragmentShaderType::AlphaTested) ||
@@ -2610,6 +3832,10 @@ namespace
 		constexpr bool requiresLightLevelLighting = fragmentShaderType != FragmentShaderType::AlphaTestedWithLightLevelOpacity;
 		constexpr bool requiresLightTableLighting = fragmentShaderType == FragmentShaderType::AlphaTestedWithLightLevelOpacity;
 
+		// Coverage, barycentric, and depth math runs at the selected precision, shading stays in double.
+		using Real = RasterReal<rasterPrecisionMode>;
+		Real *depthBuffer = GetDepthBuffer<rasterPrecisionMode>();
+
 		const double meshLightPercent = drawCallCache.meshLightPercent;
 		const double texCoordAnimPercent = drawCallCache.texCoordAnimPercent;
 
@@ -2645,11 +3871,12 @@ namespace
 		FragmentShaderTexture shaderTexture0;
 		shaderTexture0.init(texture0.texels8Bit, texture0.width, texture0.height);
 
+		const SoftwareObjectTexture *texture1 = nullptr;
 		FragmentShaderTexture shaderTexture1;
 		if constexpr (requiresTwoTextures)
 		{
-			const SoftwareObjectTexture &texture1 = g_objectTextures->get(textureID1);
-			shaderTexture1.init(texture1.texels8Bit, texture1.width, texture1.height);
+			texture1 = &g_objectTextures->get(textureID1);
+			shaderTexture1.init(texture1->texels8Bit, texture1->width, texture1->height);
 		}
 
 		FragmentShaderUniforms shaderUniforms;
@@ -2657,18 +3884,40 @@ namespace
 
 		const int lightBinWidth = GetLightBinWidth(g_frameBufferWidth);
 		const int lightBinHeight = GetLightBinHeight(g_frameBufferHeight);
+		const WorldDouble3 cameraPoint = g_camera.floatingWorldPoint;
+		const Double3 cameraForward = g_camera.forward;
+
+		// Bin-level hierarchical depth, tightened from its tiles after this draw call if any depth was written.
+		double &binDepthMin = g_depthBinMins[binIndex];
+		double &binDepthMax = g_depthBinMaxs[binIndex];
+		bool hasWrittenAnyDepth = false;
+
+		// Forward-shaded pixels must not be overwritten later by a pending triangle they covered up.
+		const bool shouldClearVisibility = !isVisibilityPass && g_visibilityBinHasPending[binIndex];
+		bool hasWrittenAnyVisibility = false;
 
 		// Local variables added to a global afterwards to avoid fighting with threads.
 		int totalCoverageTests = 0;
+		int totalCoverageBlockAccepts = 0;
 		int totalDepthTests = 0;
 		int totalColorWrites = 0;
+		int totalShadedFragments = 0;
+		int totalMipmappedFragments = 0;
+		int totalLitFragments = 0;
+		int totalFragmentLightTests = 0;
+
+		// Interlaced frames only rasterize rows of one parity. Tile rows start on even pixels so it's the same rows in each tile.
+		static_assert((TYPICAL_LOOP_UNROLL % 2) == 0);
+		const int interlaceRowStart = std::max(g_interlaceRowParity, 0);
+		const int interlaceRowStep = (g_interlaceRowParity >= 0) ? 2 : 1;
 
-		const auto &triangleIndices = bin.triangleIndicesToRasterize;
 		for (int entryTriangleIndex = 0; entryTriangleIndex < binEntry.triangleIndicesCount; entryTriangleIndex++)
 		{
 			const int triangleIndicesIndex = binEntry.triangleIndicesStartIndex + entryTriangleIndex;
-			DebugAssertIndex(triangleIndices, triangleIndicesIndex);
-			const int triangleIndex = triangleIndices[triangleIndicesIndex];
+			DebugAssert(triangleIndicesIndex < bin.triangleCount);
+			const RasterizerBinTriangleChunk &binTriangleChunk = bin.getTriangleChunk(triangleIndicesIndex);
+			const int chunkTriangleIndex = triangleIndicesIndex % RASTERIZER_BIN_TRIANGLE_CHUNK_SIZE;
+			const int triangleIndex = binTriangleChunk.triangleIndicesToRasterize[chunkTriangleIndex];
 			const RasterizerTriangle &triangle = rasterizerInputCache.triangles[triangleIndex];
 			const double clip0X = triangle.clip0X;
 			const double clip0Y = triangle.clip0Y;
@@ -2694,24 +3943,24 @@ namespace
 			const double ndc2X = triangle.ndc2X;
 			const double ndc2Y = triangle.ndc2Y;
 			const double ndc2Z = triangle.ndc2Z;
-			const double screenSpace0X = triangle.screenSpace0X;
-			const double screenSpace0Y = triangle.screenSpace0Y;
-			const double screenSpace1X = triangle.screenSpace1X;
-			const double screenSpace1Y = triangle.screenSpace1Y;
-			const double screenSpace2X = triangle.screenSpace2X;
-			const double screenSpace2Y = triangle.screenSpace2Y;
-			const double screenSpace01X = triangle.screenSpace01X;
-			const double screenSpace01Y = triangle.screenSpace01Y;
-			const double screenSpace12X = triangle.screenSpace12X;
-			const double screenSpace12Y = triangle.screenSpace12Y;
-			const double screenSpace20X = triangle.screenSpace20X;
-			const double screenSpace20Y = triangle.screenSpace20Y;
-			const double screenSpace01PerpX = triangle.screenSpace01PerpX;
-			const double screenSpace01PerpY = triangle.screenSpace01PerpY;
-			const double screenSpace12PerpX = triangle.screenSpace12PerpX;
-			const double screenSpace12PerpY = triangle.screenSpace12PerpY;
-			const double screenSpace20PerpX = triangle.screenSpace20PerpX;
-			const double screenSpace20PerpY = triangle.screenSpace20PerpY;
+			const Real screenSpace0X = static_cast<Real>(triangle.screenSpace0X);
+			const Real screenSpace0Y = static_cast<Real>(triangle.screenSpace0Y);
+			const Real screenSpace1X = static_cast<Real>(triangle.screenSpace1X);
+			const Real screenSpace1Y = static_cast<Real>(triangle.screenSpace1Y);
+			const Real screenSpace2X = static_cast<Real>(triangle.screenSpace2X);
+			const Real screenSpace2Y = static_cast<Real>(triangle.screenSpace2Y);
+			const Real screenSpace01X = static_cast<Real>(triangle.screenSpace01X);
+			const Real screenSpace01Y = static_cast<Real>(triangle.screenSpace01Y);
+			const Real screenSpace12X = static_cast<Real>(triangle.screenSpace12X);
+			const Real screenSpace12Y = static_cast<Real>(triangle.screenSpace12Y);
+			const Real screenSpace20X = static_cast<Real>(triangle.screenSpace20X);
+			const Real screenSpace20Y = static_cast<Real>(triangle.screenSpace20Y);
+			const Real screenSpace01PerpX = static_cast<Real>(triangle.screenSpace01PerpX);
+			const Real screenSpace01PerpY = static_cast<Real>(triangle.screenSpace01PerpY);
+			const Real screenSpace12PerpX = static_cast<Real>(triangle.screenSpace12PerpX);
+			const Real screenSpace12PerpY = static_cast<Real>(triangle.screenSpace12PerpY);
+			const Real screenSpace20PerpX = static_cast<Real>(triangle.screenSpace20PerpX);
+			const Real screenSpace20PerpY = static_cast<Real>(triangle.screenSpace20PerpY);
 			const double uv0X = triangle.uv0X;
 			const double uv0Y = triangle.uv0Y;
 			const double uv1X = triangle.uv1X;
@@ -2724,27 +3973,90 @@ namespace
 			const double uv1YDivW = triangle.uv1YDivW;
 			const double uv2XDivW = triangle.uv2XDivW;
 			const double uv2YDivW = triangle.uv2YDivW;
+			const Real depthNdc0Z = static_cast<Real>(ndc0Z);
+			const Real depthNdc1Z = static_cast<Real>(ndc1Z);
+			const Real depthNdc2Z = static_cast<Real>(ndc2Z);
+
+			// Screen-space depth is affine so the vertices bound every pixel's depth in the triangle.
+			const Real triangleDepthMin = std::min(depthNdc0Z, std::min(depthNdc1Z, depthNdc2Z));
+			const Real triangleDepthMax = std::max(depthNdc0Z, std::max(depthNdc1Z, depthNdc2Z));
+			bool isTriangleInFrontOfBin = false;
+			if constexpr (enableDepthRead)
+			{
+				if (triangleDepthMin >= binDepthMax)
+				{
+					continue; // Behind everything already in this bin.
+				}
+
+				isTriangleInFrontOfBin = triangleDepthMax < binDepthMin;
+			}
+
+			// Screen-space animation and palette lookup textures are always read at full size.
+			bool isTriangleMipmapped = false;
+			if constexpr (!isVisibilityPass)
+			{
+				if constexpr (requiresPerspectiveTexelMain)
+				{
+					const int mipLevel0 = GetTriangleMipLevel(triangle, texture0);
+					shaderTexture0.initMipLevel(texture0, mipLevel0, g_enableTiledTexels);
+					isTriangleMipmapped = mipLevel0 > 0;
+				}
+
+				if constexpr (requiresPerspectiveTexelLayer)
+				{
+					const int mipLevel1 = GetTriangleMipLevel(triangle, *texture1);
+					shaderTexture1.initMipLevel(*texture1, mipLevel1, g_enableTiledTexels);
+					isTriangleMipmapped |= mipLevel1 > 0;
+				}
+			}
 
-			const double screenSpace02X = -triangle.screenSpace20X;
-			const double screenSpace02Y = -triangle.screenSpace20Y;
-			double barycentricDot00, barycentricDot01, barycentricDot11;
-			Double2_DotN<1>(&screenSpace01X, &screenSpace01Y, &screenSpace01X, &screenSpace01Y, &barycentricDot00);
-			Double2_DotN<1>(&screenSpace01X, &screenSpace01Y, &screenSpace02X, &screenSpace02Y, &barycentricDot01);
-			Double2_DotN<1>(&screenSpace02X, &screenSpace02Y, &screenSpace02X, &screenSpace02Y, &barycentricDot11);
+			const Real screenSpace02X = -screenSpace20X;
+			const Real screenSpace02Y = -screenSpace20Y;
+			const Real barycentricDot00 = (screenSpace01X * screenSpace01X) + (screenSpace01Y * screenSpace01Y);
+			const Real barycentricDot01 = (screenSpace01X * screenSpace02X) + (screenSpace01Y * screenSpace02Y);
+			const Real barycentricDot11 = (screenSpace02X * screenSpace02X) + (screenSpace02Y * screenSpace02Y);
 
-			const double barycentricDenominator = (barycentricDot00 * barycentricDot11) - (barycentricDot01 * barycentricDot01);
-			const double barycentricDenominatorRecip = 1.0 / barycentricDenominator;
+			const Real barycentricDenominator = (barycentricDot00 * barycentricDot11) - (barycentricDot01 * barycentricDot01);
+			const Real barycentricDenominatorRecip = static_cast<Real>(1.0) / barycentricDenominator;
 
-			const int binPixelXStart = bin.triangleBinPixelAlignedXStarts[triangleIndicesIndex];
-			const int binPixelXEnd = bin.triangleBinPixelAlignedXEnds[triangleIndicesIndex];
+			const int binPixelXStart = binTriangleChunk.triangleBinPixelAlignedXStarts[chunkTriangleIndex];
+			const int binPixelXEnd = binTriangleChunk.triangleBinPixelAlignedXEnds[chunkTriangleIndex];
 			const int binPixelXUnrollAdjustedEnd = GetUnrollAdjustedLoopCount(binPixelXEnd, TYPICAL_LOOP_UNROLL);
-			const int binPixelYStart = bin.triangleBinPixelAlignedYStarts[triangleIndicesIndex];
-			const int binPixelYEnd = bin.triangleBinPixelAlignedYEnds[triangleIndicesIndex];
+			const int binPixelYStart = binTriangleChunk.triangleBinPixelAlignedYStarts[chunkTriangleIndex];
+			const int binPixelYEnd = binTriangleChunk.triangleBinPixelAlignedYEnds[chunkTriangleIndex];
 			const int binPixelYUnrollAdjustedEnd = GetUnrollAdjustedLoopCount(binPixelYEnd, TYPICAL_LOOP_UNROLL);
 
+			RasterizerBlockCoverage blockRowCoverages[RASTERIZER_BIN_MAX_WIDTH / RASTERIZER_BLOCK_WIDTH];
+			int blockRowY = -1;
+
 			// Shade triangle using this bin's bounding box of it.
 			for (int binPixelY = binPixelYStart; binPixelY < binPixelYUnrollAdjustedEnd; binPixelY += TYPICAL_LOOP_UNROLL)
 			{
+				// Block coverage for this row of tiles, shared with the other row of tiles in the same blocks.
+				const int blockY = binPixelY / RASTERIZER_BLOCK_HEIGHT;
+				if (blockY != blockRowY)
+				{
+					const int blockFrameBufferPixelFirstY = BinPixelToFrameBufferPixel(binY, blockY * RASTERIZER_BLOCK_HEIGHT, rasterizerInputCache.binHeight);
+					const int blockFrameBufferPixelLastY = blockFrameBufferPixelFirstY + RASTERIZER_BLOCK_HEIGHT - 1;
+					const Real blockPixelCenterFirstY = static_cast<Real>(((static_cast<double>(blockFrameBufferPixelFirstY) + 0.50) * g_frameBufferHeightRealRecip) * g_frameBufferHeightReal);
+					const Real blockPixelCenterLastY = static_cast<Real>(((static_cast<double>(blockFrameBufferPixelLastY) + 0.50) * g_frameBufferHeightRealRecip) * g_frameBufferHeightReal);
+
+					const int blockXStart = binPixelXStart / RASTERIZER_BLOCK_WIDTH;
+					const int blockXEnd = (binPixelXUnrollAdjustedEnd + (RASTERIZER_BLOCK_WIDTH - 1)) / RASTERIZER_BLOCK_WIDTH;
+					for (int blockX = blockXStart; blockX < blockXEnd; blockX++)
+					{
+						const int blockFrameBufferPixelFirstX = BinPixelToFrameBufferPixel(binX, blockX * RASTERIZER_BLOCK_WIDTH, rasterizerInputCache.binWidth);
+						const int blockFrameBufferPixelLastX = blockFrameBufferPixelFirstX + RASTERIZER_BLOCK_WIDTH - 1;
+						const Real blockPixelCenterFirstX = static_cast<Real>(((static_cast<double>(blockFrameBufferPixelFirstX) + 0.50) * g_frameBufferWidthRealRecip) * g_frameBufferWidthReal);
+						const Real blockPixelCenterLastX = static_cast<Real>(((static_cast<double>(blockFrameBufferPixelLastX) + 0.50) * g_frameBufferWidthRealRecip) * g_frameBufferWidthReal);
+						blockRowCoverages[blockX] = GetRasterizerBlockCoverage(blockPixelCenterFirstX, blockPixelCenterLastX, blockPixelCenterFirstY, blockPixelCenterLastY,
+							screenSpace0X, screenSpace0Y, screenSpace1X, screenSpace1Y, screenSpace2X, screenSpace2Y,
+							screenSpace01PerpX, screenSpace01PerpY, screenSpace12PerpX, screenSpace12PerpY, screenSpace20PerpX, screenSpace20PerpY);
+					}
+
+					blockRowY = blockY;
+				}
+
 				// Column slice setup.
 				int frameBufferPixelY[TYPICAL_LOOP_UNROLL];
 				double frameBufferPercentY[TYPICAL_LOOP_UNROLL];
@@ -2759,21 +4071,29 @@ namespace
 					frameBufferPercentY[i] = (static_cast<double>(frameBufferPixelY[i]) + 0.50) * g_frameBufferHeightRealRecip;
 				}
 
+				static_assert(RASTERIZER_TILE_HEIGHT == TYPICAL_LOOP_UNROLL);
+				const int depthTileY = frameBufferPixelY[0] / RASTERIZER_TILE_HEIGHT;
+				bool isDepthTileWritten[RASTERIZER_BIN_MAX_WIDTH / RASTERIZER_TILE_WIDTH];
+				if constexpr (enableDepthWrite)
+				{
+					std::fill(std::begin(isDepthTileWritten), std::end(isDepthTileWritten), false);
+				}
+
 				// Column pixel coverage test components.
-				double pixelCenterY[TYPICAL_LOOP_UNROLL];
-				double pixelCenterPlane0DiffY[TYPICAL_LOOP_UNROLL];
-				double pixelCenterPlane1DiffY[TYPICAL_LOOP_UNROLL];
-				double pixelCenterPlane2DiffY[TYPICAL_LOOP_UNROLL];
-				double pixelCoverageDot0Y[TYPICAL_LOOP_UNROLL];
-				double pixelCoverageDot1Y[TYPICAL_LOOP_UNROLL];
-				double pixelCoverageDot2Y[TYPICAL_LOOP_UNROLL];
-				double screenSpace0CurrentY[TYPICAL_LOOP_UNROLL];
-				double barycentricDot20Y[TYPICAL_LOOP_UNROLL];
-				double barycentricDot21Y[TYPICAL_LOOP_UNROLL];
+				Real pixelCenterY[TYPICAL_LOOP_UNROLL];
+				Real pixelCenterPlane0DiffY[TYPICAL_LOOP_UNROLL];
+				Real pixelCenterPlane1DiffY[TYPICAL_LOOP_UNROLL];
+				Real pixelCenterPlane2DiffY[TYPICAL_LOOP_UNROLL];
+				Real pixelCoverageDot0Y[TYPICAL_LOOP_UNROLL];
+				Real pixelCoverageDot1Y[TYPICAL_LOOP_UNROLL];
+				Real pixelCoverageDot2Y[TYPICAL_LOOP_UNROLL];
+				Real screenSpace0CurrentY[TYPICAL_LOOP_UNROLL];
+				Real barycentricDot20Y[TYPICAL_LOOP_UNROLL];
+				Real barycentricDot21Y[TYPICAL_LOOP_UNROLL];
 
 				for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
 				{
-					pixelCenterY[i] = frameBufferPercentY[i] * g_frameBufferHeightReal;
+					pixelCenterY[i] = static_cast<Real>(frameBufferPercentY[i] * g_frameBufferHeightReal);
 				}
 
 				for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
@@ -2829,7 +4149,7 @@ namespace
 					lightBinY[i] = GetLightBinY(frameBufferPixelY[i], lightBinHeight);
 				}
 
-				for (int yUnrollIndex = 0; yUnrollIndex < TYPICAL_LOOP_UNROLL; yUnrollIndex++)
+				for (int yUnrollIndex = interlaceRowStart; yUnrollIndex < TYPICAL_LOOP_UNROLL; yUnrollIndex += interlaceRowStep)
 				{
 					for (int binPixelX = binPixelXStart; binPixelX < binPixelXUnrollAdjustedEnd; binPixelX += TYPICAL_LOOP_UNROLL)
 					{
@@ -2849,24 +4169,38 @@ namespace
 
 						const int frameBufferSlicePixelIndex = frameBufferPixelIndex[0];
 						uint8_t *paletteIndexBufferSlice = g_paletteIndexBuffer + frameBufferSlicePixelIndex;
-						double *depthBufferSlice = g_depthBuffer + frameBufferSlicePixelIndex;
+						Real *depthBufferSlice = depthBuffer + frameBufferSlicePixelIndex;
 						uint32_t *colorBufferSlice = g_colorBuffer + frameBufferSlicePixelIndex;
+						int32_t *visibilityBufferSlice = g_visibilityBuffer + frameBufferSlicePixelIndex;
+
+						// Block coverage test (is the triangle missing this whole block?).
+						const RasterizerBlockCoverage blockCoverage = blockRowCoverages[binPixelX / RASTERIZER_BLOCK_WIDTH];
+						if (blockCoverage == RasterizerBlockCoverage::None)
+						{
+							continue;
+						}
+
+						// Hierarchical depth test (is the whole tile already closer, or further, than this triangle?).
+						static_assert(RASTERIZER_TILE_WIDTH == TYPICAL_LOOP_UNROLL);
+						const int depthTileIndex = (frameBufferPixelX[0] / RASTERIZER_TILE_WIDTH) + (depthTileY * g_depthTileCountX);
+						bool isTriangleInFrontOfTile = isTriangleInFrontOfBin;
+
+						if constexpr (enableDepthRead)
+						{
+							if (!isTriangleInFrontOfBin)
+							{
+								if (triangleDepthMin >= g_depthTileMaxs[depthTileIndex])
+								{
+									continue;
+								}
+
+								isTriangleInFrontOfTile = triangleDepthMax < g_depthTileMins[depthTileIndex];
+							}
+						}
 
 						// Coverage test (is pixel center in triangle?).
 						double frameBufferPercentX[TYPICAL_LOOP_UNROLL];
-						double pixelCenterX[TYPICAL_LOOP_UNROLL];
-						double pixelCenterPlane0DiffX[TYPICAL_LOOP_UNROLL];
-						double pixelCenterPlane1DiffX[TYPICAL_LOOP_UNROLL];
-						double pixelCenterPlane2DiffX[TYPICAL_LOOP_UNROLL];
-						double pixelCoverageDot0X[TYPICAL_LOOP_UNROLL];
-						double pixelCoverageDot1X[TYPICAL_LOOP_UNROLL];
-						double pixelCoverageDot2X[TYPICAL_LOOP_UNROLL];
-						double pixelCenterDot0[TYPICAL_LOOP_UNROLL];
-						double pixelCenterDot1[TYPICAL_LOOP_UNROLL];
-						double pixelCenterDot2[TYPICAL_LOOP_UNROLL];
-						bool isPixelCenterIn0[TYPICAL_LOOP_UNROLL];
-						bool isPixelCenterIn1[TYPICAL_LOOP_UNROLL];
-						bool isPixelCenterIn2[TYPICAL_LOOP_UNROLL];
+						Real pixelCenterX[TYPICAL_LOOP_UNROLL];
 						bool isPixelCenterCovered[TYPICAL_LOOP_UNROLL];
 
 						for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
@@ -2876,85 +4210,106 @@ namespace
 
 						for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
 						{
-							pixelCenterX[i] = frameBufferPercentX[i] * g_frameBufferWidthReal;
+							pixelCenterX[i] = static_cast<Real>(frameBufferPercentX[i] * g_frameBufferWidthReal);
 						}
 
-						for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
+						if (blockCoverage == RasterizerBlockCoverage::Full)
 						{
-							pixelCenterPlane0DiffX[i] = pixelCenterX[i] - screenSpace0X;
+							std::fill(std::begin(isPixelCenterCovered), std::end(isPixelCenterCovered), true);
+							totalCoverageBlockAccepts += TYPICAL_LOOP_UNROLL;
 						}
-
-						for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
+						else
 						{
-							pixelCenterPlane1DiffX[i] = pixelCenterX[i] - screenSpace1X;
-						}
+							Real pixelCenterPlane0DiffX[TYPICAL_LOOP_UNROLL];
+							Real pixelCenterPlane1DiffX[TYPICAL_LOOP_UNROLL];
+							Real pixelCenterPlane2DiffX[TYPICAL_LOOP_UNROLL];
+							Real pixelCoverageDot0X[TYPICAL_LOOP_UNROLL];
+							Real pixelCoverageDot1X[TYPICAL_LOOP_UNROLL];
+							Real pixelCoverageDot2X[TYPICAL_LOOP_UNROLL];
+							Real pixelCenterDot0[TYPICAL_LOOP_UNROLL];
+							Real pixelCenterDot1[TYPICAL_LOOP_UNROLL];
+							Real pixelCenterDot2[TYPICAL_LOOP_UNROLL];
+							bool isPixelCenterIn0[TYPICAL_LOOP_UNROLL];
+							bool isPixelCenterIn1[TYPICAL_LOOP_UNROLL];
+							bool isPixelCenterIn2[TYPICAL_LOOP_UNROLL];
 
-						for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
-						{
-							pixelCenterPlane2DiffX[i] = pixelCenterX[i] - screenSpace2X;
-						}
+							for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
+							{
+								pixelCenterPlane0DiffX[i] = pixelCenterX[i] - screenSpace0X;
+							}
 
-						for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
-						{
-							pixelCoverageDot0X[i] = pixelCenterPlane0DiffX[i] * screenSpace01PerpX;
-						}
+							for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
+							{
+								pixelCenterPlane1DiffX[i] = pixelCenterX[i] - screenSpace1X;
+							}
 
-						for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
-						{
-							pixelCoverageDot1X[i] = pixelCenterPlane1DiffX[i] * screenSpace12PerpX;
-						}
+							for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
+							{
+								pixelCenterPlane2DiffX[i] = pixelCenterX[i] - screenSpace2X;
+							}
 
-						for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
-						{
-							pixelCoverageDot2X[i] = pixelCenterPlane2DiffX[i] * screenSpace20PerpX;
-						}
+							for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
+							{
+								pixelCoverageDot0X[i] = pixelCenterPlane0DiffX[i] * screenSpace01PerpX;
+							}
 
-						for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
-						{
-							pixelCenterDot0[i] = pixelCoverageDot0X[i] + pixelCoverageDot0Y[yUnrollIndex];
-						}
+							for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
+							{
+								pixelCoverageDot1X[i] = pixelCenterPlane1DiffX[i] * screenSpace12PerpX;
+							}
 
-						for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
-						{
-							pixelCenterDot1[i] = pixelCoverageDot1X[i] + pixelCoverageDot1Y[yUnrollIndex];
-						}
+							for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
+							{
+								pixelCoverageDot2X[i] = pixelCenterPlane2DiffX[i] * screenSpace20PerpX;
+							}
 
-						for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
-						{
-							pixelCenterDot2[i] = pixelCoverageDot2X[i] + pixelCoverageDot2Y[yUnrollIndex];
-						}
+							for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
+							{
+								pixelCenterDot0[i] = pixelCoverageDot0X[i] + pixelCoverageDot0Y[yUnrollIndex];
+							}
 
-						for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
-						{
-							isPixelCenterIn0[i] = pixelCenterDot0[i] >= 0.0;
-						}
+							for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
+							{
+								pixelCenterDot1[i] = pixelCoverageDot1X[i] + pixelCoverageDot1Y[yUnrollIndex];
+							}
 
-						for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
-						{
-							isPixelCenterIn1[i] = pixelCenterDot1[i] >= 0.0;
-						}
+							for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
+							{
+								pixelCenterDot2[i] = pixelCoverageDot2X[i] + pixelCoverageDot2Y[yUnrollIndex];
+							}
 
-						for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
-						{
-							isPixelCenterIn2[i] = pixelCenterDot2[i] >= 0.0;
-						}
+							for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
+							{
+								isPixelCenterIn0[i] = pixelCenterDot0[i] >= static_cast<Real>(0.0);
+							}
 
-						for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
-						{
-							isPixelCenterCovered[i] = isPixelCenterIn0[i] && isPixelCenterIn1[i] && isPixelCenterIn2[i];
-						}
+							for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
+							{
+								isPixelCenterIn1[i] = pixelCenterDot1[i] >= static_cast<Real>(0.0);
+							}
 
-						totalCoverageTests += TYPICAL_LOOP_UNROLL;
+							for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
+							{
+								isPixelCenterIn2[i] = pixelCenterDot2[i] >= static_cast<Real>(0.0);
+							}
 
-						bool passesAnyCoverageTest = false;
-						for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
-						{
-							passesAnyCoverageTest |= isPixelCenterCovered[i];
-						}
+							for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
+							{
+								isPixelCenterCovered[i] = isPixelCenterIn0[i] && isPixelCenterIn1[i] && isPixelCenterIn2[i];
+							}
 
-						if (!passesAnyCoverageTest)
-						{
-							continue;
+							totalCoverageTests += TYPICAL_LOOP_UNROLL;
+
+							bool passesAnyCoverageTest = false;
+							for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
+							{
+								passesAnyCoverageTest |= isPixelCenterCovered[i];
+							}
+
+							if (!passesAnyCoverageTest)
+							{
+								continue;
+							}
 						}
 
 						// Previous brightness test (is pixel center dark enough for certain shaders?).
@@ -3000,17 +4355,17 @@ namespace
 						}
 
 						// Depth test (is pixel center closer than depth buffer?).
-						double screenSpace0CurrentX[TYPICAL_LOOP_UNROLL];
-						double barycentricDot20X[TYPICAL_LOOP_UNROLL];
-						double barycentricDot21X[TYPICAL_LOOP_UNROLL];
-						double barycentricDot20[TYPICAL_LOOP_UNROLL];
-						double barycentricDot21[TYPICAL_LOOP_UNROLL];
-						double vNumerator[TYPICAL_LOOP_UNROLL];
-						double wNumerator[TYPICAL_LOOP_UNROLL];
-						double v[TYPICAL_LOOP_UNROLL];
-						double w[TYPICAL_LOOP_UNROLL];
-						double u[TYPICAL_LOOP_UNROLL];
-						double ndcZDepth[TYPICAL_LOOP_UNROLL];
+						Real screenSpace0CurrentX[TYPICAL_LOOP_UNROLL];
+						Real barycentricDot20X[TYPICAL_LOOP_UNROLL];
+						Real barycentricDot21X[TYPICAL_LOOP_UNROLL];
+						Real barycentricDot20[TYPICAL_LOOP_UNROLL];
+						Real barycentricDot21[TYPICAL_LOOP_UNROLL];
+						Real vNumerator[TYPICAL_LOOP_UNROLL];
+						Real wNumerator[TYPICAL_LOOP_UNROLL];
+						Real v[TYPICAL_LOOP_UNROLL];
+						Real w[TYPICAL_LOOP_UNROLL];
+						Real u[TYPICAL_LOOP_UNROLL];
+						Real ndcZDepth[TYPICAL_LOOP_UNROLL];
 						bool isPixelCenterDepthLower[TYPICAL_LOOP_UNROLL];
 
 						for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
@@ -3060,42 +4415,72 @@ namespace
 
 						for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
 						{
-							u[i] = 1.0 - v[i] - w[i];
+							u[i] = static_cast<Real>(1.0) - v[i] - w[i];
 						}
 
 						for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
 						{
-							ndcZDepth[i] = (ndc0Z * u[i]) + (ndc1Z * v[i]) + (ndc2Z * w[i]);
+							ndcZDepth[i] = (depthNdc0Z * u[i]) + (depthNdc1Z * v[i]) + (depthNdc2Z * w[i]);
 						}
 
 						if constexpr (enableDepthRead)
 						{
-							double prevDepthBufferPixels[TYPICAL_LOOP_UNROLL];
-							for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
+							if (isTriangleInFrontOfTile)
 							{
-								prevDepthBufferPixels[i] = depthBufferSlice[i];
+								for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
+								{
+									isPixelCenterDepthLower[i] = true;
+								}
 							}
-
-							for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
+							else
 							{
-								isPixelCenterDepthLower[i] = ndcZDepth[i] < prevDepthBufferPixels[i];
+								Real prevDepthBufferPixels[TYPICAL_LOOP_UNROLL];
+								for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
+								{
+									prevDepthBufferPixels[i] = depthBufferSlice[i];
+								}
+
+								for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
+								{
+									isPixelCenterDepthLower[i] = ndcZDepth[i] < prevDepthBufferPixels[i];
+								}
+
+								totalDepthTests += TYPICAL_LOOP_UNROLL;
+
+								bool passesAnyDepthTest = false;
+								for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
+								{
+									passesAnyDepthTest |= isPixelCenterDepthLower[i];
+								}
+
+								if (!passesAnyDepthTest)
+								{
+									continue;
+								}
 							}
+						}
 
-							totalDepthTests += TYPICAL_LOOP_UNROLL;
+						if constexpr (isVisibilityPass)
+						{
+							const int32_t visibilityID = rasterizerInputCache.visibilityIDBase + triangleIndex;
 
-							bool passesAnyDepthTest = false;
 							for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
 							{
-								passesAnyDepthTest |= isPixelCenterDepthLower[i];
+								if (isPixelCenterCovered[i] && isPixelCenterDepthLower[i])
+								{
+									visibilityBufferSlice[i] = visibilityID;
+									depthBufferSlice[i] = ndcZDepth[i];
+									isDepthTileWritten[binPixelX / RASTERIZER_TILE_WIDTH] = true;
+									hasWrittenAnyVisibility = true;
+								}
 							}
 
-							if (!passesAnyDepthTest)
-							{
-								continue;
-							}
+							continue;
 						}
 
 						// Texture lookup.
+						totalShadedFragments += TYPICAL_LOOP_UNROLL;
+						totalMipmappedFragments += isTriangleMipmapped ? TYPICAL_LOOP_UNROLL : 0;
 						double shaderClipSpacePointX[TYPICAL_LOOP_UNROLL];
 						double shaderClipSpacePointY[TYPICAL_LOOP_UNROLL];
 						double shaderClipSpacePointZ[TYPICAL_LOOP_UNROLL];
@@ -3388,13 +4773,29 @@ namespace
 								lightIntensitySum[i] = g_ambientPercent;
 							}
 
+							int lightBinDepthSlice[TYPICAL_LOOP_UNROLL];
+
+							for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
+							{
+								const double shaderViewDepth = ((shaderWorldSpacePointX[i] - cameraPoint.x) * cameraForward.x) +
+									((shaderWorldSpacePointY[i] - cameraPoint.y) * cameraForward.y) + ((shaderWorldSpacePointZ[i] - cameraPoint.z) * cameraForward.z);
+								lightBinDepthSlice[i] = GetLightBinDepthSlice(shaderViewDepth);
+							}
+
 							// @todo don't cross light bin boundary, currently very hard to simdify due to variable light count
 
+							totalLitFragments += TYPICAL_LOOP_UNROLL;
+
 							for (int i = 0; i < TYPICAL_LOOP_UNROLL; i++)
 							{
 								const LightBin &lightBin = g_lightBins.get(lightBinX[i], lightBinY[yUnrollIndex]);
-								for (int lightIndex = 0; lightIndex < lightBin.lightCount; lightIndex++)
+								LightBinLightMask lightMask = lightBin.depthSliceLightMasks[lightBinDepthSlice[i]];
+								while (lightMask != 0)
 								{
+									const int lightIndex = std::countr_zero(lightMask);
+									lightMask &= lightMask - 1;
+									totalFragmentLightTests++;
+
 									const int lightBinLightIndex = lightBin.lightIndices[lightIndex];
 									const SoftwareLight &light = g_visibleLights[lightBinLightIndex];
 									double lightIntensity = 0.0;
@@ -3582,36 +4983,93 @@ namespace
 								colorBufferSlice[i] = shaderPalette.colors[shadedTexel[i]];
 								totalColorWrites++;
 
+								if (shouldClearVisibility)
+								{
+									visibilityBufferSlice[i] = -1;
+								}
+
 								if constexpr (enableDepthWrite)
 								{
 									depthBufferSlice[i] = ndcZDepth[i];
+									isDepthTileWritten[binPixelX / RASTERIZER_TILE_WIDTH] = true;
 								}
 							}
 						}
 					}
 				}
+
+				// Refresh the tiles this row of tiles wrote to now that all their rows are done.
+				if constexpr (enableDepthWrite)
+				{
+					for (int binPixelX = binPixelXStart; binPixelX < binPixelXUnrollAdjustedEnd; binPixelX += RASTERIZER_TILE_WIDTH)
+					{
+						if (!isDepthTileWritten[binPixelX / RASTERIZER_TILE_WIDTH])
+						{
+							continue;
+						}
+
+						const int frameBufferTilePixelX = BinPixelToFrameBufferPixel(binX, binPixelX, rasterizerInputCache.binWidth);
+						const int depthTileIndex = (frameBufferTilePixelX / RASTERIZER_TILE_WIDTH) + (depthTileY * g_depthTileCountX);
+						UpdateDepthTile(depthBuffer, frameBufferTilePixelX, frameBufferPixelY[0], depthTileIndex, interlaceRowStart, interlaceRowStep);
+
+						// Keep the bin bounds conservative until the exact refresh at the end.
+						binDepthMin = std::min(binDepthMin, g_depthTileMins[depthTileIndex]);
+						binDepthMax = std::max(binDepthMax, g_depthTileMaxs[depthTileIndex]);
+						hasWrittenAnyDepth = true;
+					}
+				}
 			}
 		}
 
+		if (hasWrittenAnyDepth)
+		{
+			UpdateDepthBin(binX, binY, rasterizerInputCache.binWidth, rasterizerInputCache.binHeight, binIndex);
+		}
+
+		if (hasWrittenAnyVisibility)
+		{
+			g_visibilityBinHasPending[binIndex] = true;
+		}
+
 		g_totalCoverageTests += totalCoverageTests;
+		g_totalCoverageBlockAccepts += totalCoverageBlockAccepts;
 		g_totalDepthTests += totalDepthTests;
 		g_totalColorWrites += totalColorWrites;
+		g_totalShadedFragments += totalShadedFragments;
+		g_totalMipmappedFragments += totalMipmappedFragments;
+		g_totalLitFragments += totalLitFragments;
+		g_totalFragmentLightTests += totalFragmentLightTests;
 	}
 
-	template<RenderLightingType lightingType, FragmentShaderType fragmentShaderType, bool enableDepthRead, bool enableDepthWrite>
+	template<RenderLightingType lightingType, FragmentShaderType fragmentShaderType, bool enableDepthRead, bool enableDepthWrite, RasterPrecisionMode rasterPrecisionMode>
 	void RasterizeMeshDispatchDitheringMode(const DrawCallCache &drawCallCache, const RasterizerInputCache &rasterizerInputCache, const RasterizerBin &bin,
 		const RasterizerBinEntry &binEntry, int binX, int binY, int binIndex)
 	{
 		switch (g_ditheringMode)
 		{
 		case DitheringMode::None:
-			RasterizeMeshInternal<lightingType, fragmentShaderType, enableDepthRead, enableDepthWrite, DitheringMode::None>(drawCallCache, rasterizerInputCache, bin, binEntry, binX, binY, binIndex);
+			RasterizeMeshInternal<lightingType, fragmentShaderType, enableDepthRead, enableDepthWrite, DitheringMode::None, rasterPrecisionMode, false>(drawCallCache, rasterizerInputCache, bin, binEntry, binX, binY, binIndex);
 			break;
 		case DitheringMode::Classic:
-			RasterizeMeshInternal<lightingType, fragmentShaderType, enableDepthRead, enableDepthWrite, DitheringMode::Classic>(drawCallCache, rasterizerInputCache, bin, binEntry, binX, binY, binIndex);
+			RasterizeMeshInternal<lightingType, fragmentShaderType, enableDepthRead, enableDepthWrite, DitheringMode::Classic, rasterPrecisionMode, false>(drawCallCache, rasterizerInputCache, bin, binEntry, binX, binY, binIndex);
 			break;
 		case DitheringMode::Modern:
-			RasterizeMeshInternal<lightingType, fragmentShaderType, enableDepthRead, enableDepthWrite, DitheringMode::Modern>(drawCallCache, rasterizerInputCache, bin, binEntry, binX, binY, binIndex);
+			RasterizeMeshInternal<lightingType, fragmentShaderType, enableDepthRead, enableDepthWrite, DitheringMode::Modern, rasterPrecisionMode, false>(drawCallCache, rasterizerInputCache, bin, binEntry, binX, binY, binIndex);
+			break;
+		}
+	}
+
+	template<RenderLightingType lightingType, FragmentShaderType fragmentShaderType, bool enableDepthRead, bool enableDepthWrite>
+	void RasterizeMeshDispatchRasterPrecisionMode(const DrawCallCache &drawCallCache, const RasterizerInputCache &rasterizerInputCache, const RasterizerBin &bin,
+		const RasterizerBinEntry &binEntry, int binX, int binY, int binIndex)
+	{
+		switch (g_rasterPrecisionMode)
+		{
+		case RasterPrecisionMode::Double:
+			RasterizeMeshDispatchDitheringMode<lightingType, fragmentShaderType, enableDepthRead, enableDepthWrite, RasterPrecisionMode::Double>(drawCallCache, rasterizerInputCache, bin, binEntry, binX, binY, binIndex);
+			break;
+		case RasterPrecisionMode::Single:
+			RasterizeMeshDispatchDitheringMode<lightingType, fragmentShaderType, enableDepthRead, enableDepthWrite, RasterPrecisionMode::Single>(drawCallCache, rasterizerInputCache, bin, binEntry, binX, binY, binIndex);
 			break;
 		}
 	}
@@ -3627,22 +5085,22 @@ namespace
 		{
 			if (enableDepthWrite)
 			{
-				RasterizeMeshDispatchDitheringMode<lightingType, fragmentShaderType, true, true>(drawCallCache, rasterizerInputCache, bin, binEntry, binX, binY, binIndex);
+				RasterizeMeshDispatchRasterPrecisionMode<lightingType, fragmentShaderType, true, true>(drawCallCache, rasterizerInputCache, bin, binEntry, binX, binY, binIndex);
 			}
 			else
 			{
-				RasterizeMeshDispatchDitheringMode<lightingType, fragmentShaderType, true, false>(drawCallCache, rasterizerInputCache, bin, binEntry, binX, binY, binIndex);
+				RasterizeMeshDispatchRasterPrecisionMode<lightingType, fragmentShaderType, true, false>(drawCallCache, rasterizerInputCache, bin, binEntry, binX, binY, binIndex);
 			}
 		}
 		else
 		{
 			if (enableDepthWrite)
 			{
-				RasterizeMeshDispatchDitheringMode<lightingType, fragmentShaderType, false, true>(drawCallCache, rasterizerInputCache, bin, binEntry, binX, binY, binIndex);
+				RasterizeMeshDispatchRasterPrecisionMode<lightingType, fragmentShaderType, false, true>(drawCallCache, rasterizerInputCache, bin, binEntry, binX, binY, binIndex);
 			}
 			else
 			{
-				RasterizeMeshDispatchDitheringMode<lightingType, fragmentShaderType, false, false>(drawCallCache, rasterizerInputCache, bin, binEntry, binX, binY, binIndex);
+				RasterizeMeshDispatchRasterPrecisionMode<lightingType, fragmentShaderType, false, false>(drawCallCache, rasterizerInputCache, bin, binEntry, binX, binY, binIndex);
 			}
 		}
 	}
@@ -3695,10 +5153,54 @@ namespace
 		}
 	}
 
+	// Opaque depth-writing draw calls are the only ones whose shading can wait until the closest triangle is known.
+	bool IsVisibilityBufferDrawCall(const DrawCallCache &drawCallCache)
+	{
+		if (!drawCallCache.enableDepthRead || !drawCallCache.enableDepthWrite)
+		{
+			return false;
+		}
+
+		const FragmentShaderType fragmentShaderType = drawCallCache.fragmentShaderType;
+		return (fragmentShaderType == FragmentShaderType::Opaque) ||
+			(fragmentShaderType == FragmentShaderType::OpaqueWithAlphaTestLayer) ||
+			(fragmentShaderType == FragmentShaderType::OpaqueScreenSpaceAnimation) ||
+			(fragmentShaderType == FragmentShaderType::OpaqueScreenSpaceAnimationWithAlphaTestLayer);
+	}
+
+	// Shaders that read the frame buffer need pending visibility buffer pixels under them shaded first.
+	bool DoesFragmentShaderReadFrameBuffer(FragmentShaderType fragmentShaderType)
+	{
+		return (fragmentShaderType == FragmentShaderType::AlphaTestedWithLightLevelOpacity) ||
+			(fragmentShaderType == FragmentShaderType::AlphaTestedWithPreviousBrightnessLimit) ||
+			(fragmentShaderType == FragmentShaderType::AlphaTestedWithHorizonMirrorSecondPass);
+	}
+
+	// The shading template parameters are placeholders since the visibility pass stops after depth.
+	void RasterizeMeshVisibility(const DrawCallCache &drawCallCache, const RasterizerInputCache &rasterizerInputCache, const RasterizerBin &bin,
+		const RasterizerBinEntry &binEntry, int binX, int binY, int binIndex)
+	{
+		switch (g_rasterPrecisionMode)
+		{
+		case RasterPrecisionMode::Double:
+			RasterizeMeshInternal<RenderLightingType::PerMesh, FragmentShaderType::Opaque, true, true, DitheringMode::None, RasterPrecisionMode::Double, true>(drawCallCache, rasterizerInputCache, bin, binEntry, binX, binY, binIndex);
+			break;
+		case RasterPrecisionMode::Single:
+			RasterizeMeshInternal<RenderLightingType::PerMesh, FragmentShaderType::Opaque, true, true, DitheringMode::None, RasterPrecisionMode::Single, true>(drawCallCache, rasterizerInputCache, bin, binEntry, binX, binY, binIndex);
+			break;
+		}
+	}
+
 	// Decides which optimized rasterizer variant to use based on the parameters.
 	void RasterizeMesh(const DrawCallCache &drawCallCache, const RasterizerInputCache &rasterizerInputCache, const RasterizerBin &bin,
 		const RasterizerBinEntry &binEntry, int binX, int binY, int binIndex)
 	{
+		if ((g_shadingMode == ShadingMode::VisibilityBuffer) && IsVisibilityBufferDrawCall(drawCallCache))
+		{
+			RasterizeMeshVisibility(drawCallCache, rasterizerInputCache, bin, binEntry, binX, binY, binIndex);
+			return;
+		}
+
 		static_assert(RenderLightingType::PerPixel == RENDER_LIGHTING_TYPE_MAX);
 		const RenderLightingType lightingType = drawCallCache.lightingType;
 
@@ -3712,6 +5214,173 @@ namespace
 			break;
 		}
 	}
+
+	// Shades one pixel left behind by the visibility pass, the same math as RasterizeMeshInternal() for opaque shaders.
+	// Returns whether a texture was sampled from a downsampled mip level. Also writes how many lights the pixel was tested against.
+	template<DitheringMode ditheringMode>
+	bool ShadeVisibilityBufferPixel(const DrawCallCache &drawCallCache, const RasterizerTriangle &triangle, int frameBufferPixelX, int frameBufferPixelY,
+		int frameBufferPixelIndex, int lightBinWidth, int lightBinHeight, int *outLightTestCount)
+	{
+		*outLightTestCount = 0;
+
+		const FragmentShaderType fragmentShaderType = drawCallCache.fragmentShaderType;
+		const bool requiresLayerAlphaTest =
+			(fragmentShaderType == FragmentShaderType::OpaqueWithAlphaTestLayer) ||
+			(fragmentShaderType == FragmentShaderType::OpaqueScreenSpaceAnimationWithAlphaTestLayer);
+		const bool requiresScreenSpaceAnimationTexelMain =
+			(fragmentShaderType == FragmentShaderType::OpaqueScreenSpaceAnimation) ||
+			(fragmentShaderType == FragmentShaderType::OpaqueScreenSpaceAnimationWithAlphaTestLayer);
+
+		const double frameBufferPercentX = (static_cast<double>(frameBufferPixelX) + 0.50) * g_frameBufferWidthRealRecip;
+		const double frameBufferPercentY = (static_cast<double>(frameBufferPixelY) + 0.50) * g_frameBufferHeightRealRecip;
+		const double pixelCenterX = frameBufferPercentX * g_frameBufferWidthReal;
+		const double pixelCenterY = frameBufferPercentY * g_frameBufferHeightReal;
+
+		// Barycentric coordinates.
+		const double screenSpace02X = -triangle.screenSpace20X;
+		const double screenSpace02Y = -triangle.screenSpace20Y;
+		const double barycentricDot00 = (triangle.screenSpace01X * triangle.screenSpace01X) + (triangle.screenSpace01Y * triangle.screenSpace01Y);
+		const double barycentricDot01 = (triangle.screenSpace01X * screenSpace02X) + (triangle.screenSpace01Y * screenSpace02Y);
+		const double barycentricDot11 = (screenSpace02X * screenSpace02X) + (screenSpace02Y * screenSpace02Y);
+		const double barycentricDenominatorRecip = 1.0 / ((barycentricDot00 * barycentricDot11) - (barycentricDot01 * barycentricDot01));
+		const double screenSpace0CurrentX = pixelCenterX - triangle.screenSpace0X;
+		const double screenSpace0CurrentY = pixelCenterY - triangle.screenSpace0Y;
+		const double barycentricDot20 = (screenSpace0CurrentX * triangle.screenSpace01X) + (screenSpace0CurrentY * triangle.screenSpace01Y);
+		const double barycentricDot21 = (screenSpace0CurrentX * screenSpace02X) + (screenSpace0CurrentY * screenSpace02Y);
+		const double v = ((barycentricDot11 * barycentricDot20) - (barycentricDot01 * barycentricDot21)) * barycentricDenominatorRecip;
+		const double w = ((barycentricDot00 * barycentricDot21) - (barycentricDot01 * barycentricDot20)) * barycentricDenominatorRecip;
+		const double u = 1.0 - v - w;
+
+		// Texture lookup.
+		const double shaderClipSpacePointW = (triangle.clip0WRecip * u) + (triangle.clip1WRecip * v) + (triangle.clip2WRecip * w);
+		const double shaderClipSpacePointWRecip = 1.0 / shaderClipSpacePointW;
+		const double perspectiveTexCoordU = ((triangle.uv0XDivW * u) + (triangle.uv1XDivW * v) + (triangle.uv2XDivW * w)) * shaderClipSpacePointWRecip;
+		const double perspectiveTexCoordV = ((triangle.uv0YDivW * u) + (triangle.uv1YDivW * v) + (triangle.uv2YDivW * w)) * shaderClipSpacePointWRecip;
+
+		const SoftwareObjectTexture &texture0 = g_objectTextures->get(drawCallCache.textureID0);
+		FragmentShaderTexture shaderTexture0;
+		bool isMipmapped = false;
+
+		uint8_t mainTexel;
+		if (requiresScreenSpaceAnimationTexelMain)
+		{
+			shaderTexture0.init(texture0.texels8Bit, texture0.width, texture0.height);
+			GetScreenSpaceAnimationTexel_N<1>(shaderTexture0, g_screenSpaceAnimPercent, &frameBufferPercentX, frameBufferPercentY, &mainTexel);
+		}
+		else
+		{
+			const int mipLevel0 = GetTriangleMipLevel(triangle, texture0);
+			shaderTexture0.initMipLevel(texture0, mipLevel0, g_enableTiledTexels);
+			isMipmapped = mipLevel0 > 0;
+			GetPerspectiveTexel_N<1>(shaderTexture0, &perspectiveTexCoordU, &perspectiveTexCoordV, &mainTexel);
+		}
+
+		if (requiresLayerAlphaTest)
+		{
+			const SoftwareObjectTexture &texture1 = g_objectTextures->get(drawCallCache.textureID1);
+			const int mipLevel1 = GetTriangleMipLevel(triangle, texture1);
+			FragmentShaderTexture shaderTexture1;
+			shaderTexture1.initMipLevel(texture1, mipLevel1, g_enableTiledTexels);
+			isMipmapped |= mipLevel1 > 0;
+
+			uint8_t layerTexel;
+			GetPerspectiveTexel_N<1>(shaderTexture1, &perspectiveTexCoordU, &perspectiveTexCoordV, &layerTexel);
+			if (layerTexel != ArenaRenderUtils::PALETTE_INDEX_TRANSPARENT)
+			{
+				mainTexel = layerTexel;
+			}
+		}
+
+		// Lighting.
+		const uint8_t *lightTableTexels = g_lightTableTexture->texels8Bit;
+		const int lightLevelCount = g_lightTableTexture->height;
+		const int lastLightLevel = lightLevelCount - 1;
+		const int texelsPerLightLevel = g_lightTableTexture->width;
+
+		double lightIntensitySum;
+		if (drawCallCache.lightingType == RenderLightingType::PerPixel)
+		{
+			const double shaderHomogeneousSpacePointX = ((triangle.ndc0X * u) + (triangle.ndc1X * v) + (triangle.ndc2X * w)) * shaderClipSpacePointWRecip;
+			const double shaderHomogeneousSpacePointY = ((triangle.ndc0Y * u) + (triangle.ndc1Y * v) + (triangle.ndc2Y * w)) * shaderClipSpacePointWRecip;
+			const double shaderHomogeneousSpacePointZ = ((triangle.ndc0Z * u) + (triangle.ndc1Z * v) + (triangle.ndc2Z * w)) * shaderClipSpacePointWRecip;
+			const double shaderHomogeneousSpacePointW = shaderClipSpacePointWRecip;
+			double shaderCameraSpacePointX = 0.0;
+			double shaderCameraSpacePointY = 0.0;
+			double shaderCameraSpacePointZ = 0.0;
+			double shaderCameraSpacePointW = 0.0;
+			double shaderWorldSpacePointX = 0.0;
+			double shaderWorldSpacePointY = 0.0;
+			double shaderWorldSpacePointZ = 0.0;
+
+			Matrix4_MultiplyVectorN<1>(
+				g_invProjMatrixXX, g_invProjMatrixXY, g_invProjMatrixXZ, g_invProjMatrixXW,
+				g_invProjMatrixYX, g_invProjMatrixYY, g_invProjMatrixYZ, g_invProjMatrixYW,
+				g_invProjMatrixZX, g_invProjMatrixZY, g_invProjMatrixZZ, g_invProjMatrixZW,
+				g_invProjMatrixWX, g_invProjMatrixWY, g_invProjMatrixWZ, g_invProjMatrixWW,
+				&shaderHomogeneousSpacePointX, &shaderHomogeneousSpacePointY, &shaderHomogeneousSpacePointZ, &shaderHomogeneousSpacePointW,
+				&shaderCameraSpacePointX, &shaderCameraSpacePointY, &shaderCameraSpacePointZ, &shaderCameraSpacePointW);
+
+			Matrix4_MultiplyVectorIgnoreW_N<1>(
+				g_invViewMatrixXX, g_invViewMatrixXY, g_invViewMatrixXZ,
+				g_invViewMatrixYX, g_invViewMatrixYY, g_invViewMatrixYZ,
+				g_invViewMatrixZX, g_invViewMatrixZY, g_invViewMatrixZZ,
+				g_invViewMatrixWX, g_invViewMatrixWY, g_invViewMatrixWZ,
+				&shaderCameraSpacePointX, &shaderCameraSpacePointY, &shaderCameraSpacePointZ, &shaderCameraSpacePointW,
+				&shaderWorldSpacePointX, &shaderWorldSpacePointY, &shaderWorldSpacePointZ);
+
+			lightIntensitySum = g_ambientPercent;
+
+			const int lightBinX = GetLightBinX(frameBufferPixelX, lightBinWidth);
+			const int lightBinY = GetLightBinY(frameBufferPixelY, lightBinHeight);
+			const LightBin &lightBin = g_lightBins.get(lightBinX, lightBinY);
+			const double shaderViewDepth = ((shaderWorldSpacePointX - g_camera.floatingWorldPoint.x) * g_camera.forward.x) +
+				((shaderWorldSpacePointY - g_camera.floatingWorldPoint.y) * g_camera.forward.y) + ((shaderWorldSpacePointZ - g_camera.floatingWorldPoint.z) * g_camera.forward.z);
+			LightBinLightMask lightMask = lightBin.depthSliceLightMasks[GetLightBinDepthSlice(shaderViewDepth)];
+			while (lightMask != 0)
+			{
+				const int lightIndex = std::countr_zero(lightMask);
+				lightMask &= lightMask - 1;
+				(*outLightTestCount)++;
+
+				const int lightBinLightIndex = lightBin.lightIndices[lightIndex];
+				const SoftwareLight &light = g_visibleLights[lightBinLightIndex];
+				double lightIntensity = 0.0;
+				GetWorldSpaceLightIntensityValue(shaderWorldSpacePointX, shaderWorldSpacePointY, shaderWorldSpacePointZ, light, &lightIntensity);
+				lightIntensitySum += lightIntensity;
+				if (lightIntensitySum >= 1.0)
+				{
+					lightIntensitySum = 1.0;
+					break;
+				}
+			}
+		}
+		else
+		{
+			lightIntensitySum = drawCallCache.meshLightPercent;
+		}
+
+		const double lightLevelReal = lightIntensitySum * static_cast<double>(lightLevelCount);
+		const int lightLevelClamped = std::clamp(static_cast<int>(lightLevelReal), 0, lastLightLevel);
+		int lightLevel = lastLightLevel - lightLevelClamped;
+
+		if (drawCallCache.lightingType == RenderLightingType::PerPixel)
+		{
+			bool shouldDither;
+			GetScreenSpaceDitherValue<ditheringMode>(lightLevelReal, lightIntensitySum, frameBufferPixelX, frameBufferPixelY,
+				g_ditherTexture->texels8Bit, g_ditherTexture->width, g_ditherTexture->height, &shouldDither);
+
+			if (shouldDither)
+			{
+				lightLevel = std::min(lightLevel + 1, lastLightLevel);
+			}
+		}
+
+		// Shading.
+		const uint8_t shadedTexel = lightTableTexels[mainTexel + (lightLevel * texelsPerLightLevel)];
+		g_paletteIndexBuffer[frameBufferPixelIndex] = shadedTexel;
+		g_colorBuffer[frameBufferPixelIndex] = g_paletteTexture->texels32Bit[shadedTexel];
+		return isMipmapped;
+	}
 }
 
 // Multi-threading utils.
@@ -3721,59 +5390,586 @@ namespace
 	{
 		std::thread thread;
 
-		DrawCallCache drawCallCaches[MAX_WORKER_DRAW_CALLS_PER_LOOP];
-		TransformCache transformCaches[MAX_WORKER_DRAW_CALLS_PER_LOOP];
+		// This loop's draw call instance range, read in place from the frame packet. Transforms are copied per instance
+		// since the vertex shader transforms are written into them.
+		const DrawCallCache *drawCallCaches; // All of the frame's, indexed by each instance.
+		const DrawCallInstance *drawCallInstances;
+		const TransformCache *transformCaches;
 		int drawCallStartIndex, drawCallCount;
 
 		VertexShaderInputCache vertexShaderInputCache;
 		VertexShaderOutputCache vertexShaderOutputCache;
 		ClippingOutputCache clippingOutputCache;
 		RasterizerInputCache rasterizerInputCache;
-		std::vector<RasterizerWorkItem> rasterizerWorkItems;
-		bool isReadyToStartWork, shouldExit, shouldWorkOnDrawCalls, shouldClearFrameBuffer, isFinishedWithDrawCalls, shouldWorkOnRasterizing, isFinishedRasterizing;
+		double busyTime; // Seconds spent on geometry and rasterization this frame, the rest of the frame is spent waiting.
+		double stageTimes[RENDERER_PROFILER_STAGE_COUNT]; // Seconds per RendererProfilerStage this frame, only with stage timers on.
+		bool shouldClearFrameBuffer;
+		int cpuID; // Logical CPU the thread is pinned to, -1 if the OS schedules it freely.
+	};
+
+	// Stages of each draw call loop. The director releases all workers into one at a time.
+	enum class WorkerPhase
+	{
+		PacketFill, // Per-instance part of submitting a frame, only while no frame is rendering.
+		DrawCalls,
+		Rasterizing,
+		Exit
 	};
 
 	Buffer<Worker> g_workers;
-	std::mutex g_mutex;
-	std::condition_variable g_workerCondVar, g_directorCondVar;
 
-	void WorkerFunc(int workerIndex)
+	const DrawCallCache &GetWorkerDrawCallCache(const Worker &worker, int workerDrawCallIndex)
 	{
-		Worker &worker = g_workers.get(workerIndex);
-		std::unique_lock<std::mutex> workerLock(g_mutex);
+		const DrawCallInstance &drawCallInstance = worker.drawCallInstances[workerDrawCallIndex];
+		return worker.drawCallCaches[drawCallInstance.drawCallCacheIndex];
+	}
 
-		while (true)
-		{
-			worker.isReadyToStartWork = true;
-			g_directorCondVar.notify_one();
-			g_workerCondVar.wait(workerLock, [&worker]() { return worker.shouldExit || worker.shouldWorkOnDrawCalls; });
-			workerLock.unlock();
+	// Director -> workers handoff. The director writes the phase then bumps the epoch, workers wait for the epoch to change.
+	WorkerPhase g_workerPhase;
+	std::atomic<uint32_t> g_workerEpoch;
+	std::atomic<int> g_parkedWorkerCount; // Workers asleep on the epoch. The director only pays for a wake-up when non-zero.
 
-			if (worker.shouldExit)
-			{
-				break;
-			}
+	// Workers -> director handoff. The last worker to finish a phase wakes the director if it stopped spinning.
+	std::atomic<int> g_remainingWorkerCount;
+	std::atomic<int> g_parkedDirectorCount;
 
-			for (int drawCallIndex = 0; drawCallIndex < worker.drawCallCount; drawCallIndex++)
-			{
-				DebugAssertIndex(worker.drawCallCaches, drawCallIndex);
-				const DrawCallCache &drawCallCache = worker.drawCallCaches[drawCallIndex];
-				TransformCache &transformCache = worker.transformCaches[drawCallIndex];
-				VertexShaderInputCache &vertexShaderInputCache = worker.vertexShaderInputCache;
-				VertexShaderOutputCache &vertexShaderOutputCache = worker.vertexShaderOutputCache;
-				ClippingOutputCache &clippingOutputCache = worker.clippingOutputCache;
-				RasterizerInputCache &rasterizerInputCache = worker.rasterizerInputCache;
+	std::atomic<int> g_workerSpinMicroseconds; // How long a waiting thread busy-waits before sleeping.
 
-				ProcessMeshBufferLookups(drawCallCache, vertexShaderInputCache);
-				CalculateVertexShaderTransforms(transformCache);
-				ProcessVertexShaders(drawCallCache.vertexShaderType, transformCache, vertexShaderInputCache, vertexShaderOutputCache);
-				ProcessClipping(drawCallCache, vertexShaderOutputCache, clippingOutputCache);
-				ProcessClipSpaceTrianglesForBinning(drawCallIndex, drawCallCache.enableBackFaceCulling, clippingOutputCache, rasterizerInputCache);
-			}
+	// All rasterizer bins, sorted by estimated cost so the most expensive ones get started first. Workers pull from this
+	// until it's empty instead of owning a fixed set of bins.
+	std::vector<RasterizerWorkItem> g_rasterizerWorkItems;
+	std::atomic<int> g_nextRasterizerWorkItemIndex;
 
-			// Clear screen before rasterization sync as frame buffer rows are faster than bin rows.
-			if (worker.shouldClearFrameBuffer)
-			{
+	Buffer<int> g_binTriangleCounts; // Triangles touching each bin this frame, summed across workers.
+	Buffer<int> g_prevBinTriangleCounts; // Last frame's counts, used as the cost estimate for ordering work items.
+
+	// Bins are split when the busiest one gets expensive or takes more than a thread's share of the frame, and merged when
+	// even the busiest one is cheap. The gap between the two keeps the layout from flipping back and forth.
+	constexpr int RASTERIZER_DENSE_BIN_TRIANGLE_COUNT = RASTERIZER_BIN_MAX_TRIANGLES / 8;
+	constexpr int RASTERIZER_SPARSE_BIN_TRIANGLE_COUNT = RASTERIZER_DENSE_BIN_TRIANGLE_COUNT / 16;
+	constexpr int RASTERIZER_IMBALANCED_BIN_TRIANGLE_COUNT = RASTERIZER_SPARSE_BIN_TRIANGLE_COUNT * 4;
+	constexpr int RASTERIZER_MIN_BINS_PER_WORKER = 4; // Merging stops here so threads can still balance.
+
+	int g_rasterizerBinScaleLevel = 0; // Current step away from the resolution-based bin dimensions.
+
+	// Per-instance packet arrays being filled while submitting. Workers pull ranges of instances until they run out.
+	struct PacketFillWork
+	{
+		const DrawCallCache *drawCallCaches;
+		const DrawCallInstanceSource *drawCallInstanceSources;
+		DrawCallInstance *drawCallInstances;
+		TransformCache *transformCaches;
+		DrawCallSortKey *drawCallSortKeys;
+		const RenderCamera *camera;
+		int instanceCount;
+	};
+
+	constexpr int PACKET_FILL_INSTANCES_PER_WORK_ITEM = 256;
+	constexpr int PACKET_FILL_MIN_WORKER_INSTANCES = PACKET_FILL_INSTANCES_PER_WORK_ITEM * 8; // Fewer aren't worth waking workers for.
+
+	PacketFillWork g_packetFillWork;
+	std::atomic<int> g_nextPacketFillInstanceIndex;
+
+	double g_workerFrameTime; // Seconds the director spent waiting on workers this frame.
+	bool g_enableStageTimers = false; // Only read between phases, workers skip every stage clock read when off.
+
+	bool g_areWorkersPinned = false;
+
+	double GetElapsedSeconds(const std::chrono::high_resolution_clock::time_point &startTime)
+	{
+		const auto endTime = std::chrono::high_resolution_clock::now();
+		return static_cast<double>((endTime - startTime).count()) / static_cast<double>(std::nano::den);
+	}
+
+	// Adds the time since the previous mark to a stage and moves the mark up to now.
+	void MarkWorkerStageTime(Worker &worker, RendererProfilerStage stage, std::chrono::high_resolution_clock::time_point &markTime)
+	{
+		const auto nowTime = std::chrono::high_resolution_clock::now();
+		worker.stageTimes[static_cast<int>(stage)] += static_cast<double>((nowTime - markTime).count()) / static_cast<double>(std::nano::den);
+		markTime = nowTime;
+	}
+
+	void PauseSpinningThread()
+	{
+#if defined(SOFTWARE_RENDERER_SIMD_X64)
+		_mm_pause();
+#elif defined(SOFTWARE_RENDERER_SIMD_ARM64) && (defined(__GNUC__) || defined(__clang__))
+		__asm__ __volatile__("yield");
+#endif
+	}
+
+	// Busy-waits until the atomic's value satisfies the predicate or the spin budget runs out, then sleeps on it until
+	// notified. Handoffs between frame stages are short enough that a futex wake-up would cost more than the work itself.
+	template<typename T, typename IsDoneFunc>
+	T SpinThenPark(std::atomic<T> &value, std::atomic<int> &parkedCount, const IsDoneFunc &isDone)
+	{
+		T currentValue = value.load(std::memory_order_acquire);
+		if (isDone(currentValue))
+		{
+			return currentValue;
+		}
+
+		const int spinMicroseconds = g_workerSpinMicroseconds.load(std::memory_order_relaxed);
+		if (spinMicroseconds > 0)
+		{
+			constexpr int spinsPerClockCheck = 64;
+			const auto spinEndTime = std::chrono::high_resolution_clock::now() + std::chrono::microseconds(spinMicroseconds);
+			for (int spinCount = 1; ; spinCount++)
+			{
+				PauseSpinningThread();
+				currentValue = value.load(std::memory_order_acquire);
+				if (isDone(currentValue))
+				{
+					return currentValue;
+				}
+
+				if (((spinCount % spinsPerClockCheck) == 0) && (std::chrono::high_resolution_clock::now() >= spinEndTime))
+				{
+					break;
+				}
+			}
+		}
+
+		// Announce parking before the last check so the notifier either sees this thread parked or this thread sees its store.
+		parkedCount.fetch_add(1, std::memory_order_seq_cst);
+		currentValue = value.load(std::memory_order_seq_cst);
+		while (!isDone(currentValue))
+		{
+			value.wait(currentValue, std::memory_order_acquire);
+			currentValue = value.load(std::memory_order_acquire);
+		}
+
+		parkedCount.fetch_sub(1, std::memory_order_relaxed);
+		return currentValue;
+	}
+
+	// Wakes threads sleeping in SpinThenPark() on this atomic. Must follow a sequentially-consistent store to it.
+	template<typename T>
+	void NotifyParkedThreads(std::atomic<T> &value, const std::atomic<int> &parkedCount)
+	{
+		if (parkedCount.load(std::memory_order_seq_cst) > 0)
+		{
+			value.notify_all();
+		}
+	}
+
+	uint32_t WaitForWorkerPhase(uint32_t workerEpoch)
+	{
+		return SpinThenPark(g_workerEpoch, g_parkedWorkerCount, [workerEpoch](uint32_t epoch) { return epoch != workerEpoch; });
+	}
+
+	void FinishWorkerPhase()
+	{
+		if (g_remainingWorkerCount.fetch_sub(1, std::memory_order_seq_cst) == 1)
+		{
+			NotifyParkedThreads(g_remainingWorkerCount, g_parkedDirectorCount);
+		}
+	}
+
+	// Releases all workers into the phase and waits for every one of them to finish it.
+	void RunWorkerPhase(WorkerPhase phase)
+	{
+		g_remainingWorkerCount.store(g_workers.getCount(), std::memory_order_relaxed);
+		g_workerPhase = phase;
+		g_workerEpoch.fetch_add(1, std::memory_order_seq_cst);
+		NotifyParkedThreads(g_workerEpoch, g_parkedWorkerCount);
+
+		SpinThenPark(g_remainingWorkerCount, g_parkedDirectorCount, [](int remainingWorkerCount) { return remainingWorkerCount == 0; });
+	}
+
+	template<DitheringMode ditheringMode>
+	void ResolveVisibilityBufferBinInternal(int binX, int binY, int binWidth, int binHeight)
+	{
+		const int lightBinWidth = GetLightBinWidth(g_frameBufferWidth);
+		const int lightBinHeight = GetLightBinHeight(g_frameBufferHeight);
+		const int frameBufferPixelXStart = BinPixelToFrameBufferPixel(binX, 0, binWidth);
+		const int frameBufferPixelXEnd = std::min(frameBufferPixelXStart + binWidth, g_frameBufferWidth);
+		const int frameBufferPixelYStart = BinPixelToFrameBufferPixel(binY, 0, binHeight);
+		const int frameBufferPixelYEnd = std::min(frameBufferPixelYStart + binHeight, g_frameBufferHeight);
+
+		int totalShadedFragments = 0;
+		int totalMipmappedFragments = 0;
+		int totalLitFragments = 0;
+		int totalFragmentLightTests = 0;
+		for (int frameBufferPixelY = frameBufferPixelYStart; frameBufferPixelY < frameBufferPixelYEnd; frameBufferPixelY++)
+		{
+			for (int frameBufferPixelX = frameBufferPixelXStart; frameBufferPixelX < frameBufferPixelXEnd; frameBufferPixelX++)
+			{
+				const int frameBufferPixelIndex = frameBufferPixelX + (frameBufferPixelY * g_frameBufferWidth);
+				const int32_t visibilityID = g_visibilityBuffer[frameBufferPixelIndex];
+				if (visibilityID < 0)
+				{
+					continue;
+				}
+
+				const int workerIndex = visibilityID / RasterizerInputCache::MAX_FRUSTUM_TRIANGLES;
+				const int triangleIndex = visibilityID % RasterizerInputCache::MAX_FRUSTUM_TRIANGLES;
+				const Worker &geometryWorker = g_workers[workerIndex];
+				const RasterizerTriangle &triangle = geometryWorker.rasterizerInputCache.triangles[triangleIndex];
+				DebugAssert(triangle.workerDrawCallIndex < geometryWorker.drawCallCount);
+				const DrawCallCache &drawCallCache = GetWorkerDrawCallCache(geometryWorker, triangle.workerDrawCallIndex);
+				int lightTestCount;
+				const bool isMipmapped = ShadeVisibilityBufferPixel<ditheringMode>(drawCallCache, triangle, frameBufferPixelX, frameBufferPixelY,
+					frameBufferPixelIndex, lightBinWidth, lightBinHeight, &lightTestCount);
+				totalMipmappedFragments += isMipmapped ? 1 : 0;
+				totalLitFragments += (drawCallCache.lightingType == RenderLightingType::PerPixel) ? 1 : 0;
+				totalFragmentLightTests += lightTestCount;
+
+				g_visibilityBuffer[frameBufferPixelIndex] = -1;
+				totalShadedFragments++;
+			}
+		}
+
+		g_totalColorWrites += totalShadedFragments;
+		g_totalShadedFragments += totalShadedFragments;
+		g_totalMipmappedFragments += totalMipmappedFragments;
+		g_totalLitFragments += totalLitFragments;
+		g_totalFragmentLightTests += totalFragmentLightTests;
+	}
+
+	// Shades every pixel in the bin the visibility pass left a triangle in. Must run before the triangles it refers to are
+	// overwritten by the next draw call loop.
+	void ResolveVisibilityBufferBin(int binX, int binY, int binWidth, int binHeight, int binIndex)
+	{
+		if (!g_visibilityBinHasPending[binIndex])
+		{
+			return;
+		}
+
+		switch (g_ditheringMode)
+		{
+		case DitheringMode::None:
+			ResolveVisibilityBufferBinInternal<DitheringMode::None>(binX, binY, binWidth, binHeight);
+			break;
+		case DitheringMode::Classic:
+			ResolveVisibilityBufferBinInternal<DitheringMode::Classic>(binX, binY, binWidth, binHeight);
+			break;
+		case DitheringMode::Modern:
+			ResolveVisibilityBufferBinInternal<DitheringMode::Modern>(binX, binY, binWidth, binHeight);
+			break;
+		}
+
+		g_visibilityBinHasPending[binIndex] = false;
+	}
+
+	// Inverse of the perspective matrix depth mapping. Cleared depth counts as the far plane.
+	double NdcZToViewDepth(double ndcZ)
+	{
+		if (!std::isfinite(ndcZ))
+		{
+			return RendererUtils::FAR_PLANE;
+		}
+
+		constexpr double nearPlane = RendererUtils::NEAR_PLANE;
+		constexpr double farPlane = RendererUtils::FAR_PLANE;
+		return (nearPlane * farPlane) / (farPlane - (ndcZ * (farPlane - nearPlane)));
+	}
+
+	// Sets up this frame's interlaced row parity and reprojection, or full frames if there's no usable history.
+	// Returns whether this frame gets saved as history for the next one.
+	bool PrepareInterlacing(bool isEnabled, int frameBufferWidth, int frameBufferHeight, uint32_t frameID)
+	{
+		g_interlaceRowParity = -1;
+
+		if (!isEnabled)
+		{
+			g_isInterlaceHistoryValid = false;
+			return false;
+		}
+
+		for (int i = 0; i < 2; i++)
+		{
+			Buffer2D<uint8_t> &historyPaletteIndexBuffer = g_interlaceHistoryPaletteIndexBuffers[i];
+			if ((historyPaletteIndexBuffer.getWidth() != frameBufferWidth) || (historyPaletteIndexBuffer.getHeight() != frameBufferHeight))
+			{
+				historyPaletteIndexBuffer.init(frameBufferWidth, frameBufferHeight);
+				g_interlaceHistoryDepthBuffers[i].init(frameBufferWidth, frameBufferHeight);
+				g_isInterlaceHistoryValid = false;
+			}
+		}
+
+		if (g_isInterlaceHistoryValid)
+		{
+			g_interlaceRowParity = static_cast<int>(frameID % 2);
+			g_interlaceReprojectionMatrix = g_interlaceHistoryViewProjMatrix * Matrix4d::inverse(g_viewProjMatrix);
+		}
+
+		return true;
+	}
+
+	// Finds where a pixel at the given depth was in the history frame, and its view depth there.
+	bool TryReprojectInterlacedPixel(int frameBufferPixelX, int frameBufferPixelY, double ndcZ, int *outHistoryPixelIndex, double *outHistoryViewDepth)
+	{
+		const double ndcX = (((static_cast<double>(frameBufferPixelX) + 0.50) * g_frameBufferWidthRealRecip) * 2.0) - 1.0;
+		const double ndcY = 1.0 - (((static_cast<double>(frameBufferPixelY) + 0.50) * g_frameBufferHeightRealRecip) * 2.0);
+		const Double4 historyClipPoint = g_interlaceReprojectionMatrix * Double4(ndcX, ndcY, ndcZ, 1.0);
+		if (historyClipPoint.w <= 0.0)
+		{
+			return false;
+		}
+
+		const double historyClipWRecip = 1.0 / historyClipPoint.w;
+		const double historyScreenSpaceX = NdcXToScreenSpace(historyClipPoint.x * historyClipWRecip, g_frameBufferWidthReal);
+		const double historyScreenSpaceY = NdcYToScreenSpace(historyClipPoint.y * historyClipWRecip, g_frameBufferHeightReal);
+		if ((historyScreenSpaceX < 0.0) || (historyScreenSpaceX >= g_frameBufferWidthReal) ||
+			(historyScreenSpaceY < 0.0) || (historyScreenSpaceY >= g_frameBufferHeightReal))
+		{
+			return false;
+		}
+
+		const int historyPixelX = static_cast<int>(historyScreenSpaceX);
+		const int historyPixelY = static_cast<int>(historyScreenSpaceY);
+		*outHistoryPixelIndex = historyPixelX + (historyPixelY * g_frameBufferWidth);
+		*outHistoryViewDepth = NdcZToViewDepth(historyClipPoint.z * historyClipWRecip);
+		return true;
+	}
+
+	// Fills the rows this frame skipped by reprojecting the history frame at the depth of the shaded rows next to them, falling
+	// back to repeating a shaded row where the history frame saw something else. Then saves the bin as history for the next frame.
+	// Only palette indices are carried over so reconstructed pixels stay on the palette.
+	template<typename Real>
+	void FinishInterlacedBinInternal(const Real *depthBuffer, int binX, int binY, int binWidth, int binHeight)
+	{
+		const int frameBufferPixelXStart = BinPixelToFrameBufferPixel(binX, 0, binWidth);
+		const int frameBufferPixelXEnd = std::min(frameBufferPixelXStart + binWidth, g_frameBufferWidth);
+		const int frameBufferPixelYStart = BinPixelToFrameBufferPixel(binY, 0, binHeight);
+		const int frameBufferPixelYEnd = std::min(frameBufferPixelYStart + binHeight, g_frameBufferHeight);
+
+		const uint8_t *historyPaletteIndexBuffer = g_interlaceHistoryPaletteIndexBuffers[g_interlaceHistoryReadIndex].begin();
+		const float *historyDepthBuffer = g_interlaceHistoryDepthBuffers[g_interlaceHistoryReadIndex].begin();
+		uint8_t *nextHistoryPaletteIndexBuffer = g_interlaceHistoryPaletteIndexBuffers[g_interlaceHistoryReadIndex ^ 1].begin();
+		float *nextHistoryDepthBuffer = g_interlaceHistoryDepthBuffers[g_interlaceHistoryReadIndex ^ 1].begin();
+		const uint32_t *paletteColors = g_paletteTexture->texels32Bit;
+
+		for (int frameBufferPixelY = frameBufferPixelYStart; frameBufferPixelY < frameBufferPixelYEnd; frameBufferPixelY++)
+		{
+			const bool isRowShaded = (g_interlaceRowParity < 0) || ((frameBufferPixelY % 2) == g_interlaceRowParity);
+
+			// Shaded rows to take depth from. Other bins might not be done yet so these stay inside this one.
+			int neighborPixelYs[2];
+			int neighborCount = 0;
+			if (!isRowShaded)
+			{
+				if (frameBufferPixelY > frameBufferPixelYStart)
+				{
+					neighborPixelYs[neighborCount] = frameBufferPixelY - 1;
+					neighborCount++;
+				}
+
+				if ((frameBufferPixelY + 1) < frameBufferPixelYEnd)
+				{
+					neighborPixelYs[neighborCount] = frameBufferPixelY + 1;
+					neighborCount++;
+				}
+			}
+
+			for (int frameBufferPixelX = frameBufferPixelXStart; frameBufferPixelX < frameBufferPixelXEnd; frameBufferPixelX++)
+			{
+				const int frameBufferPixelIndex = frameBufferPixelX + (frameBufferPixelY * g_frameBufferWidth);
+				if (isRowShaded)
+				{
+					nextHistoryPaletteIndexBuffer[frameBufferPixelIndex] = g_paletteIndexBuffer[frameBufferPixelIndex];
+					nextHistoryDepthBuffer[frameBufferPixelIndex] = static_cast<float>(NdcZToViewDepth(static_cast<double>(depthBuffer[frameBufferPixelIndex])));
+					continue;
+				}
+
+				uint8_t paletteIndex = g_paletteIndexBuffer[frameBufferPixelIndex];
+				double viewDepth = RendererUtils::FAR_PLANE;
+				bool isReprojected = false;
+				for (int i = 0; i < neighborCount; i++)
+				{
+					const int neighborPixelIndex = frameBufferPixelX + (neighborPixelYs[i] * g_frameBufferWidth);
+					const double neighborDepth = static_cast<double>(depthBuffer[neighborPixelIndex]);
+					const double neighborNdcZ = std::isfinite(neighborDepth) ? neighborDepth : 1.0;
+
+					int historyPixelIndex;
+					double historyViewDepth;
+					if (!TryReprojectInterlacedPixel(frameBufferPixelX, frameBufferPixelY, neighborNdcZ, &historyPixelIndex, &historyViewDepth))
+					{
+						continue;
+					}
+
+					const double savedHistoryViewDepth = static_cast<double>(historyDepthBuffer[historyPixelIndex]);
+					if (std::abs(savedHistoryViewDepth - historyViewDepth) <= (historyViewDepth * INTERLACE_HISTORY_DEPTH_TOLERANCE))
+					{
+						paletteIndex = historyPaletteIndexBuffer[historyPixelIndex];
+						viewDepth = NdcZToViewDepth(neighborNdcZ);
+						isReprojected = true;
+						break;
+					}
+				}
+
+				if (!isReprojected && (neighborCount > 0))
+				{
+					const int neighborPixelIndex = frameBufferPixelX + (neighborPixelYs[0] * g_frameBufferWidth);
+					paletteIndex = g_paletteIndexBuffer[neighborPixelIndex];
+					viewDepth = NdcZToViewDepth(static_cast<double>(depthBuffer[neighborPixelIndex]));
+				}
+
+				g_paletteIndexBuffer[frameBufferPixelIndex] = paletteIndex;
+				g_colorBuffer[frameBufferPixelIndex] = paletteColors[paletteIndex];
+				nextHistoryPaletteIndexBuffer[frameBufferPixelIndex] = paletteIndex;
+				nextHistoryDepthBuffer[frameBufferPixelIndex] = static_cast<float>(viewDepth);
+			}
+		}
+	}
+
+	void FinishInterlacedBin(int binX, int binY, int binWidth, int binHeight)
+	{
+		if (g_rasterPrecisionMode == RasterPrecisionMode::Single)
+		{
+			FinishInterlacedBinInternal(g_singlePrecisionDepthBuffer, binX, binY, binWidth, binHeight);
+		}
+		else
+		{
+			FinishInterlacedBinInternal(g_depthBuffer, binX, binY, binWidth, binHeight);
+		}
+	}
+
+	// Approximate view depth of a draw call from its model matrix translation, good enough for ordering.
+	double GetDrawCallViewDepth(const Matrix4d &modelMatrix, const RenderCamera &camera)
+	{
+		const Double3 meshPosition(modelMatrix.w.x, modelMatrix.w.y, modelMatrix.w.z);
+		return (meshPosition - camera.floatingWorldPoint).dot(camera.forward);
+	}
+
+	// Copies each instance's transform, gets its sort depth, and checks whether the world mesh cache it claimed while
+	// submitting still matches. Every cache is claimed by at most one instance so ranges can be filled in any order.
+	void FillDrawCallInstances(const PacketFillWork &work, int startIndex, int count)
+	{
+		for (int i = startIndex; i < (startIndex + count); i++)
+		{
+			const DrawCallInstanceSource &source = work.drawCallInstanceSources[i];
+			const RenderDrawCall &drawCall = *source.drawCall;
+			const Matrix4d &modelMatrix = *source.modelMatrix;
+			PopulateMeshTransform(work.transformCaches[i], modelMatrix);
+			work.drawCallSortKeys[i].viewDepth = GetDrawCallViewDepth(modelMatrix, *work.camera);
+
+			DrawCallInstance &drawCallInstance = work.drawCallInstances[i];
+			if (drawCallInstance.worldMeshCache == nullptr)
+			{
+				continue;
+			}
+
+			const DrawCallCache &drawCallCache = work.drawCallCaches[drawCallInstance.drawCallCacheIndex];
+			const uint32_t positionBufferVersion = drawCallCache.positionBuffer->version;
+			const uint32_t indexBufferVersion = drawCallCache.indexBuffer->version;
+			const uint32_t texCoordBufferVersion = drawCallCache.texCoordBuffer->version;
+
+			SoftwareWorldMeshCache &worldMeshCache = *drawCallInstance.worldMeshCache;
+			const bool isSameWorldMesh = (std::memcmp(&worldMeshCache.modelMatrix, &modelMatrix, sizeof(modelMatrix)) == 0) &&
+				(worldMeshCache.positionBufferID == drawCall.positionBufferID) &&
+				(worldMeshCache.indexBufferID == drawCall.indexBufferID) &&
+				(worldMeshCache.texCoordBufferID == drawCall.texCoordBufferID) &&
+				(worldMeshCache.positionBufferVersion == positionBufferVersion) &&
+				(worldMeshCache.indexBufferVersion == indexBufferVersion) &&
+				(worldMeshCache.texCoordBufferVersion == texCoordBufferVersion);
+
+			if (!isSameWorldMesh)
+			{
+				worldMeshCache.modelMatrix = modelMatrix;
+				worldMeshCache.positionBufferID = drawCall.positionBufferID;
+				worldMeshCache.indexBufferID = drawCall.indexBufferID;
+				worldMeshCache.texCoordBufferID = drawCall.texCoordBufferID;
+				worldMeshCache.positionBufferVersion = positionBufferVersion;
+				worldMeshCache.indexBufferVersion = indexBufferVersion;
+				worldMeshCache.texCoordBufferVersion = texCoordBufferVersion;
+				worldMeshCache.isBuilt = false;
+				drawCallInstance.worldMeshCache = nullptr;
+			}
+			else
+			{
+				drawCallInstance.shouldBuildWorldMeshCache = !worldMeshCache.isBuilt;
+				worldMeshCache.isBuilt = true;
+			}
+		}
+	}
+
+	void WorkerFunc(int workerIndex, uint32_t workerEpoch)
+	{
+		Worker &worker = g_workers.get(workerIndex);
+
+		while (true)
+		{
+			workerEpoch = WaitForWorkerPhase(workerEpoch);
+			if (g_workerPhase == WorkerPhase::Exit)
+			{
+				break;
+			}
+
+			if (g_workerPhase == WorkerPhase::PacketFill)
+			{
+				const PacketFillWork &packetFillWork = g_packetFillWork;
+				while (true)
+				{
+					const int startIndex = g_nextPacketFillInstanceIndex.fetch_add(PACKET_FILL_INSTANCES_PER_WORK_ITEM, std::memory_order_relaxed);
+					if (startIndex >= packetFillWork.instanceCount)
+					{
+						break;
+					}
+
+					const int count = std::min(PACKET_FILL_INSTANCES_PER_WORK_ITEM, packetFillWork.instanceCount - startIndex);
+					FillDrawCallInstances(packetFillWork, startIndex, count);
+				}
+
+				FinishWorkerPhase();
+				continue;
+			}
+
+			DebugAssert(g_workerPhase == WorkerPhase::DrawCalls);
+
+			const auto drawCallsStartTime = std::chrono::high_resolution_clock::now();
+			const bool enableStageTimers = g_enableStageTimers;
+			auto stageMarkTime = drawCallsStartTime;
+
+			for (int drawCallIndex = 0; drawCallIndex < worker.drawCallCount; drawCallIndex++)
+			{
+				const DrawCallInstance &drawCallInstance = worker.drawCallInstances[drawCallIndex];
+				const DrawCallCache &drawCallCache = worker.drawCallCaches[drawCallInstance.drawCallCacheIndex];
+				TransformCache transformCache = worker.transformCaches[drawCallIndex];
+				VertexShaderInputCache &vertexShaderInputCache = worker.vertexShaderInputCache;
+				VertexShaderOutputCache &vertexShaderOutputCache = worker.vertexShaderOutputCache;
+				ClippingOutputCache &clippingOutputCache = worker.clippingOutputCache;
+				RasterizerInputCache &rasterizerInputCache = worker.rasterizerInputCache;
+
+				if (drawCallInstance.worldMeshCache != nullptr)
+				{
+					if (drawCallInstance.shouldBuildWorldMeshCache)
+					{
+						BuildWorldMeshCache(drawCallCache, transformCache, *drawCallInstance.worldMeshCache);
+					}
+
+					ProcessWorldMeshCacheLookups(*drawCallInstance.worldMeshCache, vertexShaderInputCache);
+					CalculateWorldMeshVertexShaderTransforms(transformCache);
+				}
+				else
+				{
+					ProcessMeshBufferLookups(drawCallCache, vertexShaderInputCache);
+					CalculateVertexShaderTransforms(transformCache);
+				}
+
+				ProcessVertexShaders(drawCallCache.vertexShaderType, transformCache, vertexShaderInputCache, vertexShaderOutputCache);
+				if (enableStageTimers)
+				{
+					MarkWorkerStageTime(worker, RendererProfilerStage::VertexShading, stageMarkTime);
+				}
+
+				ProcessClipping(drawCallCache, vertexShaderOutputCache, clippingOutputCache);
+				if (enableStageTimers)
+				{
+					MarkWorkerStageTime(worker, RendererProfilerStage::Clipping, stageMarkTime);
+				}
+
+				ProcessClipSpaceTrianglesForBinning(drawCallIndex, drawCallCache.enableBackFaceCulling, clippingOutputCache, rasterizerInputCache);
+				if (enableStageTimers)
+				{
+					MarkWorkerStageTime(worker, RendererProfilerStage::Binning, stageMarkTime);
+				}
+			}
+
+			// Clear screen before rasterization sync as frame buffer rows are faster than bin rows.
+			if (worker.shouldClearFrameBuffer)
+			{
 				// Determine rows to clear.
 				const std::div_t frameBufferClearRowsDiv = std::div(g_frameBufferHeight, g_workers.getCount());
 				const int frameBufferClearRowsPerWorker = frameBufferClearRowsDiv.quot;
@@ -3782,9 +5978,23 @@ namespace
 				const int frameBufferClearRowCount = frameBufferClearRowsPerWorker + (workerIndex < frameBufferClearRowsRemainder ? 1 : 0);
 
 				// Don't have to clear color buffer since there's always a sky mesh.
-				double *depthBufferClearStart = g_depthBuffer + (frameBufferClearStartY * g_frameBufferWidth);
-				double *depthBufferClearEnd = depthBufferClearStart + (frameBufferClearRowCount * g_frameBufferWidth);
-				std::fill(depthBufferClearStart, depthBufferClearEnd, Constants::Infinity);
+				const int depthBufferClearStartIndex = frameBufferClearStartY * g_frameBufferWidth;
+				const int depthBufferClearCount = frameBufferClearRowCount * g_frameBufferWidth;
+				if (g_rasterPrecisionMode == RasterPrecisionMode::Single)
+				{
+					float *depthBufferClearStart = g_singlePrecisionDepthBuffer + depthBufferClearStartIndex;
+					std::fill(depthBufferClearStart, depthBufferClearStart + depthBufferClearCount, std::numeric_limits<float>::infinity());
+				}
+				else
+				{
+					double *depthBufferClearStart = g_depthBuffer + depthBufferClearStartIndex;
+					std::fill(depthBufferClearStart, depthBufferClearStart + depthBufferClearCount, Constants::Infinity);
+				}
+			}
+
+			if (enableStageTimers)
+			{
+				MarkWorkerStageTime(worker, RendererProfilerStage::Clearing, stageMarkTime);
 			}
 
 			// Populate light bins associated with this worker.
@@ -3800,132 +6010,1018 @@ namespace
 				PopulateLightBin(lightBinX, lightBinY, g_camera, g_frameBufferWidth, g_frameBufferHeight);
 			}
 
-			workerLock.lock();
-			worker.isFinishedWithDrawCalls = true;
-			g_directorCondVar.notify_one();
-			g_workerCondVar.wait(workerLock, [&worker]() { return worker.shouldWorkOnRasterizing; });
-			workerLock.unlock();
+			if (enableStageTimers)
+			{
+				MarkWorkerStageTime(worker, RendererProfilerStage::LightBins, stageMarkTime);
+			}
+
+			worker.busyTime += GetElapsedSeconds(drawCallsStartTime);
+			FinishWorkerPhase();
+
+			workerEpoch = WaitForWorkerPhase(workerEpoch);
+			DebugAssert(g_workerPhase == WorkerPhase::Rasterizing);
+
+			const auto rasterizingStartTime = std::chrono::high_resolution_clock::now();
+
+			// Use the geometry processing results of all workers to rasterize whichever bins this worker grabs. The order of workers is assumed
+			// to be the same that draw calls were originally processed, otherwise triangles in each bin would be rasterized in the wrong order.
+			const int workItemCount = static_cast<int>(g_rasterizerWorkItems.size());
+			while (true)
+			{
+				const int workItemIndex = g_nextRasterizerWorkItemIndex.fetch_add(1, std::memory_order_relaxed);
+				if (workItemIndex >= workItemCount)
+				{
+					break;
+				}
+
+				const RasterizerWorkItem &workItem = g_rasterizerWorkItems[workItemIndex];
+				const int binX = workItem.binX;
+				const int binY = workItem.binY;
+				const int binWidth = worker.rasterizerInputCache.binWidth;
+				const int binHeight = worker.rasterizerInputCache.binHeight;
+				const bool isVisibilityBufferMode = g_shadingMode == ShadingMode::VisibilityBuffer;
+				for (const Worker &geometryWorker : g_workers)
+				{
+					if (geometryWorker.drawCallCount > 0)
+					{
+						const RasterizerBin &geometryWorkerBin = geometryWorker.rasterizerInputCache.bins.get(binX, binY);
+						g_binTriangleCounts[workItem.binIndex] += geometryWorkerBin.triangleCount; // Only this worker touches this bin until the next sync.
+
+						for (const RasterizerBinEntry &binEntry : geometryWorkerBin.entries)
+						{
+							const int workerDrawCallIndex = binEntry.workerDrawCallIndex;
+							DebugAssert(workerDrawCallIndex < geometryWorker.drawCallCount);
+							const DrawCallCache &drawCallCache = GetWorkerDrawCallCache(geometryWorker, workerDrawCallIndex);
+							const RasterizerInputCache &rasterizerInputCache = geometryWorker.rasterizerInputCache;
+
+							if (isVisibilityBufferMode && DoesFragmentShaderReadFrameBuffer(drawCallCache.fragmentShaderType))
+							{
+								ResolveVisibilityBufferBin(binX, binY, binWidth, binHeight, workItem.binIndex);
+							}
+
+							RasterizeMesh(drawCallCache, rasterizerInputCache, geometryWorkerBin, binEntry, binX, binY, workItem.binIndex);
+						}
+					}
+				}
+
+				if (isVisibilityBufferMode)
+				{
+					ResolveVisibilityBufferBin(binX, binY, binWidth, binHeight, workItem.binIndex);
+				}
+
+				if (g_shouldFinishInterlacedBins)
+				{
+					FinishInterlacedBin(binX, binY, binWidth, binHeight);
+				}
+			}
+
+			const double rasterizingTime = GetElapsedSeconds(rasterizingStartTime);
+			worker.busyTime += rasterizingTime;
+			worker.stageTimes[static_cast<int>(RendererProfilerStage::Rasterizing)] += rasterizingTime;
+			FinishWorkerPhase();
+		}
+	}
+
+	void SignalWorkersToExitAndJoin()
+	{
+		g_workerPhase = WorkerPhase::Exit;
+		g_workerEpoch.fetch_add(1, std::memory_order_seq_cst);
+		NotifyParkedThreads(g_workerEpoch, g_parkedWorkerCount);
+
+		for (Worker &worker : g_workers)
+		{
+			worker.thread.join();
+		}
+	}
+
+	// Steps the bin size one level at a time based on the triangle histogram of the frame that just finished.
+	void UpdateRasterizerBinScaleLevel(int frameBufferWidth, int frameBufferHeight)
+	{
+		const RasterizerInputCache &firstRasterizerInputCache = g_workers.get(0).rasterizerInputCache;
+		const int binWidth = firstRasterizerInputCache.binWidth;
+		const int binHeight = firstRasterizerInputCache.binHeight;
+		const int binCount = firstRasterizerInputCache.binCountX * firstRasterizerInputCache.binCountY;
+		if ((binCount == 0) || (g_binTriangleCounts.getCount() != binCount))
+		{
+			return; // No histogram for this layout yet.
+		}
+
+		int64_t totalBinTriangleCount = 0;
+		int maxBinTriangleCount = 0;
+		for (const int binTriangleCount : g_binTriangleCounts)
+		{
+			totalBinTriangleCount += binTriangleCount;
+			maxBinTriangleCount = std::max(maxBinTriangleCount, binTriangleCount);
+		}
+
+		const int workerCount = g_workers.getCount();
+		const bool isBusiestBinDense = maxBinTriangleCount >= RASTERIZER_DENSE_BIN_TRIANGLE_COUNT;
+		const bool isBusiestBinImbalanced = (maxBinTriangleCount >= RASTERIZER_IMBALANCED_BIN_TRIANGLE_COUNT) &&
+			((static_cast<int64_t>(maxBinTriangleCount) * workerCount) > totalBinTriangleCount);
+		const bool isBusiestBinSparse = maxBinTriangleCount < RASTERIZER_SPARSE_BIN_TRIANGLE_COUNT;
+
+		if (isBusiestBinDense || isBusiestBinImbalanced)
+		{
+			const bool canSplit = ((binWidth / 2) >= RASTERIZER_ADAPTIVE_BIN_MIN_DIMENSION) && ((binHeight / 2) >= RASTERIZER_ADAPTIVE_BIN_MIN_DIMENSION);
+			if (canSplit)
+			{
+				g_rasterizerBinScaleLevel--;
+			}
+		}
+		else if (isBusiestBinSparse)
+		{
+			const int mergedBinWidth = binWidth * 2;
+			const int mergedBinHeight = binHeight * 2;
+			const int mergedBinCount = GetRasterizerBinCount(frameBufferWidth, mergedBinWidth) * GetRasterizerBinCount(frameBufferHeight, mergedBinHeight);
+			const bool canMerge = (mergedBinWidth <= RASTERIZER_ADAPTIVE_BIN_MAX_DIMENSION) && (mergedBinHeight <= RASTERIZER_ADAPTIVE_BIN_MAX_DIMENSION) &&
+				(mergedBinCount >= (workerCount * RASTERIZER_MIN_BINS_PER_WORKER));
+			if (canMerge)
+			{
+				g_rasterizerBinScaleLevel++;
+			}
+		}
+	}
+
+	// Runs once per frame packet so a raster precision reference pass can't step the bin size a second time.
+	void UpdateRasterizerBinLayout(int frameBufferWidth, int frameBufferHeight, bool enableAdaptiveBinSizing)
+	{
+		if (enableAdaptiveBinSizing)
+		{
+			UpdateRasterizerBinScaleLevel(frameBufferWidth, frameBufferHeight);
+		}
+		else
+		{
+			g_rasterizerBinScaleLevel = 0;
+		}
+	}
+
+	void InitializeWorkers(int workerCount, int frameBufferWidth, int frameBufferHeight)
+	{
+		if (g_workers.getCount() != workerCount)
+		{
+			SignalWorkersToExitAndJoin();
+
+			g_workers.init(workerCount);
+			for (int workerIndex = 0; workerIndex < workerCount; workerIndex++)
+			{
+				Worker &worker = g_workers[workerIndex];
+				worker.drawCallCaches = nullptr;
+				worker.drawCallInstances = nullptr;
+				worker.transformCaches = nullptr;
+				worker.drawCallStartIndex = -1;
+				worker.drawCallCount = 0;
+				worker.rasterizerInputCache.visibilityIDBase = workerIndex * RasterizerInputCache::MAX_FRUSTUM_TRIANGLES;
+				worker.shouldClearFrameBuffer = false;
+				worker.cpuID = -1;
+				worker.busyTime = 0.0;
+				std::fill(std::begin(worker.stageTimes), std::end(worker.stageTimes), 0.0);
+				worker.thread = std::thread(WorkerFunc, workerIndex, g_workerEpoch.load(std::memory_order_relaxed));
+			}
+
+			g_areWorkersPinned = false;
+		}
+
+		int binWidth, binHeight;
+		GetRasterizerBinDimensions(frameBufferWidth, frameBufferHeight, g_rasterizerBinScaleLevel, &binWidth, &binHeight);
+
+		bool isBinLayoutChanged = false;
+		for (Worker &worker : g_workers)
+		{
+			worker.busyTime = 0.0;
+			std::fill(std::begin(worker.stageTimes), std::end(worker.stageTimes), 0.0);
+
+			RasterizerInputCache &rasterizerInputCache = worker.rasterizerInputCache;
+			if (!rasterizerInputCache.hasBinLayout(frameBufferWidth, frameBufferHeight, binWidth, binHeight))
+			{
+				rasterizerInputCache.createBins(frameBufferWidth, frameBufferHeight, binWidth, binHeight);
+				isBinLayoutChanged = true;
+			}
+		}
+
+		const Worker &firstWorker = g_workers.get(0);
+		const int binCountX = firstWorker.rasterizerInputCache.binCountX;
+		const int binCountY = firstWorker.rasterizerInputCache.binCountY;
+		const int binCount = binCountX * binCountY;
+
+		// Last frame's bin costs are only meaningful if the bin layout didn't change.
+		if (isBinLayoutChanged || (g_binTriangleCounts.getCount() != binCount))
+		{
+			g_binTriangleCounts.init(binCount);
+			g_prevBinTriangleCounts.init(binCount);
+			g_prevBinTriangleCounts.fill(0);
+		}
+		else
+		{
+			std::copy(g_binTriangleCounts.begin(), g_binTriangleCounts.end(), g_prevBinTriangleCounts.begin());
+		}
+
+		g_binTriangleCounts.fill(0);
+
+		g_rasterizerWorkItems.clear();
+		for (int binY = 0; binY < binCountY; binY++)
+		{
+			for (int binX = 0; binX < binCountX; binX++)
+			{
+				const int binIndex = binX + (binY * binCountX);
+				g_rasterizerWorkItems.emplace_back(binX, binY, binIndex);
+			}
+		}
+
+		// Most expensive bins first so a heavy bin isn't the last thing a worker picks up.
+		std::stable_sort(g_rasterizerWorkItems.begin(), g_rasterizerWorkItems.end(),
+			[](const RasterizerWorkItem &a, const RasterizerWorkItem &b)
+		{
+			return g_prevBinTriangleCounts[a.binIndex] > g_prevBinTriangleCounts[b.binIndex];
+		});
+	}
+
+	// Gives each worker its own physical core, performance cores and shared caches first, or lets the OS place them again.
+	// Workers beyond the core count stay unpinned rather than doubling up on SMT siblings.
+	void UpdateWorkerAffinity(bool enableAffinity)
+	{
+		if (enableAffinity == g_areWorkersPinned)
+		{
+			return;
+		}
+
+		std::vector<int> cpuIDs;
+		if (enableAffinity)
+		{
+			cpuIDs = Platform::getPhysicalCoreCpuIDs();
+
+			if (cpuIDs.empty())
+			{
+				DebugLogWarning("No CPU topology available for pinning render threads.");
+			}
+		}
+
+		for (int workerIndex = 0; workerIndex < g_workers.getCount(); workerIndex++)
+		{
+			Worker &worker = g_workers[workerIndex];
+			const int cpuID = (workerIndex < static_cast<int>(cpuIDs.size())) ? cpuIDs[workerIndex] : -1;
+			if ((cpuID != worker.cpuID) && Platform::trySetThreadAffinity(worker.thread, cpuID))
+			{
+				worker.cpuID = cpuID;
+			}
+		}
+
+		g_areWorkersPinned = enableAffinity;
+	}
+
+	void PopulateWorkerDrawCallWorkloads(const DrawCallCache *drawCallCaches, const DrawCallInstance *drawCallInstances, const TransformCache *transformCaches,
+		int workerCount, int startDrawCallIndex, int drawCallCount)
+	{
+		const int baseDrawCallsPerWorker = drawCallCount / workerCount;
+		const int workersWithExtraDrawCall = drawCallCount % workerCount;
+
+		int workerStartDrawCallIndex = startDrawCallIndex;
+		for (int i = 0; i < workerCount; i++)
+		{
+			Worker &worker = g_workers[i];
+			worker.drawCallCaches = drawCallCaches;
+			worker.drawCallInstances = drawCallInstances + workerStartDrawCallIndex;
+			worker.transformCaches = transformCaches + workerStartDrawCallIndex;
+			worker.drawCallStartIndex = workerStartDrawCallIndex;
+			worker.drawCallCount = baseDrawCallsPerWorker;
+
+			if (i < workersWithExtraDrawCall)
+			{
+				worker.drawCallCount++;
+			}
+
+			workerStartDrawCallIndex += worker.drawCallCount;
+		}
+
+		DebugAssert((workerStartDrawCallIndex - startDrawCallIndex) == drawCallCount);
+	}
+
+	void ShutdownWorkers()
+	{
+		SignalWorkersToExitAndJoin();
+		g_workers.clear();
+	}
+}
+
+// Single-precision rasterizer error measurement.
+namespace
+{
+	constexpr int RASTER_PRECISION_COMPARISON_FRAME_INTERVAL = 30; // Frames between double-precision reference frames.
+
+	int g_rasterPrecisionComparisonFrameCounter = 0;
+	double g_rasterPrecisionDiffPercent = -1.0;
+	double g_rasterPrecisionPsnr = 0.0;
+
+	void CompareRasterPrecisionFrames(const uint8_t *referencePaletteIndices, const uint32_t *referenceColors, const uint8_t *paletteIndices,
+		const uint32_t *colors, int pixelCount)
+	{
+		constexpr int channelShifts[] = { Endian::RGBA_RedShift, Endian::RGBA_GreenShift, Endian::RGBA_BlueShift };
+
+		int64_t diffPixelCount = 0;
+		double squaredErrorSum = 0.0;
+		for (int i = 0; i < pixelCount; i++)
+		{
+			if (paletteIndices[i] == referencePaletteIndices[i])
+			{
+				continue;
+			}
+
+			diffPixelCount++;
+
+			for (const int channelShift : channelShifts)
+			{
+				const int referenceChannel = static_cast<int>((referenceColors[i] >> channelShift) & 0xFF);
+				const int channel = static_cast<int>((colors[i] >> channelShift) & 0xFF);
+				const int channelDiff = channel - referenceChannel;
+				squaredErrorSum += static_cast<double>(channelDiff * channelDiff);
+			}
+		}
+
+		const double pixelCountReal = static_cast<double>(std::max(pixelCount, 1));
+		g_rasterPrecisionDiffPercent = (static_cast<double>(diffPixelCount) / pixelCountReal) * 100.0;
+
+		const double meanSquaredError = squaredErrorSum / (pixelCountReal * static_cast<double>(std::size(channelShifts)));
+		g_rasterPrecisionPsnr = (meanSquaredError > 0.0) ? (10.0 * std::log10((255.0 * 255.0) / meanSquaredError)) : Constants::Infinity;
+	}
+}
+
+// Frame pipelining. Everything a frame reads from the renderer's pools besides vertex buffers and textures is
+// copied into a packet on submit, so the game can keep simulating while the frame director thread renders it.
+namespace
+{
+	struct FramePacket
+	{
+		uint32_t frameID;
+		RenderCamera camera;
+		std::vector<DrawCallCache> drawCallCaches; // Every draw call in command list order, shared by its instances.
+		std::vector<DrawCallInstance> drawCallInstances; // Every instance of every draw call, what workers and sorting go through.
+		std::vector<TransformCache> transformCaches; // One per instance.
+		std::vector<int> entryDrawCallCounts; // Instances per command list entry, worker loops don't span entries.
+		std::vector<DrawCallInstanceSource> drawCallInstanceSources; // One per instance, only used while submitting.
+		std::vector<DrawCallSortKey> drawCallSortKeys; // One per instance, only used while submitting.
+		int sortedDrawCallCount;
+		std::vector<SoftwareLight> visibleLights;
+		uint32_t resourceVersion; // Highest version of any mesh buffer or texture the draw calls read.
+
+		// The game rewrites some of these every tick (i.e. the palette) so they are cheaper to copy than to wait on.
+		SoftwareObjectTexture paletteTexture;
+		SoftwareObjectTexture lightTableTexture;
+		SoftwareObjectTexture ditherTexture;
+		SoftwareObjectTexture skyBgTexture;
+
+		double ambientPercent;
+		double screenSpaceAnimPercent;
+		Double3 horizonNdcPoint;
+		int workerCount;
+		int workerSpinMicroseconds;
+		DitheringMode ditheringMode;
+		RasterPrecisionMode rasterPrecisionMode;
+		ShadingMode shadingMode;
+		bool enableRasterPrecisionComparison;
+		bool shouldCompareRasterPrecision;
+		bool enableAdaptiveBinSizing;
+		bool enableInterlacing;
+		bool enableMipmaps;
+		bool enableTiledTexels;
+		bool isUnchangedFrame; // Same inputs as the previous frame, rendered in full so it can be presented again as-is.
+		bool enableStageTimers;
+		bool enableWorkerAffinity;
+
+		int frameBufferWidth, frameBufferHeight;
+		uint8_t *paletteIndexBuffer;
+		double *depthBuffer;
+		float *singlePrecisionDepthBuffer;
+		Buffer2D<uint8_t> *referencePaletteIndexBuffer;
+		Buffer2D<uint32_t> *referenceColorBuffer;
+		uint32_t *colorBuffer;
+		int32_t *visibilityBuffer;
+		SoftwareObjectTexturePool *objectTextures;
+
+		RendererProfilerData3D profilerData; // Filled in by whichever thread renders the frame.
+	};
+
+	// At most one frame renders at a time so one packet can be filled while the other is in use.
+	FramePacket g_framePackets[2];
+
+	uint32_t g_submittedFrameID = 0; // Only touched by the submitting thread.
+	std::atomic<uint32_t> g_completedFrameID = 0;
+	std::atomic<int> g_parkedSubmitterCount;
+
+	std::thread g_frameDirectorThread;
+	std::atomic<uint32_t> g_frameDirectorEpoch; // Bumped to hand the director a packet or tell it to exit.
+	std::atomic<int> g_parkedFrameDirectorCount;
+	FramePacket *g_frameDirectorPacket;
+	bool g_shouldFrameDirectorExit;
+
+	int g_reusedFrameCount = 0; // Consecutive submits that presented the last rendered frame again instead of rendering.
+
+	FramePacket &GetFramePacket(uint32_t frameID)
+	{
+		return g_framePackets[frameID % std::size(g_framePackets)];
+	}
+
+	void CopyFrameTexture(const SoftwareObjectTexture &texture, SoftwareObjectTexture &outTexture)
+	{
+		if ((outTexture.width != texture.width) || (outTexture.height != texture.height) || (outTexture.bytesPerTexel != texture.bytesPerTexel))
+		{
+			outTexture.init(texture.width, texture.height, texture.bytesPerTexel);
+		}
+
+		std::copy(texture.texels.begin(), texture.texels.end(), outTexture.texels.begin());
+	}
+
+	bool IsSameFrameTexture(const SoftwareObjectTexture &texture, const SoftwareObjectTexture &otherTexture)
+	{
+		return (texture.width == otherTexture.width) && (texture.height == otherTexture.height) &&
+			(texture.bytesPerTexel == otherTexture.bytesPerTexel) &&
+			std::equal(texture.texels.begin(), texture.texels.end(), otherTexture.texels.begin());
+	}
+
+	bool IsSameDrawCallCache(const DrawCallCache &drawCallCache, const DrawCallCache &otherDrawCallCache)
+	{
+		return (drawCallCache.positionBuffer == otherDrawCallCache.positionBuffer) &&
+			(drawCallCache.texCoordBuffer == otherDrawCallCache.texCoordBuffer) &&
+			(drawCallCache.indexBuffer == otherDrawCallCache.indexBuffer) &&
+			(drawCallCache.textureID0 == otherDrawCallCache.textureID0) &&
+			(drawCallCache.textureID1 == otherDrawCallCache.textureID1) &&
+			(drawCallCache.lightingType == otherDrawCallCache.lightingType) &&
+			(drawCallCache.meshLightPercent == otherDrawCallCache.meshLightPercent) &&
+			(drawCallCache.vertexShaderType == otherDrawCallCache.vertexShaderType) &&
+			(drawCallCache.fragmentShaderType == otherDrawCallCache.fragmentShaderType) &&
+			(drawCallCache.texCoordAnimPercent == otherDrawCallCache.texCoordAnimPercent) &&
+			(drawCallCache.enableBackFaceCulling == otherDrawCallCache.enableBackFaceCulling) &&
+			(drawCallCache.enableDepthRead == otherDrawCallCache.enableDepthRead) &&
+			(drawCallCache.enableDepthWrite == otherDrawCallCache.enableDepthWrite);
+	}
+
+	// Whether a packet would render the same image as the one submitted right before it. Only reads what the render
+	// threads don't write to, so the previous packet can still be rendering.
+	bool IsSameFrameInputs(const FramePacket &packet, const FramePacket &prevPacket)
+	{
+		if ((prevPacket.frameID + 1) != packet.frameID)
+		{
+			return false;
+		}
+
+		if ((packet.frameBufferWidth != prevPacket.frameBufferWidth) || (packet.frameBufferHeight != prevPacket.frameBufferHeight))
+		{
+			return false;
+		}
+
+		const RenderCamera &camera = packet.camera;
+		const RenderCamera &prevCamera = prevPacket.camera;
+		const bool isSameCamera = (camera.worldPoint == prevCamera.worldPoint) &&
+			(std::memcmp(&camera.viewProjMatrix, &prevCamera.viewProjMatrix, sizeof(camera.viewProjMatrix)) == 0) &&
+			(std::memcmp(&camera.inverseViewMatrix, &prevCamera.inverseViewMatrix, sizeof(camera.inverseViewMatrix)) == 0) &&
+			(std::memcmp(&camera.inverseProjectionMatrix, &prevCamera.inverseProjectionMatrix, sizeof(camera.inverseProjectionMatrix)) == 0) &&
+			(packet.horizonNdcPoint == prevPacket.horizonNdcPoint);
+		if (!isSameCamera)
+		{
+			return false;
+		}
+
+		const bool isSameShading = (packet.ambientPercent == prevPacket.ambientPercent) &&
+			(packet.screenSpaceAnimPercent == prevPacket.screenSpaceAnimPercent) &&
+			(packet.ditheringMode == prevPacket.ditheringMode) &&
+			(packet.rasterPrecisionMode == prevPacket.rasterPrecisionMode) &&
+			(packet.shadingMode == prevPacket.shadingMode) &&
+			(packet.enableMipmaps == prevPacket.enableMipmaps) &&
+			(packet.enableTiledTexels == prevPacket.enableTiledTexels);
+		if (!isSameShading)
+		{
+			return false;
+		}
+
+		// Any mesh buffer or texture written to since gets a newer version than everything before it.
+		if (packet.resourceVersion != prevPacket.resourceVersion)
+		{
+			return false;
+		}
+
+		const int drawCallCount = static_cast<int>(packet.drawCallCaches.size());
+		const int instanceCount = static_cast<int>(packet.drawCallInstances.size());
+		if ((drawCallCount != static_cast<int>(prevPacket.drawCallCaches.size())) || (instanceCount != static_cast<int>(prevPacket.drawCallInstances.size())) ||
+			(packet.entryDrawCallCounts != prevPacket.entryDrawCallCounts))
+		{
+			return false;
+		}
+
+		for (int i = 0; i < drawCallCount; i++)
+		{
+			if (!IsSameDrawCallCache(packet.drawCallCaches[i], prevPacket.drawCallCaches[i]))
+			{
+				return false;
+			}
+		}
+
+		// World mesh cache use doesn't change the image.
+		for (int i = 0; i < instanceCount; i++)
+		{
+			if (packet.drawCallInstances[i].drawCallCacheIndex != prevPacket.drawCallInstances[i].drawCallCacheIndex)
+			{
+				return false;
+			}
+		}
+
+		if (std::memcmp(packet.transformCaches.data(), prevPacket.transformCaches.data(), instanceCount * sizeof(TransformCache)) != 0)
+		{
+			return false;
+		}
+
+		const int visibleLightCount = static_cast<int>(packet.visibleLights.size());
+		if ((visibleLightCount != static_cast<int>(prevPacket.visibleLights.size())) ||
+			(std::memcmp(packet.visibleLights.data(), prevPacket.visibleLights.data(), visibleLightCount * sizeof(SoftwareLight)) != 0))
+		{
+			return false;
+		}
+
+		return IsSameFrameTexture(packet.paletteTexture, prevPacket.paletteTexture) &&
+			IsSameFrameTexture(packet.lightTableTexture, prevPacket.lightTableTexture) &&
+			IsSameFrameTexture(packet.ditherTexture, prevPacket.ditherTexture) &&
+			IsSameFrameTexture(packet.skyBgTexture, prevPacket.skyBgTexture);
+	}
+
+	// A reused frame isn't rendered, so world mesh caches it claimed go back to how the last rendered frame left them.
+	void RevertWorldMeshCacheUse(const FramePacket &packet, uint32_t renderedFrameID)
+	{
+		for (const DrawCallInstance &drawCallInstance : packet.drawCallInstances)
+		{
+			SoftwareWorldMeshCache *worldMeshCache = drawCallInstance.worldMeshCache;
+			if (worldMeshCache != nullptr)
+			{
+				worldMeshCache->lastFrameID = renderedFrameID;
+				if (drawCallInstance.shouldBuildWorldMeshCache)
+				{
+					worldMeshCache->isBuilt = false;
+				}
+			}
+		}
+	}
+
+	// Must be called before anything the last submitted frame might read is moved, freed, or written to.
+	void WaitForQueuedFrame()
+	{
+		const uint32_t frameID = g_submittedFrameID;
+		SpinThenPark(g_completedFrameID, g_parkedSubmitterCount, [frameID](uint32_t completedFrameID) { return completedFrameID == frameID; });
+	}
+
+	void WaitForQueuedFrameIfReading(uint32_t resourceLastFrameID)
+	{
+		if (resourceLastFrameID == g_submittedFrameID)
+		{
+			WaitForQueuedFrame();
+		}
+	}
+
+	// Runs the per-instance part of filling the packet. When no frame is rendering the workers are idle and split it up,
+	// otherwise they belong to the frame director and this thread does it alone.
+	void PopulateDrawCallInstances(FramePacket &packet)
+	{
+		PacketFillWork &work = g_packetFillWork;
+		work.drawCallCaches = packet.drawCallCaches.data();
+		work.drawCallInstanceSources = packet.drawCallInstanceSources.data();
+		work.drawCallInstances = packet.drawCallInstances.data();
+		work.transformCaches = packet.transformCaches.data();
+		work.drawCallSortKeys = packet.drawCallSortKeys.data();
+		work.camera = &packet.camera;
+		work.instanceCount = static_cast<int>(packet.drawCallInstances.size());
+
+		const bool isFrameRendering = g_completedFrameID.load(std::memory_order_acquire) != g_submittedFrameID;
+		const bool shouldUseWorkers = !isFrameRendering && (g_workers.getCount() > 1) && (work.instanceCount >= PACKET_FILL_MIN_WORKER_INSTANCES);
+		if (shouldUseWorkers)
+		{
+			g_nextPacketFillInstanceIndex.store(0, std::memory_order_relaxed);
+			RunWorkerPhase(WorkerPhase::PacketFill);
+		}
+		else
+		{
+			FillDrawCallInstances(work, 0, work.instanceCount);
+		}
+	}
+
+	// Copies a finished frame to the output, stretching it if the internal resolution changed since it was rendered.
+	void PresentColorBuffer(const Buffer2D<uint32_t> &colorBuffer, uint32_t *outputBuffer, int outputWidth, int outputHeight)
+	{
+		const int colorBufferWidth = colorBuffer.getWidth();
+		const int colorBufferHeight = colorBuffer.getHeight();
+		if ((colorBufferWidth == outputWidth) && (colorBufferHeight == outputHeight))
+		{
+			std::copy(colorBuffer.begin(), colorBuffer.end(), outputBuffer);
+			return;
+		}
+
+		const uint32_t *srcPixels = colorBuffer.begin();
+		for (int y = 0; y < outputHeight; y++)
+		{
+			const int srcY = (y * colorBufferHeight) / outputHeight;
+			const uint32_t *srcRow = srcPixels + (srcY * colorBufferWidth);
+			uint32_t *dstRow = outputBuffer + (y * outputWidth);
+			for (int x = 0; x < outputWidth; x++)
+			{
+				const int srcX = (x * colorBufferWidth) / outputWidth;
+				dstRow[x] = srcRow[srcX];
+			}
+		}
+	}
+
+	// Runs geometry processing and rasterization for every draw call with the current rasterizer globals.
+	void ProcessFramePacket(const FramePacket &packet, int workerCount, bool shouldFinishInterlacedBins)
+	{
+		const int totalDrawCallCount = static_cast<int>(packet.drawCallInstances.size());
+		const RasterizerInputCache &firstRasterizerInputCache = g_workers.get(0).rasterizerInputCache;
+		ClearDepthHierarchy(g_frameBufferWidth, g_frameBufferHeight, firstRasterizerInputCache.binCountX * firstRasterizerInputCache.binCountY);
+
+		bool shouldWorkersClearFrameBuffer = true; // Once per frame.
+
+		int entryStartDrawCallIndex = 0;
+		for (const int entryDrawCallCount : packet.entryDrawCallCounts)
+		{
+			int startDrawCallIndex = entryStartDrawCallIndex;
+			int remainingDrawCallCount = entryDrawCallCount;
+			constexpr int maxDrawCallsPerLoop = 8192;
+			static_assert(maxDrawCallsPerLoop <= MAX_WORKER_DRAW_CALLS_PER_LOOP);
+
+			while (remainingDrawCallCount > 0)
+			{
+				// All workers are idle between phases.
+				for (Worker &worker : g_workers)
+				{
+					DebugAssert(!worker.shouldClearFrameBuffer);
+					worker.rasterizerInputCache.clearTriangles();
+					worker.rasterizerInputCache.emptyBins();
+				}
+
+				// Determine which workers get which draw calls this loop. Workers read them straight out of the packet, which
+				// isn't touched again until this frame completes.
+				const int drawCallsToConsume = std::min(maxDrawCallsPerLoop, remainingDrawCallCount);
+				PopulateWorkerDrawCallWorkloads(packet.drawCallCaches.data(), packet.drawCallInstances.data(), packet.transformCaches.data(),
+					workerCount, startDrawCallIndex, drawCallsToConsume);
+
+				for (Worker &worker : g_workers)
+				{
+					DebugAssert(worker.drawCallCount <= MAX_WORKER_DRAW_CALLS_PER_LOOP);
+					worker.shouldClearFrameBuffer = shouldWorkersClearFrameBuffer;
+				}
+
+				RunWorkerPhase(WorkerPhase::DrawCalls);
+
+				shouldWorkersClearFrameBuffer = false;
+				g_nextRasterizerWorkItemIndex = 0;
+
+				for (Worker &worker : g_workers)
+				{
+					worker.shouldClearFrameBuffer = false;
+					g_totalPresentedTriangleCount += worker.rasterizerInputCache.triangleCount;
+				}
+
+				// Skipped rows can only be filled in once every draw call is in.
+				const bool isLastDrawCallLoop = (startDrawCallIndex + drawCallsToConsume) == totalDrawCallCount;
+				g_shouldFinishInterlacedBins = shouldFinishInterlacedBins && isLastDrawCallLoop;
+
+				RunWorkerPhase(WorkerPhase::Rasterizing);
+
+				startDrawCallIndex += drawCallsToConsume;
+				remainingDrawCallCount -= drawCallsToConsume;
+			}
+
+			entryStartDrawCallIndex += entryDrawCallCount;
+		}
+	}
+
+	void RenderFramePacket(FramePacket &packet)
+	{
+		const int frameBufferWidth = packet.frameBufferWidth;
+		const int frameBufferHeight = packet.frameBufferHeight;
+
+		PopulateCameraGlobals(packet.camera);
+		PopulateDrawCallGlobals(static_cast<int>(packet.drawCallInstances.size()));
+		PopulateVisibleLights(packet.visibleLights);
+		InitLightBins(frameBufferWidth, frameBufferHeight);
+		PopulateFragmentShaderGlobals(packet.ambientPercent, packet.screenSpaceAnimPercent, packet.enableMipmaps, packet.enableTiledTexels, packet.horizonNdcPoint, packet.paletteTexture,
+			packet.lightTableTexture, packet.ditherTexture, packet.skyBgTexture);
+
+		g_workerSpinMicroseconds.store(packet.workerSpinMicroseconds, std::memory_order_relaxed);
+		g_enableStageTimers = packet.enableStageTimers;
+		UpdateRasterizerBinLayout(frameBufferWidth, frameBufferHeight, packet.enableAdaptiveBinSizing);
+		InitializeWorkers(packet.workerCount, frameBufferWidth, frameBufferHeight);
+		UpdateWorkerAffinity(packet.enableWorkerAffinity);
+
+		if (!packet.enableRasterPrecisionComparison)
+		{
+			g_rasterPrecisionDiffPercent = -1.0;
+			g_rasterPrecisionPsnr = 0.0;
+		}
+
+		// Reference frames are compared against full frames, and frames that might be presented again can't have reprojected rows.
+		const bool shouldSaveInterlaceHistory = PrepareInterlacing(packet.enableInterlacing && !packet.shouldCompareRasterPrecision && !packet.isUnchangedFrame,
+			frameBufferWidth, frameBufferHeight, packet.frameID);
+
+		// Every so often, render a double-precision reference of this frame to measure single-precision error against.
+		if (packet.shouldCompareRasterPrecision)
+		{
+			Buffer2D<uint8_t> &referencePaletteIndexBuffer = *packet.referencePaletteIndexBuffer;
+			Buffer2D<uint32_t> &referenceColorBuffer = *packet.referenceColorBuffer;
+			if ((referencePaletteIndexBuffer.getWidth() != frameBufferWidth) || (referencePaletteIndexBuffer.getHeight() != frameBufferHeight))
+			{
+				referencePaletteIndexBuffer.init(frameBufferWidth, frameBufferHeight);
+				referenceColorBuffer.init(frameBufferWidth, frameBufferHeight);
+			}
+
+			PopulateRasterizerGlobals(frameBufferWidth, frameBufferHeight, referencePaletteIndexBuffer.begin(), packet.depthBuffer,
+				packet.singlePrecisionDepthBuffer, packet.ditheringMode, RasterPrecisionMode::Double, packet.shadingMode,
+				referenceColorBuffer.begin(), packet.visibilityBuffer, packet.objectTextures);
+			ProcessFramePacket(packet, packet.workerCount, false);
+
+			// Keep the reference frame out of this frame's thread timings.
+			InitializeWorkers(packet.workerCount, frameBufferWidth, frameBufferHeight);
+		}
+
+		PopulateRasterizerGlobals(frameBufferWidth, frameBufferHeight, packet.paletteIndexBuffer, packet.depthBuffer,
+			packet.singlePrecisionDepthBuffer, packet.ditheringMode, packet.rasterPrecisionMode, packet.shadingMode, packet.colorBuffer,
+			packet.visibilityBuffer, packet.objectTextures);
+
+		ClearTriangleTotalCounts();
+		ClearFrameBufferOperationCounts();
+
+		for (Worker &worker : g_workers)
+		{
+			worker.rasterizerInputCache.binArena.resetPeak();
+		}
+
+		const auto workerFrameStartTime = std::chrono::high_resolution_clock::now();
+		ProcessFramePacket(packet, packet.workerCount, shouldSaveInterlaceHistory);
+		g_workerFrameTime = GetElapsedSeconds(workerFrameStartTime);
+
+		// History is only complete if the last draw call loop filled it in.
+		g_isInterlaceHistoryValid = g_shouldFinishInterlacedBins;
+		if (g_shouldFinishInterlacedBins)
+		{
+			g_interlaceHistoryReadIndex ^= 1;
+			g_interlaceHistoryViewProjMatrix = g_viewProjMatrix;
+			g_shouldFinishInterlacedBins = false;
+		}
+
+		if (packet.shouldCompareRasterPrecision)
+		{
+			CompareRasterPrecisionFrames(packet.referencePaletteIndexBuffer->begin(), packet.referenceColorBuffer->begin(),
+				packet.paletteIndexBuffer, packet.colorBuffer, frameBufferWidth * frameBufferHeight);
+		}
+
+		RendererProfilerData3D &profilerData = packet.profilerData;
+		profilerData.threadCount = g_workers.getCount();
+		profilerData.drawCallCount = g_totalDrawCallCount;
+		profilerData.sortedDrawCallCount = packet.sortedDrawCallCount;
+		profilerData.presentedTriangleCount = g_totalPresentedTriangleCount;
+		profilerData.totalLightCount = g_visibleLightCount;
+		profilerData.totalCoverageTests = g_totalCoverageTests;
+		profilerData.totalCoverageBlockAccepts = g_totalCoverageBlockAccepts;
+		profilerData.totalDepthTests = g_totalDepthTests;
+		profilerData.totalColorWrites = g_totalColorWrites;
+		profilerData.totalShadedFragments = g_totalShadedFragments;
+		profilerData.totalMipmappedFragments = g_totalMipmappedFragments;
+		profilerData.totalLitFragments = g_totalLitFragments;
+		profilerData.totalFragmentLightTests = g_totalFragmentLightTests;
+		profilerData.binArenaPeakByteCount = 0;
+		profilerData.workerBusyTimes.clear();
+		profilerData.workerIdleTimes.clear();
+		profilerData.workerStageTimes.clear();
+		profilerData.workerCpuIDs.clear();
+
+		for (const Worker &worker : g_workers)
+		{
+			profilerData.binArenaPeakByteCount += worker.rasterizerInputCache.binArena.getPeakByteCount();
+			profilerData.workerBusyTimes.emplace_back(worker.busyTime);
+			profilerData.workerIdleTimes.emplace_back(std::max(g_workerFrameTime - worker.busyTime, 0.0));
+			profilerData.workerCpuIDs.emplace_back(worker.cpuID);
+
+			if (packet.enableStageTimers)
+			{
+				profilerData.workerStageTimes.insert(profilerData.workerStageTimes.end(), std::begin(worker.stageTimes), std::end(worker.stageTimes));
+			}
+		}
+
+		const RasterizerInputCache &firstRasterizerInputCache = g_workers.get(0).rasterizerInputCache;
+		profilerData.binWidth = firstRasterizerInputCache.binWidth;
+		profilerData.binHeight = firstRasterizerInputCache.binHeight;
+		profilerData.binCount = firstRasterizerInputCache.binCountX * firstRasterizerInputCache.binCountY;
+		profilerData.binnedTriangleCount = 0;
+		profilerData.maxBinTriangleCount = 0;
+
+		for (const int binTriangleCount : g_binTriangleCounts)
+		{
+			profilerData.binnedTriangleCount += binTriangleCount;
+			profilerData.maxBinTriangleCount = std::max(profilerData.maxBinTriangleCount, binTriangleCount);
+		}
+
+		profilerData.rasterPrecisionDiffPercent = g_rasterPrecisionDiffPercent;
+		profilerData.rasterPrecisionPsnr = g_rasterPrecisionPsnr;
+	}
+
+	void CompleteFramePacket(const FramePacket &packet)
+	{
+		g_completedFrameID.store(packet.frameID, std::memory_order_seq_cst);
+		NotifyParkedThreads(g_completedFrameID, g_parkedSubmitterCount);
+	}
+
+	void FrameDirectorFunc(uint32_t directorEpoch)
+	{
+		while (true)
+		{
+			directorEpoch = SpinThenPark(g_frameDirectorEpoch, g_parkedFrameDirectorCount,
+				[directorEpoch](uint32_t epoch) { return epoch != directorEpoch; });
+			if (g_shouldFrameDirectorExit)
+			{
+				break;
+			}
+
+			FramePacket &packet = *g_frameDirectorPacket;
+			RenderFramePacket(packet);
+			CompleteFramePacket(packet);
+		}
+	}
+
+	void SignalFrameDirector(FramePacket *packet, bool shouldExit)
+	{
+		g_frameDirectorPacket = packet;
+		g_shouldFrameDirectorExit = shouldExit;
+		g_frameDirectorEpoch.fetch_add(1, std::memory_order_seq_cst);
+		NotifyParkedThreads(g_frameDirectorEpoch, g_parkedFrameDirectorCount);
+	}
+
+	void StartFrameDirector()
+	{
+		if (!g_frameDirectorThread.joinable())
+		{
+			g_frameDirectorThread = std::thread(FrameDirectorFunc, g_frameDirectorEpoch.load(std::memory_order_relaxed));
+		}
+	}
+
+	void StopFrameDirector()
+	{
+		if (g_frameDirectorThread.joinable())
+		{
+			SignalFrameDirector(nullptr, true);
+			g_frameDirectorThread.join();
+		}
+	}
+}
+
+// Draw call ordering. Order-independent draw calls are sorted front-to-back within each command list entry so
+// nearer surfaces fill the depth buffer (and depth hierarchy) first and hide more of what comes after them.
+namespace
+{
+	constexpr int DRAW_CALL_SORT_KEY_BITS = 16;
+	constexpr int DRAW_CALL_SORT_RADIX_BITS = 8;
+	constexpr int DRAW_CALL_SORT_RADIX_SIZE = 1 << DRAW_CALL_SORT_RADIX_BITS;
+	static_assert((DRAW_CALL_SORT_KEY_BITS % DRAW_CALL_SORT_RADIX_BITS) == 0);
+
+	std::vector<uint16_t> g_drawCallSortQuantizedDepths;
+	std::vector<int> g_drawCallSortOrder, g_drawCallSortScratch;
+	std::vector<DrawCallInstance> g_drawCallSortDrawCallInstances;
+	std::vector<TransformCache> g_drawCallSortTransformCaches;
+
+	// Draw calls that write depth and don't read the frame buffer give the same image in any order (except for ties).
+	bool IsDrawCallOrderIndependent(const SoftwareMaterial &material, RenderMultipassType multipassType)
+	{
+		if ((multipassType != RenderMultipassType::None) || !material.enableDepthRead || !material.enableDepthWrite)
+		{
+			return false;
+		}
+
+		switch (material.fragmentShaderType)
+		{
+		case FragmentShaderType::Opaque:
+		case FragmentShaderType::OpaqueWithAlphaTestLayer:
+		case FragmentShaderType::OpaqueScreenSpaceAnimation:
+		case FragmentShaderType::OpaqueScreenSpaceAnimationWithAlphaTestLayer:
+		case FragmentShaderType::AlphaTested:
+		case FragmentShaderType::AlphaTestedWithVariableTexCoordUMin:
+		case FragmentShaderType::AlphaTestedWithVariableTexCoordVMin:
+		case FragmentShaderType::AlphaTestedWithPaletteIndexLookup:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	// Stable LSD radix sort of draw call indices by quantized depth, ties keep submission order.
+	void RadixSortDrawCalls(const uint16_t *quantizedDepths, int count, int *order, int *scratch)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			order[i] = i;
+		}
+
+		int *srcOrder = order;
+		int *dstOrder = scratch;
+		for (int shift = 0; shift < DRAW_CALL_SORT_KEY_BITS; shift += DRAW_CALL_SORT_RADIX_BITS)
+		{
+			int offsets[DRAW_CALL_SORT_RADIX_SIZE + 1] = {};
+			for (int i = 0; i < count; i++)
+			{
+				const int digit = (quantizedDepths[srcOrder[i]] >> shift) & (DRAW_CALL_SORT_RADIX_SIZE - 1);
+				offsets[digit + 1]++;
+			}
+
+			for (int i = 1; i <= DRAW_CALL_SORT_RADIX_SIZE; i++)
+			{
+				offsets[i] += offsets[i - 1];
+			}
 
-			// Use the geometry processing results of all workers to rasterize this worker's bins. The order of workers is assumed to be
-			// the same that draw calls were originally processed, otherwise triangles in each bin would be rasterized in the wrong order.
-			for (const RasterizerWorkItem &workItem : worker.rasterizerWorkItems)
+			for (int i = 0; i < count; i++)
 			{
-				const int binX = workItem.binX;
-				const int binY = workItem.binY;
-				for (const Worker &geometryWorker : g_workers)
-				{
-					if (geometryWorker.drawCallCount > 0)
-					{
-						const RasterizerBin &geometryWorkerBin = geometryWorker.rasterizerInputCache.bins.get(binX, binY);
-						for (int entryIndex = 0; entryIndex < geometryWorkerBin.entryCount; entryIndex++)
-						{
-							const RasterizerBinEntry &binEntry = geometryWorkerBin.entries[entryIndex];
-							const int workerDrawCallIndex = binEntry.workerDrawCallIndex;
-							DebugAssertIndex(geometryWorker.drawCallCaches, workerDrawCallIndex);
-							const DrawCallCache &drawCallCache = geometryWorker.drawCallCaches[workerDrawCallIndex];
-							const RasterizerInputCache &rasterizerInputCache = geometryWorker.rasterizerInputCache;
-							RasterizeMesh(drawCallCache, rasterizerInputCache, geometryWorkerBin, binEntry, binX, binY, workItem.binIndex);
-						}
-					}
-				}
+				const int index = srcOrder[i];
+				const int digit = (quantizedDepths[index] >> shift) & (DRAW_CALL_SORT_RADIX_SIZE - 1);
+				dstOrder[offsets[digit]] = index;
+				offsets[digit]++;
 			}
 
-			workerLock.lock();
-			worker.isFinishedRasterizing = true;
+			std::swap(srcOrder, dstOrder);
 		}
+
+		static_assert(((DRAW_CALL_SORT_KEY_BITS / DRAW_CALL_SORT_RADIX_BITS) % 2) == 0, "Expected sorted order to end up back in the order array.");
 	}
 
-	void SignalWorkersToExitAndJoin()
+	// Reorders one run of consecutive order-independent draw calls front-to-back.
+	void SortDrawCallRun(FramePacket &packet, int startIndex, int count)
 	{
-		std::unique_lock<std::mutex> lock(g_mutex);
-		for (Worker &worker : g_workers)
-		{
-			worker.shouldExit = true;
-		}
-
-		g_workerCondVar.notify_all();
-		lock.unlock();
+		const DrawCallSortKey *sortKeys = packet.drawCallSortKeys.data() + startIndex;
 
-		for (Worker &worker : g_workers)
+		double minDepth = sortKeys[0].viewDepth;
+		double maxDepth = minDepth;
+		for (int i = 1; i < count; i++)
 		{
-			worker.thread.join();
+			minDepth = std::min(minDepth, sortKeys[i].viewDepth);
+			maxDepth = std::max(maxDepth, sortKeys[i].viewDepth);
 		}
-	}
 
-	void InitializeWorkers(int workerCount, int frameBufferWidth, int frameBufferHeight)
-	{
-		if (g_workers.getCount() != workerCount)
+		const double depthRange = maxDepth - minDepth;
+		if (depthRange <= 0.0)
 		{
-			SignalWorkersToExitAndJoin();
-
-			g_workers.init(workerCount);
-			for (int workerIndex = 0; workerIndex < workerCount; workerIndex++)
-			{
-				Worker &worker = g_workers[workerIndex];
-				worker.drawCallStartIndex = -1;
-				worker.drawCallCount = 0;
-				worker.rasterizerInputCache.createBins(frameBufferWidth, frameBufferHeight);
-				worker.isReadyToStartWork = false;
-				worker.shouldExit = false;
-				worker.shouldWorkOnDrawCalls = false;
-				worker.shouldClearFrameBuffer = false;
-				worker.isFinishedWithDrawCalls = false;
-				worker.shouldWorkOnRasterizing = false;
-				worker.isFinishedRasterizing = false;
-				worker.thread = std::thread(WorkerFunc, workerIndex);
-			}
+			return;
 		}
 
-		for (Worker &worker : g_workers)
+		constexpr double maxQuantizedDepth = static_cast<double>((1 << DRAW_CALL_SORT_KEY_BITS) - 1);
+		const double depthToQuantized = maxQuantizedDepth / depthRange;
+
+		g_drawCallSortQuantizedDepths.resize(count);
+		g_drawCallSortOrder.resize(count);
+		g_drawCallSortScratch.resize(count);
+		for (int i = 0; i < count; i++)
 		{
-			worker.rasterizerWorkItems.clear();
+			g_drawCallSortQuantizedDepths[i] = static_cast<uint16_t>((sortKeys[i].viewDepth - minDepth) * depthToQuantized);
 		}
 
-		const Worker &firstWorker = g_workers.get(0);
-		const int binCountX = firstWorker.rasterizerInputCache.binCountX;
-		const int binCountY = firstWorker.rasterizerInputCache.binCountY;
+		RadixSortDrawCalls(g_drawCallSortQuantizedDepths.data(), count, g_drawCallSortOrder.data(), g_drawCallSortScratch.data());
 
-		// Split up rasterizer bins across workers.
-		int curWorkerIndex = 0;
-		for (int binY = 0; binY < binCountY; binY++)
+		const auto drawCallInstancesBegin = packet.drawCallInstances.begin() + startIndex;
+		const auto transformCachesBegin = packet.transformCaches.begin() + startIndex;
+		g_drawCallSortDrawCallInstances.assign(drawCallInstancesBegin, drawCallInstancesBegin + count);
+		g_drawCallSortTransformCaches.assign(transformCachesBegin, transformCachesBegin + count);
+		for (int i = 0; i < count; i++)
 		{
-			for (int binX = 0; binX < binCountX; binX++)
-			{
-				const int binIndex = binX + (binY * binCountX);
-				Worker &worker = g_workers[curWorkerIndex];
-				worker.rasterizerWorkItems.emplace_back(binX, binY, binIndex);
-				curWorkerIndex = (curWorkerIndex + 1) % workerCount;
-			}
+			const int srcIndex = g_drawCallSortOrder[i];
+			drawCallInstancesBegin[i] = g_drawCallSortDrawCallInstances[srcIndex];
+			transformCachesBegin[i] = g_drawCallSortTransformCaches[srcIndex];
 		}
 	}
 
-	void PopulateWorkerDrawCallWorkloads(int workerCount, int startDrawCallIndex, int drawCallCount)
+	// Order-dependent draw calls stay in place and split the entry into separately sorted runs.
+	int SortOrderIndependentDrawCalls(FramePacket &packet)
 	{
-		const int baseDrawCallsPerWorker = drawCallCount / workerCount;
-		const int workersWithExtraDrawCall = drawCallCount % workerCount;
-
-		int workerStartDrawCallIndex = startDrawCallIndex;
-		for (int i = 0; i < workerCount; i++)
+		int sortedDrawCallCount = 0;
+		int entryStartIndex = 0;
+		for (const int entryDrawCallCount : packet.entryDrawCallCounts)
 		{
-			Worker &worker = g_workers[i];
-			worker.drawCallStartIndex = workerStartDrawCallIndex;
-			worker.drawCallCount = baseDrawCallsPerWorker;
-
-			if (i < workersWithExtraDrawCall)
+			const int entryEndIndex = entryStartIndex + entryDrawCallCount;
+			int runStartIndex = entryStartIndex;
+			while (runStartIndex < entryEndIndex)
 			{
-				worker.drawCallCount++;
+				if (!packet.drawCallSortKeys[runStartIndex].isOrderIndependent)
+				{
+					runStartIndex++;
+					continue;
+				}
+
+				int runEndIndex = runStartIndex + 1;
+				while ((runEndIndex < entryEndIndex) && packet.drawCallSortKeys[runEndIndex].isOrderIndependent)
+				{
+					runEndIndex++;
+				}
+
+				const int runCount = runEndIndex - runStartIndex;
+				if (runCount > 1)
+				{
+					SortDrawCallRun(packet, runStartIndex, runCount);
+					sortedDrawCallCount += runCount;
+				}
+
+				runStartIndex = runEndIndex;
 			}
 
-			workerStartDrawCallIndex += worker.drawCallCount;
+			entryStartIndex = entryEndIndex;
 		}
 
-		DebugAssert((workerStartDrawCallIndex - startDrawCallIndex) == drawCallCount);
-	}
-
-	void ShutdownWorkers()
-	{
-		SignalWorkersToExitAndJoin();
-		g_workers.clear();
+		return sortedDrawCallCount;
 	}
 }
 
@@ -3939,6 +7035,17 @@ SoftwareObjectTexture::SoftwareObjectTexture()
 	this->heightReal = 0.0;
 	this->texelCount = 0;
 	this->bytesPerTexel = 0;
+	this->version = 0;
+	this->lastFrameID = 0;
+	std::fill(std::begin(this->mipLevelTexels), std::end(this->mipLevelTexels), nullptr);
+	std::fill(std::begin(this->mipLevelTiledTexels), std::end(this->mipLevelTiledTexels), nullptr);
+	std::fill(std::begin(this->mipLevelWidths), std::end(this->mipLevelWidths), 0);
+	std::fill(std::begin(this->mipLevelHeights), std::end(this->mipLevelHeights), 0);
+	std::fill(std::begin(this->mipLevelTileCountXs), std::end(this->mipLevelTileCountXs), 0);
+	this->mipLevelCount = 0;
+	this->hasMipTexels = false;
+	this->hasTiledTexels = false;
+	this->sampledTexelsVersion = 0;
 }
 
 void SoftwareObjectTexture::init(int width, int height, int bytesPerTexel)
@@ -3969,23 +7076,238 @@ void SoftwareObjectTexture::init(int width, int height, int bytesPerTexel)
 	this->widthReal = static_cast<double>(width);
 	this->heightReal = static_cast<double>(height);
 	this->bytesPerTexel = bytesPerTexel;
+	this->version = g_nextResourceVersion++;
+	this->lastFrameID = 0;
+
+	this->mipTexels.clear();
+	this->tiledTexels.clear();
+	this->mipLevelTexels[0] = this->texels8Bit;
+	this->mipLevelTiledTexels[0] = nullptr;
+	this->mipLevelWidths[0] = width;
+	this->mipLevelHeights[0] = height;
+	this->mipLevelTileCountXs[0] = 0;
+	this->mipLevelCount = 1;
+	this->hasMipTexels = false;
+	this->hasTiledTexels = false;
+	this->sampledTexelsVersion = 0;
 }
 
 void SoftwareObjectTexture::clear()
 {
 	this->texels.clear();
+	this->mipTexels.clear();
+	this->tiledTexels.clear();
+	this->mipLevelCount = 0;
+	this->hasMipTexels = false;
+	this->hasTiledTexels = false;
+	this->sampledTexelsVersion = 0;
+}
+
+bool SoftwareObjectTexture::needsSampledTexelsUpdate(bool enableMipmaps, bool enableTiledTexels) const
+{
+	if (this->bytesPerTexel != 1)
+	{
+		return false;
+	}
+
+	return (this->sampledTexelsVersion != this->version) || (this->hasMipTexels != enableMipmaps) || (this->hasTiledTexels != enableTiledTexels);
+}
+
+void SoftwareObjectTexture::updateSampledTexels(bool enableMipmaps, bool enableTiledTexels)
+{
+	DebugAssert(this->bytesPerTexel == 1);
+
+	// Sizes only change when the settings do, so the sampled copies are usually just refilled.
+	if ((this->sampledTexelsVersion == 0) || (this->hasMipTexels != enableMipmaps) || (this->hasTiledTexels != enableTiledTexels))
+	{
+		this->mipLevelCount = 1;
+
+		int mipTexelCount = 0;
+		int tiledTexelCount = getTileCount(this->width) * getTileCount(this->height) * TILE_TEXEL_COUNT;
+		int levelWidth = this->width;
+		int levelHeight = this->height;
+		while (enableMipmaps && ((levelWidth > 1) || (levelHeight > 1)) && (this->mipLevelCount < MAX_MIP_LEVELS))
+		{
+			levelWidth = std::max(levelWidth / 2, 1);
+			levelHeight = std::max(levelHeight / 2, 1);
+			this->mipLevelWidths[this->mipLevelCount] = levelWidth;
+			this->mipLevelHeights[this->mipLevelCount] = levelHeight;
+			mipTexelCount += levelWidth * levelHeight;
+			tiledTexelCount += getTileCount(levelWidth) * getTileCount(levelHeight) * TILE_TEXEL_COUNT;
+			this->mipLevelCount++;
+		}
+
+		if (mipTexelCount > 0)
+		{
+			this->mipTexels.init(mipTexelCount);
+		}
+		else
+		{
+			this->mipTexels.clear();
+		}
+
+		if (enableTiledTexels)
+		{
+			this->tiledTexels.init(tiledTexelCount);
+			this->tiledTexels.fill(0);
+		}
+		else
+		{
+			this->tiledTexels.clear();
+		}
+
+		const uint8_t *mipLevelTexelsPtr = this->mipTexels.begin();
+		const uint8_t *mipLevelTiledTexelsPtr = this->tiledTexels.begin();
+		for (int level = 0; level < this->mipLevelCount; level++)
+		{
+			const int mipLevelWidth = this->mipLevelWidths[level];
+			const int mipLevelHeight = this->mipLevelHeights[level];
+			if (level > 0)
+			{
+				this->mipLevelTexels[level] = mipLevelTexelsPtr;
+				mipLevelTexelsPtr += mipLevelWidth * mipLevelHeight;
+			}
+
+			if (enableTiledTexels)
+			{
+				const int tileCountX = getTileCount(mipLevelWidth);
+				this->mipLevelTiledTexels[level] = mipLevelTiledTexelsPtr;
+				this->mipLevelTileCountXs[level] = tileCountX;
+				mipLevelTiledTexelsPtr += tileCountX * getTileCount(mipLevelHeight) * TILE_TEXEL_COUNT;
+			}
+			else
+			{
+				this->mipLevelTiledTexels[level] = nullptr;
+				this->mipLevelTileCountXs[level] = 0;
+			}
+		}
+
+		this->hasMipTexels = enableMipmaps;
+		this->hasTiledTexels = enableTiledTexels;
+	}
+
+	uint8_t *dstTexels = this->mipTexels.begin();
+	for (int level = 1; level < this->mipLevelCount; level++)
+	{
+		const uint8_t *srcTexels = this->mipLevelTexels[level - 1];
+		const int srcWidth = this->mipLevelWidths[level - 1];
+		const int srcHeight = this->mipLevelHeights[level - 1];
+		const int dstWidth = this->mipLevelWidths[level];
+		const int dstHeight = this->mipLevelHeights[level];
+
+		for (int dstY = 0; dstY < dstHeight; dstY++)
+		{
+			const int srcY0 = std::min(dstY * 2, srcHeight - 1);
+			const int srcY1 = std::min(srcY0 + 1, srcHeight - 1);
+
+			for (int dstX = 0; dstX < dstWidth; dstX++)
+			{
+				const int srcX0 = std::min(dstX * 2, srcWidth - 1);
+				const int srcX1 = std::min(srcX0 + 1, srcWidth - 1);
+				const uint8_t samples[] =
+				{
+					srcTexels[srcX0 + (srcY0 * srcWidth)],
+					srcTexels[srcX1 + (srcY0 * srcWidth)],
+					srcTexels[srcX0 + (srcY1 * srcWidth)],
+					srcTexels[srcX1 + (srcY1 * srcWidth)]
+				};
+
+				// Palette indices can't be averaged, so pick the most common opaque one. Mostly-transparent
+				// footprints stay transparent so alpha-tested sprites keep their silhouette at a distance.
+				int transparentCount = 0;
+				for (const uint8_t sample : samples)
+				{
+					transparentCount += (sample == ArenaRenderUtils::PALETTE_INDEX_TRANSPARENT) ? 1 : 0;
+				}
+
+				uint8_t dstTexel = ArenaRenderUtils::PALETTE_INDEX_TRANSPARENT;
+				if ((transparentCount * 2) <= static_cast<int>(std::size(samples)))
+				{
+					int bestCount = 0;
+					for (const uint8_t sample : samples)
+					{
+						if (sample == ArenaRenderUtils::PALETTE_INDEX_TRANSPARENT)
+						{
+							continue;
+						}
+
+						const int count = static_cast<int>(std::count(std::begin(samples), std::end(samples), sample));
+						if (count > bestCount)
+						{
+							dstTexel = sample;
+							bestCount = count;
+						}
+					}
+				}
+
+				dstTexels[dstX + (dstY * dstWidth)] = dstTexel;
+			}
+		}
+
+		dstTexels += dstWidth * dstHeight;
+	}
+
+	if (!this->hasTiledTexels)
+	{
+		this->sampledTexelsVersion = this->version;
+		return;
+	}
+
+	uint8_t *dstTiledTexels = this->tiledTexels.begin();
+	for (int level = 0; level < this->mipLevelCount; level++)
+	{
+		const uint8_t *srcTexels = this->mipLevelTexels[level];
+		const int levelWidth = this->mipLevelWidths[level];
+		const int levelHeight = this->mipLevelHeights[level];
+		const int tileCountX = this->mipLevelTileCountXs[level];
+
+		for (int y = 0; y < levelHeight; y++)
+		{
+			for (int x = 0; x < levelWidth; x++)
+			{
+				dstTiledTexels[getTiledTexelIndex(x, y, tileCountX)] = srcTexels[x + (y * levelWidth)];
+			}
+		}
+
+		dstTiledTexels += tileCountX * getTileCount(levelHeight) * TILE_TEXEL_COUNT;
+	}
+
+	this->sampledTexelsVersion = this->version;
+}
+
+SoftwareWorldMeshCache::SoftwareWorldMeshCache()
+{
+	this->invalidate();
+}
+
+void SoftwareWorldMeshCache::invalidate()
+{
+	this->triangleCount = 0;
+	this->modelMatrix = Matrix4d::identity();
+	this->positionBufferID = -1;
+	this->indexBufferID = -1;
+	this->texCoordBufferID = -1;
+	this->positionBufferVersion = 0;
+	this->indexBufferVersion = 0;
+	this->texCoordBufferVersion = 0;
+	this->lastFrameID = 0;
+	this->isBuilt = false;
 }
 
 void SoftwareVertexPositionBuffer::init(int vertexCount, int componentsPerVertex)
 {
 	const int valueCount = vertexCount * componentsPerVertex;
 	this->positions.init(valueCount);
+	this->version = g_nextResourceVersion++;
+	this->lastFrameID = 0;
 }
 
 void SoftwareVertexAttributeBuffer::init(int vertexCount, int componentsPerVertex)
 {
 	const int valueCount = vertexCount * componentsPerVertex;
 	this->attributes.init(valueCount);
+	this->version = g_nextResourceVersion++;
+	this->lastFrameID = 0;
 }
 
 void SoftwareIndexBuffer::init(int indexCount)
@@ -3993,6 +7315,8 @@ void SoftwareIndexBuffer::init(int indexCount)
 	DebugAssertMsg((indexCount % 3) == 0, "Expected index buffer to have multiple of 3 indices (has " + std::to_string(indexCount) + ").");
 	this->indices.init(indexCount);
 	this->triangleCount = indexCount / 3;
+	this->version = g_nextResourceVersion++;
+	this->lastFrameID = 0;
 }
 
 SoftwareUniformBuffer::SoftwareUniformBuffer()
@@ -4000,6 +7324,7 @@ SoftwareUniformBuffer::SoftwareUniformBuffer()
 	this->elementCount = 0;
 	this->bytesPerElement = 0;
 	this->alignmentOfElement = 0;
+	this->lastFrameID = 0;
 }
 
 void SoftwareUniformBuffer::init(int elementCount, int bytesPerElement, int alignmentOfElement)
@@ -4015,6 +7340,8 @@ void SoftwareUniformBuffer::init(int elementCount, int bytesPerElement, int alig
 	const int padding = this->alignmentOfElement - 1; // Add padding in case of alignment.
 	const int byteCount = (elementCount * this->bytesPerElement) + padding;
 	this->bytes.init(byteCount);
+	this->worldMeshCaches.clear();
+	this->lastFrameID = 0;
 }
 
 std::byte *SoftwareUniformBuffer::begin()
@@ -4132,7 +7459,10 @@ void SoftwareLight::init(const Double3 &point, double startRadius, double endRad
 
 SoftwareRenderer::SoftwareRenderer()
 {
-
+	this->frameBufferWidth = 0;
+	this->frameBufferHeight = 0;
+	this->queuedColorBufferIndex = -1;
+	this->staticColorBufferIndex = -1;
 }
 
 SoftwareRenderer::~SoftwareRenderer()
@@ -4146,8 +7476,15 @@ bool SoftwareRenderer::init(const RenderInitSettings &initSettings)
 	const int frameBufferHeight = initSettings.internalHeight;
 	this->paletteIndexBuffer.init(frameBufferWidth, frameBufferHeight);
 	this->depthBuffer.init(frameBufferWidth, frameBufferHeight);
+	this->visibilityBuffer.init(frameBufferWidth, frameBufferHeight);
+	this->visibilityBuffer.fill(-1);
+	this->frameBufferWidth = frameBufferWidth;
+	this->frameBufferHeight = frameBufferHeight;
+
+	InitSimdKernels();
 
 	const int workerCount = RendererUtils::getRenderThreadsFromMode(initSettings.renderThreadsMode);
+	UpdateRasterizerBinLayout(frameBufferWidth, frameBufferHeight, false);
 	InitializeWorkers(workerCount, frameBufferWidth, frameBufferHeight);
 
 	return true;
@@ -4155,8 +7492,25 @@ bool SoftwareRenderer::init(const RenderInitSettings &initSettings)
 
 void SoftwareRenderer::shutdown()
 {
+	WaitForQueuedFrame();
+	StopFrameDirector();
+
 	this->paletteIndexBuffer.clear();
 	this->depthBuffer.clear();
+	this->singlePrecisionDepthBuffer.clear();
+	this->visibilityBuffer.clear();
+	this->frameBufferWidth = 0;
+	this->frameBufferHeight = 0;
+	this->referencePaletteIndexBuffer.clear();
+	this->referenceColorBuffer.clear();
+
+	for (Buffer2D<uint32_t> &colorBuffer : this->queuedColorBuffers)
+	{
+		colorBuffer.clear();
+	}
+
+	this->queuedColorBufferIndex = -1;
+	this->staticColorBufferIndex = -1;
 	this->positionBuffers.clear();
 	this->attributeBuffers.clear();
 	this->indexBuffers.clear();
@@ -4174,38 +7528,54 @@ bool SoftwareRenderer::isInited() const
 
 void SoftwareRenderer::resize(int width, int height)
 {
-	this->paletteIndexBuffer.init(width, height);
-	this->paletteIndexBuffer.fill(0);
+	// Frame buffers only grow so a smaller internal resolution (i.e. from dynamic resolution) can be picked up by the next
+	// frame without waiting on the queued one. Bins are rebuilt on the render thread when the next frame's layout differs.
+	const int frameBufferCapacity = this->paletteIndexBuffer.getWidth() * this->paletteIndexBuffer.getHeight();
+	if ((width * height) > frameBufferCapacity)
+	{
+		WaitForQueuedFrame();
 
-	this->depthBuffer.init(width, height);
-	this->depthBuffer.fill(Constants::Infinity);
+		this->paletteIndexBuffer.init(width, height);
+		this->paletteIndexBuffer.fill(0);
 
-	for (Worker &worker : g_workers)
-	{
-		worker.rasterizerInputCache.createBins(width, height);
+		this->depthBuffer.init(width, height);
+		this->depthBuffer.fill(Constants::Infinity);
+
+		this->visibilityBuffer.init(width, height);
+		this->visibilityBuffer.fill(-1);
 	}
+
+	this->frameBufferWidth = width;
+	this->frameBufferHeight = height;
 }
 
 RendererProfilerData3D SoftwareRenderer::getProfilerData() const
 {
+	// Counters come from the last frame that finished rendering, which isn't the one in progress if it's queued.
 	RendererProfilerData3D profilerData;
-	profilerData.width = this->paletteIndexBuffer.getWidth();
-	profilerData.height = this->paletteIndexBuffer.getHeight();
-	profilerData.threadCount = g_workers.getCount();
-	profilerData.drawCallCount = g_totalDrawCallCount;
-	profilerData.presentedTriangleCount = g_totalPresentedTriangleCount;
+	const uint32_t completedFrameID = g_completedFrameID.load(std::memory_order_acquire);
+	if (completedFrameID > 0)
+	{
+		profilerData = GetFramePacket(completedFrameID).profilerData;
+	}
+
+	profilerData.width = this->frameBufferWidth;
+	profilerData.height = this->frameBufferHeight;
+	profilerData.reusedFrameCount = g_reusedFrameCount;
 	profilerData.objectTextureCount = this->objectTextures.getCount();
 
 	for (const SoftwareObjectTexture &texture : this->objectTextures.values)
 	{
 		profilerData.objectTextureByteCount += texture.texels.getCount();
+		if (texture.hasTiledTexels)
+		{
+			profilerData.objectTextureByteCount += texture.tiledTexels.getCount();
+		}
+
+		profilerData.objectTextureMipByteCount += texture.mipTexels.getCount();
 	}
 
 	profilerData.materialCount = static_cast<int>(this->materials.values.size());
-	profilerData.totalLightCount = g_visibleLightCount;
-	profilerData.totalCoverageTests = g_totalCoverageTests;
-	profilerData.totalDepthTests = g_totalDepthTests;
-	profilerData.totalColorWrites = g_totalColorWrites;
 
 	return profilerData;
 }
@@ -4221,6 +7591,8 @@ VertexPositionBufferID SoftwareRenderer::createVertexPositionBuffer(int vertexCo
 	DebugAssert(componentsPerVertex >= 2);
 	DebugAssert(bytesPerComponent == sizeof(double));
 
+	WaitForQueuedFrame();
+
 	const VertexPositionBufferID id = this->positionBuffers.alloc();
 	if (id < 0)
 	{
@@ -4235,12 +7607,16 @@ VertexPositionBufferID SoftwareRenderer::createVertexPositionBuffer(int vertexCo
 
 void SoftwareRenderer::freeVertexPositionBuffer(VertexPositionBufferID id)
 {
+	WaitForQueuedFrame();
 	this->positionBuffers.free(id);
 }
 
 LockedBuffer SoftwareRenderer::lockVertexPositionBuffer(VertexPositionBufferID id)
 {
 	SoftwareVertexPositionBuffer &buffer = this->positionBuffers.get(id);
+	WaitForQueuedFrameIfReading(buffer.lastFrameID);
+	buffer.version = g_nextResourceVersion++;
+
 	const int elementCount = buffer.positions.getCount();
 	const int bytesPerElement = sizeof(double);
 	const int byteCount = elementCount * bytesPerElement;
@@ -4259,6 +7635,8 @@ VertexAttributeBufferID SoftwareRenderer::createVertexAttributeBuffer(int vertex
 	DebugAssert(componentsPerVertex >= 2);
 	DebugAssert(bytesPerComponent == sizeof(double));
 
+	WaitForQueuedFrame();
+
 	const VertexAttributeBufferID id = this->attributeBuffers.alloc();
 	if (id < 0)
 	{
@@ -4273,12 +7651,16 @@ VertexAttributeBufferID SoftwareRenderer::createVertexAttributeBuffer(int vertex
 
 void SoftwareRenderer::freeVertexAttributeBuffer(VertexAttributeBufferID id)
 {
+	WaitForQueuedFrame();
 	this->attributeBuffers.free(id);
 }
 
 LockedBuffer SoftwareRenderer::lockVertexAttributeBuffer(VertexAttributeBufferID id)
 {
 	SoftwareVertexAttributeBuffer &buffer = this->attributeBuffers.get(id);
+	WaitForQueuedFrameIfReading(buffer.lastFrameID);
+	buffer.version = g_nextResourceVersion++;
+
 	const int elementCount = buffer.attributes.getCount();
 	const int bytesPerElement = sizeof(double);
 	const int byteCount = elementCount * bytesPerElement;
@@ -4297,6 +7679,8 @@ IndexBufferID SoftwareRenderer::createIndexBuffer(int indexCount, int bytesPerIn
 	DebugAssert((indexCount % 3) == 0);
 	DebugAssert(bytesPerIndex == sizeof(int32_t));
 
+	WaitForQueuedFrame();
+
 	const IndexBufferID id = this->indexBuffers.alloc();
 	if (id < 0)
 	{
@@ -4311,12 +7695,16 @@ IndexBufferID SoftwareRenderer::createIndexBuffer(int indexCount, int bytesPerIn
 
 void SoftwareRenderer::freeIndexBuffer(IndexBufferID id)
 {
+	WaitForQueuedFrame();
 	this->indexBuffers.free(id);
 }
 
 LockedBuffer SoftwareRenderer::lockIndexBuffer(IndexBufferID id)
 {
 	SoftwareIndexBuffer &buffer = this->indexBuffers.get(id);
+	WaitForQueuedFrameIfReading(buffer.lastFrameID);
+	buffer.version = g_nextResourceVersion++;
+
 	const int elementCount = buffer.indices.getCount();
 	const int bytesPerElement = sizeof(int32_t);
 	const int byteCount = elementCount * bytesPerElement;
@@ -4349,6 +7737,8 @@ UniformBufferID SoftwareRenderer::createUniformBuffer(int elementCount, int byte
 
 void SoftwareRenderer::freeUniformBuffer(UniformBufferID id)
 {
+	const SoftwareUniformBuffer &buffer = this->uniformBuffers.get(id);
+	WaitForQueuedFrameIfReading(buffer.lastFrameID);
 	this->uniformBuffers.free(id);
 }
 
@@ -4386,6 +7776,8 @@ void SoftwareRenderer::unlockUniformBufferIndex(UniformBufferID id, int index)
 
 ObjectTextureID SoftwareRenderer::createTexture(int width, int height, int bytesPerTexel)
 {
+	WaitForQueuedFrame();
+
 	const ObjectTextureID textureID = this->objectTextures.alloc();
 	if (textureID < 0)
 	{
@@ -4400,6 +7792,7 @@ ObjectTextureID SoftwareRenderer::createTexture(int width, int height, int bytes
 
 void SoftwareRenderer::freeTexture(ObjectTextureID textureID)
 {
+	WaitForQueuedFrame();
 	this->objectTextures.free(textureID);
 }
 
@@ -4412,13 +7805,16 @@ std::optional<Int2> SoftwareRenderer::tryGetTextureDims(ObjectTextureID id) cons
 LockedTexture SoftwareRenderer::lockTexture(ObjectTextureID textureID)
 {
 	SoftwareObjectTexture &texture = this->objectTextures.get(textureID);
+	WaitForQueuedFrameIfReading(texture.lastFrameID);
+	texture.version = g_nextResourceVersion++;
+
 	const int byteCount = texture.width * texture.height * texture.bytesPerTexel;
 	return LockedTexture(Span<std::byte>(texture.texels.begin(), byteCount), texture.width, texture.height, texture.bytesPerTexel);
 }
 
 void SoftwareRenderer::unlockTexture(ObjectTextureID textureID)
 {
-	// Do nothing; any writes are already in RAM.
+	// Writes are already in RAM. Mip levels and tiled copies are refreshed when a material next samples the texture.
 	static_cast<void>(textureID);
 }
 
@@ -4486,162 +7882,269 @@ void SoftwareRenderer::submitFrame(const RenderDrawCommandList &commandList, con
 	const RenderFrameSettings &settings, uint32_t *outputBuffer)
 {
 	const int totalDrawCallCount = commandList.getTotalDrawCallCount();
-	const int frameBufferWidth = this->paletteIndexBuffer.getWidth();
-	const int frameBufferHeight = this->paletteIndexBuffer.getHeight();
-
-	const SoftwareUniformBuffer &visibleLights = this->uniformBuffers.get(settings.visibleLightsBufferID);
-	const SoftwareObjectTexture &paletteTexture = this->objectTextures.get(settings.paletteTextureID);
-	const SoftwareObjectTexture &lightTableTexture = this->objectTextures.get(settings.lightTableTextureID);
-	const SoftwareObjectTexture &ditherTexture = this->objectTextures.get(settings.ditherTextureID);
-	const SoftwareObjectTexture &skyBgTexture = this->objectTextures.get(settings.skyBgTextureID);
-
-	PopulateCameraGlobals(camera);
-	PopulateDrawCallGlobals(totalDrawCallCount);
-	PopulateRasterizerGlobals(frameBufferWidth, frameBufferHeight, this->paletteIndexBuffer.begin(), this->depthBuffer.begin(),
-		settings.ditheringMode, outputBuffer, &this->objectTextures);
-	PopulateVisibleLights(visibleLights, settings.visibleLightCount);
-	InitLightBins(frameBufferWidth, frameBufferHeight);
-	PopulateFragmentShaderGlobals(settings.ambientPercent, settings.screenSpaceAnimPercent, camera.horizonNdcPoint, paletteTexture,
-		lightTableTexture, ditherTexture, skyBgTexture);
-
-	const int totalWorkerCount = RendererUtils::getRenderThreadsFromMode(settings.renderThreadsMode);
-	InitializeWorkers(totalWorkerCount, frameBufferWidth, frameBufferHeight);
-
-	ClearTriangleTotalCounts();
-	ClearFrameBufferOperationCounts();
-
-	bool shouldWorkersClearFrameBuffer = true; // Once per frame.
-	std::unique_lock<std::mutex> lock(g_mutex);
-
+	const int totalInstanceCount = commandList.getTotalInstanceCount();
+	const int frameBufferWidth = this->frameBufferWidth;
+	const int frameBufferHeight = this->frameBufferHeight;
+
+	// The other packet belongs to the queued frame (if any), this one is free.
+	const uint32_t frameID = g_submittedFrameID + 1;
+	FramePacket &packet = GetFramePacket(frameID);
+	packet.frameID = frameID;
+	packet.camera = camera;
+	packet.drawCallCaches.resize(totalDrawCallCount);
+	packet.drawCallInstances.resize(totalInstanceCount);
+	packet.transformCaches.resize(totalInstanceCount);
+	packet.drawCallInstanceSources.resize(totalInstanceCount);
+	packet.drawCallSortKeys.resize(totalInstanceCount);
+	packet.entryDrawCallCounts.clear();
+
+	uint32_t resourceVersion = 0;
+	int drawCallCacheIndex = 0;
+	int drawCallIndex = 0;
 	for (int commandIndex = 0; commandIndex < commandList.entryCount; commandIndex++)
 	{
 		const Span<const RenderDrawCall> drawCalls = commandList.entries[commandIndex];
-		int startDrawCallIndex = 0;
-		int remainingDrawCallCount = drawCalls.getCount();
-		constexpr int maxDrawCallsPerLoop = 8192;
-		static_assert(maxDrawCallsPerLoop <= MAX_WORKER_DRAW_CALLS_PER_LOOP);
-
-		while (remainingDrawCallCount > 0)
-		{
-			// Wait for all workers to be ready to process this set of draw calls.
-			g_directorCondVar.wait(lock, []()
+		const int entryStartDrawCallIndex = drawCallIndex;
+
+		for (const RenderDrawCall &drawCall : drawCalls)
+		{
+			DebugAssert(drawCall.instanceCount >= 1);
+			DrawCallCache &drawCallCache = packet.drawCallCaches[drawCallCacheIndex];
+
+			// Vertex buffers and textures are read in place, remember which frame last needs them.
+			SoftwareVertexPositionBuffer &positionBuffer = this->positionBuffers.get(drawCall.positionBufferID);
+			SoftwareVertexAttributeBuffer &texCoordBuffer = this->attributeBuffers.get(drawCall.texCoordBufferID);
+			SoftwareIndexBuffer &indexBuffer = this->indexBuffers.get(drawCall.indexBufferID);
+			positionBuffer.lastFrameID = frameID;
+			texCoordBuffer.lastFrameID = frameID;
+			indexBuffer.lastFrameID = frameID;
+			drawCallCache.positionBuffer = &positionBuffer;
+			drawCallCache.texCoordBuffer = &texCoordBuffer;
+			drawCallCache.indexBuffer = &indexBuffer;
+			resourceVersion = std::max(resourceVersion, std::max(positionBuffer.version, std::max(texCoordBuffer.version, indexBuffer.version)));
+
+			const SoftwareMaterial &material = this->materials.get(drawCall.materialID);
+			for (int i = 0; i < material.textureCount; i++)
 			{
-				return std::all_of(g_workers.begin(), g_workers.end(), [](const Worker &worker) { return worker.isReadyToStartWork; });
-			});
+				SoftwareObjectTexture &texture = this->objectTextures.get(material.textureIDs[i]);
+				if (texture.needsSampledTexelsUpdate(settings.enableMipmaps, settings.enableTiledTexels))
+				{
+					// Only material samplers get mip levels and tiled copies, built on first use and after each write.
+					WaitForQueuedFrameIfReading(texture.lastFrameID);
+					texture.updateSampledTexels(settings.enableMipmaps, settings.enableTiledTexels);
+				}
 
-			for (Worker &worker : g_workers)
+				texture.lastFrameID = frameID;
+				resourceVersion = std::max(resourceVersion, texture.version);
+			}
+
+			drawCallCache.textureID0 = material.textureIDs[0];
+			drawCallCache.textureID1 = material.textureIDs[1];
+			drawCallCache.lightingType = material.lightingType;
+			drawCallCache.meshLightPercent = 0.0;
+			drawCallCache.vertexShaderType = material.vertexShaderType;
+			drawCallCache.fragmentShaderType = material.fragmentShaderType;
+			drawCallCache.texCoordAnimPercent = 0.0;
+			drawCallCache.enableBackFaceCulling = material.enableBackFaceCulling;
+			drawCallCache.enableDepthRead = material.enableDepthRead;
+			drawCallCache.enableDepthWrite = material.enableDepthWrite;
+
+			if (drawCall.materialInstID >= 0)
 			{
-				DebugAssert(!worker.shouldExit);
-				DebugAssert(!worker.shouldWorkOnDrawCalls);
-				DebugAssert(!worker.shouldClearFrameBuffer);
-				DebugAssert(!worker.isFinishedWithDrawCalls);
-				DebugAssert(!worker.shouldWorkOnRasterizing);
-				DebugAssert(!worker.isFinishedRasterizing);
-				worker.isReadyToStartWork = false;
-				worker.rasterizerInputCache.clearTriangles();
-				worker.rasterizerInputCache.emptyBins();
+				const SoftwareMaterialInstance &materialInst = this->materialInsts.get(drawCall.materialInstID);
+				drawCallCache.meshLightPercent = materialInst.meshLightPercent;
+				drawCallCache.texCoordAnimPercent = materialInst.texCoordAnimPercent;
 			}
 
-			// Determine which workers get which draw calls this loop.
-			const int drawCallsToConsume = std::min(maxDrawCallsPerLoop, remainingDrawCallCount);
-			PopulateWorkerDrawCallWorkloads(totalWorkerCount, startDrawCallIndex, drawCallsToConsume);
+			const bool isOrderIndependent = settings.enableDrawCallSorting && IsDrawCallOrderIndependent(material, drawCall.multipassType);
+			SoftwareUniformBuffer &transformBuffer = this->uniformBuffers.get(drawCall.transformBufferID);
+
+			// Each transform element has its own world mesh cache, so voxels sharing a chunk's mesh for their shape all reuse theirs.
+			const bool canUseWorldMeshCache = material.vertexShaderType == VertexShaderType::Basic;
+			if (canUseWorldMeshCache && !transformBuffer.worldMeshCaches.isValid())
+			{
+				transformBuffer.worldMeshCaches.init(transformBuffer.elementCount);
+			}
 
-			// Populate worker draw call caches so they have data to work with.
-			for (Worker &worker : g_workers)
+			// Instances share the draw call's cache, only the transform, sort key, and world mesh cache are per-instance.
+			// The first instance to use a transform element this frame claims its world mesh cache, the rest go without.
+			for (int instanceIndex = 0; instanceIndex < drawCall.instanceCount; instanceIndex++)
 			{
-				for (int workerDrawCallIndex = 0; workerDrawCallIndex < worker.drawCallCount; workerDrawCallIndex++)
+				const int transformIndex = drawCall.transformIndex + instanceIndex;
+
+				DrawCallInstance &drawCallInstance = packet.drawCallInstances[drawCallIndex];
+				drawCallInstance.drawCallCacheIndex = drawCallCacheIndex;
+				drawCallInstance.worldMeshCache = nullptr;
+				drawCallInstance.shouldBuildWorldMeshCache = false;
+
+				if (canUseWorldMeshCache)
 				{
-					const int globalDrawCallIndex = worker.drawCallStartIndex + workerDrawCallIndex;
-					const RenderDrawCall &drawCall = drawCalls[globalDrawCallIndex];
-
-					DebugAssertIndex(worker.drawCallCaches, workerDrawCallIndex);
-					DrawCallCache &workerDrawCallCache = worker.drawCallCaches[workerDrawCallIndex];
-					TransformCache &workerTransformCache = worker.transformCaches[workerDrawCallIndex];
-					auto &drawCallCachePositionBuffer = workerDrawCallCache.positionBuffer;
-					auto &drawCallCacheTexCoordBuffer = workerDrawCallCache.texCoordBuffer;
-					auto &drawCallCacheIndexBuffer = workerDrawCallCache.indexBuffer;
-					ObjectTextureID &drawCallCacheTextureID0 = workerDrawCallCache.textureID0;
-					ObjectTextureID &drawCallCacheTextureID1 = workerDrawCallCache.textureID1;
-					RenderLightingType &drawCallCacheLightingType = workerDrawCallCache.lightingType;
-					double &drawCallCacheMeshLightPercent = workerDrawCallCache.meshLightPercent;
-					VertexShaderType &drawCallCacheVertexShaderType = workerDrawCallCache.vertexShaderType;
-					FragmentShaderType &drawCallCacheFragmentShaderType = workerDrawCallCache.fragmentShaderType;
-					double &drawCallCacheTexCoordAnimPercent = workerDrawCallCache.texCoordAnimPercent;
-					bool &drawCallCacheEnableBackFaceCulling = workerDrawCallCache.enableBackFaceCulling;
-					bool &drawCallCacheEnableDepthRead = workerDrawCallCache.enableDepthRead;
-					bool &drawCallCacheEnableDepthWrite = workerDrawCallCache.enableDepthWrite;
-
-					const SoftwareUniformBuffer &transformBuffer = this->uniformBuffers.get(drawCall.transformBufferID);
-					const Matrix4d &modelMatrix = transformBuffer.get<Matrix4d>(drawCall.transformIndex);
-					PopulateMeshTransform(workerTransformCache, modelMatrix);
-
-					drawCallCachePositionBuffer = &this->positionBuffers.get(drawCall.positionBufferID);
-					drawCallCacheTexCoordBuffer = &this->attributeBuffers.get(drawCall.texCoordBufferID);
-					drawCallCacheIndexBuffer = &this->indexBuffers.get(drawCall.indexBufferID);
-
-					const SoftwareMaterial &material = this->materials.get(drawCall.materialID);
-					drawCallCacheTextureID0 = material.textureIDs[0];
-					drawCallCacheTextureID1 = material.textureIDs[1];
-					drawCallCacheLightingType = material.lightingType;
-					drawCallCacheMeshLightPercent = 0.0;
-					drawCallCacheVertexShaderType = material.vertexShaderType;
-					drawCallCacheFragmentShaderType = material.fragmentShaderType;
-					drawCallCacheTexCoordAnimPercent = 0.0;
-					drawCallCacheEnableBackFaceCulling = material.enableBackFaceCulling;
-					drawCallCacheEnableDepthRead = material.enableDepthRead;
-					drawCallCacheEnableDepthWrite = material.enableDepthWrite;
-
-					if (drawCall.materialInstID >= 0)
+					SoftwareWorldMeshCache &worldMeshCache = transformBuffer.worldMeshCaches.get(transformIndex);
+					if (worldMeshCache.lastFrameID != frameID)
 					{
-						const SoftwareMaterialInstance &materialInst = this->materialInsts.get(drawCall.materialInstID);
-						drawCallCacheMeshLightPercent = materialInst.meshLightPercent;
-						drawCallCacheTexCoordAnimPercent = materialInst.texCoordAnimPercent;
+						drawCallInstance.worldMeshCache = &worldMeshCache;
+						worldMeshCache.lastFrameID = frameID;
+						transformBuffer.lastFrameID = frameID;
 					}
 				}
-			}
 
-			for (Worker &worker : g_workers)
-			{
-				DebugAssert(!worker.shouldWorkOnDrawCalls);
-				worker.shouldWorkOnDrawCalls = true;
-				worker.shouldClearFrameBuffer = shouldWorkersClearFrameBuffer;
+				DrawCallInstanceSource &drawCallInstanceSource = packet.drawCallInstanceSources[drawCallIndex];
+				drawCallInstanceSource.drawCall = &drawCall;
+				drawCallInstanceSource.modelMatrix = &transformBuffer.get<Matrix4d>(transformIndex);
+
+				packet.drawCallSortKeys[drawCallIndex].isOrderIndependent = isOrderIndependent;
+
+				drawCallIndex++;
 			}
 
-			g_workerCondVar.notify_all();
-			g_directorCondVar.wait(lock, []()
-			{
-				return std::all_of(g_workers.begin(), g_workers.end(), [](const Worker &worker) { return worker.isFinishedWithDrawCalls; });
-			});
+			drawCallCacheIndex++;
+		}
 
-			shouldWorkersClearFrameBuffer = false;
+		packet.entryDrawCallCounts.emplace_back(drawCallIndex - entryStartDrawCallIndex);
+	}
 
-			for (Worker &worker : g_workers)
-			{
-				DebugAssert(worker.shouldWorkOnDrawCalls);
-				DebugAssert(!worker.shouldWorkOnRasterizing);
-				DebugAssert(!worker.isFinishedRasterizing);
-				worker.shouldWorkOnDrawCalls = false;
-				worker.shouldClearFrameBuffer = false;
-				worker.shouldWorkOnRasterizing = true;
-				g_totalPresentedTriangleCount += worker.rasterizerInputCache.triangleCount;
-			}
+	PopulateDrawCallInstances(packet);
 
-			g_workerCondVar.notify_all();
-			g_directorCondVar.wait(lock, []()
-			{
-				return std::all_of(g_workers.begin(), g_workers.end(), [](const Worker &worker) { return worker.isFinishedRasterizing; });
-			});
+	packet.resourceVersion = resourceVersion;
+	packet.sortedDrawCallCount = SortOrderIndependentDrawCalls(packet);
 
-			// Reset workers for next frame.
-			for (Worker &worker : g_workers)
-			{
-				worker.isFinishedWithDrawCalls = false;
-				worker.shouldWorkOnRasterizing = false;
-				worker.isFinishedRasterizing = false;
-			}
+	const SoftwareUniformBuffer &visibleLights = this->uniformBuffers.get(settings.visibleLightsBufferID);
+	ReadVisibleLights(visibleLights, settings.visibleLightCount, packet.visibleLights);
+
+	CopyFrameTexture(this->objectTextures.get(settings.paletteTextureID), packet.paletteTexture);
+	CopyFrameTexture(this->objectTextures.get(settings.lightTableTextureID), packet.lightTableTexture);
+	CopyFrameTexture(this->objectTextures.get(settings.ditherTextureID), packet.ditherTexture);
+	CopyFrameTexture(this->objectTextures.get(settings.skyBgTextureID), packet.skyBgTexture);
+
+	const bool shouldQueueFrame = settings.renderQueuedFrames > 0;
+	const int totalWorkerCount = RendererUtils::getRenderThreadsFromMode(settings.renderThreadsMode);
+
+	// Spinning only pays off when every worker plus the directing thread has its own core, otherwise spinners steal time
+	// from the thread they wait on. A queued frame also leaves the game thread running alongside them.
+	const int busyThreadCount = totalWorkerCount + (shouldQueueFrame ? 1 : 0);
+	const bool canWorkersSpin = busyThreadCount < Platform::getThreadCount();
+
+	packet.ambientPercent = settings.ambientPercent;
+	packet.screenSpaceAnimPercent = settings.screenSpaceAnimPercent;
+	packet.horizonNdcPoint = camera.horizonNdcPoint;
+	packet.workerCount = totalWorkerCount;
+	packet.workerSpinMicroseconds = canWorkersSpin ? settings.renderThreadsSpinMicroseconds : 0;
+	packet.ditheringMode = settings.ditheringMode;
+	packet.rasterPrecisionMode = settings.rasterPrecisionMode;
+	packet.shadingMode = settings.shadingMode;
+	packet.enableAdaptiveBinSizing = settings.enableAdaptiveBinSizing;
+	packet.enableInterlacing = settings.enableInterlacing;
+	packet.enableMipmaps = settings.enableMipmaps;
+	packet.enableTiledTexels = settings.enableTiledTexels;
+	packet.enableStageTimers = settings.enableStageTimers;
+	packet.enableWorkerAffinity = settings.enableRenderThreadsAffinity;
+	packet.enableRasterPrecisionComparison = (settings.rasterPrecisionMode == RasterPrecisionMode::Single) && settings.enableRasterPrecisionComparison;
+	packet.shouldCompareRasterPrecision = false;
+
+	if (packet.enableRasterPrecisionComparison)
+	{
+		packet.shouldCompareRasterPrecision = g_rasterPrecisionComparisonFrameCounter == 0;
+		g_rasterPrecisionComparisonFrameCounter = (g_rasterPrecisionComparisonFrameCounter + 1) % RASTER_PRECISION_COMPARISON_FRAME_INTERVAL;
+	}
+	else
+	{
+		g_rasterPrecisionComparisonFrameCounter = 0;
+	}
+
+	// The float depth buffer only exists in single-precision mode. Reference frames for the precision comparison use the double one.
+	const int frameBufferCapacityWidth = this->paletteIndexBuffer.getWidth();
+	const int frameBufferCapacityHeight = this->paletteIndexBuffer.getHeight();
+	if (settings.rasterPrecisionMode == RasterPrecisionMode::Single)
+	{
+		if ((this->singlePrecisionDepthBuffer.getWidth() != frameBufferCapacityWidth) || (this->singlePrecisionDepthBuffer.getHeight() != frameBufferCapacityHeight))
+		{
+			WaitForQueuedFrame();
+			this->singlePrecisionDepthBuffer.init(frameBufferCapacityWidth, frameBufferCapacityHeight);
+			this->singlePrecisionDepthBuffer.fill(std::numeric_limits<float>::infinity());
+		}
+	}
+	else if (this->singlePrecisionDepthBuffer.isValid())
+	{
+		WaitForQueuedFrame();
+		this->singlePrecisionDepthBuffer.clear();
+	}
+
+	packet.frameBufferWidth = frameBufferWidth;
+	packet.frameBufferHeight = frameBufferHeight;
+	packet.paletteIndexBuffer = this->paletteIndexBuffer.begin();
+	packet.depthBuffer = this->depthBuffer.begin();
+	packet.singlePrecisionDepthBuffer = this->singlePrecisionDepthBuffer.begin();
+	packet.visibilityBuffer = this->visibilityBuffer.begin();
+	packet.referencePaletteIndexBuffer = &this->referencePaletteIndexBuffer;
+	packet.referenceColorBuffer = &this->referenceColorBuffer;
+	packet.objectTextures = &this->objectTextures;
+
+	// An idle camera in an unanimated scene only needs rendering once. The first repeat is rendered in full and kept,
+	// later ones present it again until something changes. Comparing only reads the previous packet, which may still be rendering.
+	packet.isUnchangedFrame = settings.enableStaticFrameReuse && IsSameFrameInputs(packet, GetFramePacket(frameID - 1));
+	if (!packet.isUnchangedFrame)
+	{
+		this->staticColorBufferIndex = -1;
+	}
+	else if (this->staticColorBufferIndex >= 0)
+	{
+		// This packet is never rendered so nothing it touched may refer to its frame ID after this.
+		WaitForQueuedFrame();
+		RevertWorldMeshCacheUse(packet, g_submittedFrameID);
+		g_reusedFrameCount++;
+
+		const Buffer2D<uint32_t> &staticColorBuffer = this->queuedColorBuffers[this->staticColorBufferIndex];
+		PresentColorBuffer(staticColorBuffer, outputBuffer, frameBufferWidth, frameBufferHeight);
+		return;
+	}
+
+	g_reusedFrameCount = 0;
 
-			startDrawCallIndex += drawCallsToConsume;
-			remainingDrawCallCount -= drawCallsToConsume;
+	// The rasterizer globals and frame buffers are shared, the previous frame has to be done with them.
+	WaitForQueuedFrame();
+	g_submittedFrameID = frameID;
+
+	const int colorBufferIndex = static_cast<int>(frameID % std::size(this->queuedColorBuffers));
+	Buffer2D<uint32_t> &colorBuffer = this->queuedColorBuffers[colorBufferIndex];
+
+	// Frames that may be presented again are rendered to a color buffer that outlives the output buffer.
+	const bool shouldKeepColorBuffer = shouldQueueFrame || packet.isUnchangedFrame;
+	if (shouldKeepColorBuffer && ((colorBuffer.getWidth() != frameBufferWidth) || (colorBuffer.getHeight() != frameBufferHeight)))
+	{
+		colorBuffer.init(frameBufferWidth, frameBufferHeight);
+	}
+
+	if (!shouldQueueFrame)
+	{
+		packet.colorBuffer = packet.isUnchangedFrame ? colorBuffer.begin() : outputBuffer;
+		RenderFramePacket(packet);
+		CompleteFramePacket(packet);
+
+		if (packet.isUnchangedFrame)
+		{
+			PresentColorBuffer(colorBuffer, outputBuffer, frameBufferWidth, frameBufferHeight);
+			this->staticColorBufferIndex = colorBufferIndex;
 		}
+
+		this->queuedColorBufferIndex = -1;
+		return;
+	}
+
+	packet.colorBuffer = colorBuffer.begin();
+
+	StartFrameDirector();
+	SignalFrameDirector(&packet, false);
+
+	// Present the previous frame while this one renders. If there isn't one, this frame has to be waited on.
+	int presentColorBufferIndex = this->queuedColorBufferIndex;
+	if (presentColorBufferIndex < 0)
+	{
+		WaitForQueuedFrame();
+		presentColorBufferIndex = colorBufferIndex;
 	}
+
+	const Buffer2D<uint32_t> &presentColorBuffer = this->queuedColorBuffers[presentColorBufferIndex];
+	PresentColorBuffer(presentColorBuffer, outputBuffer, frameBufferWidth, frameBufferHeight);
+	this->queuedColorBufferIndex = colorBufferIndex;
+	this->staticColorBufferIndex = packet.isUnchangedFrame ? colorBufferIndex : -1;
 }
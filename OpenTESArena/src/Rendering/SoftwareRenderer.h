@@ -21,9 +21,34 @@
 
 struct RendererProfilerData3D;
 
+// Index-expanded world space triangles of a mesh that keeps drawing with the same buffers and transform (i.e. voxels),
+// so only the view-projection step has to run each frame. Owned by the transform's uniform buffer element so a mesh
+// shared by many voxels gets one cache per voxel.
+struct SoftwareWorldMeshCache
+{
+	Buffer<double> values; // One array per vertex component, each triangleCount long.
+	int triangleCount;
+
+	// What the values were built from. Buffer versions change every time the buffer is locked.
+	Matrix4d modelMatrix;
+	VertexPositionBufferID positionBufferID;
+	IndexBufferID indexBufferID;
+	VertexAttributeBufferID texCoordBufferID;
+	uint32_t positionBufferVersion, indexBufferVersion, texCoordBufferVersion;
+
+	uint32_t lastFrameID; // Only one draw call per frame can use the cache.
+	bool isBuilt; // Only built once the same key is seen twice, so meshes that move every frame (i.e. the sky) skip it.
+
+	SoftwareWorldMeshCache();
+
+	void invalidate();
+};
+
 struct SoftwareVertexPositionBuffer
 {
 	Buffer<double> positions;
+	uint32_t version;
+	uint32_t lastFrameID; // Most recent frame that reads this, for only waiting on a queued frame when it matters.
 
 	void init(int vertexCount, int componentsPerVertex);
 };
@@ -31,6 +56,8 @@ struct SoftwareVertexPositionBuffer
 struct SoftwareVertexAttributeBuffer
 {
 	Buffer<double> attributes;
+	uint32_t version;
+	uint32_t lastFrameID;
 
 	void init(int vertexCount, int componentsPerVertex);
 };
@@ -39,6 +66,8 @@ struct SoftwareIndexBuffer
 {
 	Buffer<int32_t> indices;
 	int triangleCount;
+	uint32_t version;
+	uint32_t lastFrameID;
 
 	void init(int indexCount);
 };
@@ -50,6 +79,10 @@ struct SoftwareUniformBuffer
 	int bytesPerElement;
 	int alignmentOfElement;
 
+	// One per element once a basic-shaded draw call uses an element as its model matrix, otherwise empty.
+	Buffer<SoftwareWorldMeshCache> worldMeshCaches;
+	uint32_t lastFrameID; // Most recent frame that reads one of the world mesh caches.
+
 	SoftwareUniformBuffer();
 
 	void init(int elementCount, int bytesPerElement, int alignmentOfElement);
@@ -87,17 +120,62 @@ struct SoftwareUniformBuffer
 
 struct SoftwareObjectTexture
 {
+	static constexpr int MAX_MIP_LEVELS = 16;
+
+	// Perspective-correct sampling can read copies stored in square tiles so texels close in 2D are close in memory.
+	// One 8x8 tile of 8-bit texels is one 64-byte cache line.
+	static constexpr int TILE_DIM_LOG2 = 3;
+	static constexpr int TILE_DIM = 1 << TILE_DIM_LOG2;
+	static constexpr int TILE_TEXEL_COUNT = TILE_DIM * TILE_DIM;
+
 	Buffer<std::byte> texels;
 	const uint8_t *texels8Bit;
 	const uint32_t *texels32Bit;
 	int width, height, texelCount;
 	double widthReal, heightReal;
 	int bytesPerTexel;
+	uint32_t version; // Changes every time the texels are locked.
+	uint32_t lastFrameID;
+
+	// Downsampled palette indices for 8-bit textures sampled by materials, level 0 is the texels themselves.
+	// Lookup textures like the palette are never given more than level 0.
+	Buffer<uint8_t> mipTexels;
+	const uint8_t *mipLevelTexels[MAX_MIP_LEVELS];
+	int mipLevelWidths[MAX_MIP_LEVELS];
+	int mipLevelHeights[MAX_MIP_LEVELS];
+	int mipLevelCount;
+	bool hasMipTexels;
+
+	// Tiled copy of each mip level for 8-bit textures sampled by materials, only while tiled texels are enabled.
+	Buffer<uint8_t> tiledTexels;
+	const uint8_t *mipLevelTiledTexels[MAX_MIP_LEVELS];
+	int mipLevelTileCountXs[MAX_MIP_LEVELS];
+	bool hasTiledTexels;
+
+	uint32_t sampledTexelsVersion; // Texel version the mip levels and tiled copy were built from, 0 if never built.
 
 	SoftwareObjectTexture();
 
+	static int getTileCount(int dim)
+	{
+		return (dim + TILE_DIM - 1) >> TILE_DIM_LOG2;
+	}
+
+	static int getTiledTexelIndex(int x, int y, int tileCountX)
+	{
+		const int tileIndex = (x >> TILE_DIM_LOG2) + ((y >> TILE_DIM_LOG2) * tileCountX);
+		return (tileIndex * TILE_TEXEL_COUNT) + (x & (TILE_DIM - 1)) + ((y & (TILE_DIM - 1)) * TILE_DIM);
+	}
+
 	void init(int width, int height, int bytesPerTexel);
 	void clear();
+
+	// Whether the mip levels and tiled copy are missing, stale, or don't match the mipmap and tiled texel settings.
+	bool needsSampledTexelsUpdate(bool enableMipmaps, bool enableTiledTexels) const;
+
+	// Rebuilds mip levels 1+ and the tiled copies from the current texels, allocating or freeing them to match
+	// the mipmap and tiled texel settings. Only for 8-bit textures.
+	void updateSampledTexels(bool enableMipmaps, bool enableTiledTexels);
 };
 
 struct SoftwareMaterial
@@ -155,6 +233,18 @@ class SoftwareRenderer
 private:
 	Buffer2D<uint8_t> paletteIndexBuffer; // Intermediate buffer to support back-to-front transparencies.
 	Buffer2D<double> depthBuffer;
+	Buffer2D<float> singlePrecisionDepthBuffer; // Used instead of the double depth buffer in single-precision raster mode, only allocated then.
+	Buffer2D<int32_t> visibilityBuffer; // Closest triangle of each pixel not shaded yet in visibility buffer mode, -1 otherwise.
+	int frameBufferWidth, frameBufferHeight; // Internal resolution, the frame buffers above can be larger after shrinking.
+
+	// Double-precision reference frame for measuring single-precision raster error, only allocated when compared against.
+	Buffer2D<uint8_t> referencePaletteIndexBuffer;
+	Buffer2D<uint32_t> referenceColorBuffer;
+
+	// Frames rendered while the game moves on are written here and copied out on the next submit.
+	Buffer2D<uint32_t> queuedColorBuffers[2];
+	int queuedColorBufferIndex; // Most recently queued frame, -1 if there isn't one to present.
+	int staticColorBufferIndex; // Queued color buffer holding the last frame rendered from unchanged inputs, -1 if there isn't one.
 
 	SoftwareVertexPositionBufferPool positionBuffers;
 	SoftwareVertexAttributeBufferPool attributeBuffers;
@@ -213,6 +303,9 @@ public:
 	void setMaterialInstanceMeshLightPercent(RenderMaterialInstanceID id, double value);
 	void setMaterialInstanceTexCoordAnimPercent(RenderMaterialInstanceID id, double value);
 
+	// With queued frames enabled, the output buffer receives the previously submitted frame while this one renders
+	// in the background. With static frame reuse, a frame drawn from the same inputs as the last two is not rendered
+	// and the last one is presented again.
 	void submitFrame(const RenderDrawCommandList &commandList, const RenderCamera &camera,
 		const RenderFrameSettings &settings, uint32_t *outputBuffer);
 };
@@ -4405,6 +4405,12 @@ void VulkanRenderBackend::handleRenderTargetsReset(int windowWidth, int windowHe
 	DebugNotImplementedMsg("handleRenderTargetsReset()");
 }
 
+void VulkanRenderBackend::resizeInternal(int internalWidth, int internalHeight)
+{
+	// Internal render targets and light bins are recreated alongside the swapchain.
+	this->resize(this->swapchainExtent.width, this->swapchainExtent.height, this->sceneViewExtent.width, this->sceneViewExtent.height, internalWidth, internalHeight);
+}
+
 RendererProfilerData2D VulkanRenderBackend::getProfilerData2D() const
 {
 	return this->profilerData2D;
@@ -5835,10 +5841,6 @@ void VulkanRenderBackend::submitFrame(const RenderDrawCommandList &renderCommand
 					this->commandBuffer.bindIndexBuffer(indexBuffer.deviceLocalBuffer, bufferOffset, vk::IndexType::eUint32);
 				}
 
-				const VulkanBuffer &transformBuffer = this->uniformBufferPool.get(drawCall.transformBufferID);
-				const VulkanBufferUniformInfo &transformBufferInfo = transformBuffer.uniform;
-				uint32_t transformBufferDynamicOffset = drawCall.transformIndex * transformBufferInfo.bytesPerStride;
-				this->commandBuffer.bindDescriptorSets(graphicsPipelineBindPoint, pipelineLayout, TransformDescriptorSetLayoutIndex, transformBufferInfo.descriptorSet, transformBufferDynamicOffset);
 				this->commandBuffer.bindDescriptorSets(graphicsPipelineBindPoint, pipelineLayout, MaterialDescriptorSetLayoutIndex, material.descriptorSet, vk::ArrayProxy<const uint32_t>());
 
 				float meshLightPercent = 0.0f;
@@ -5871,10 +5873,20 @@ void VulkanRenderBackend::submitFrame(const RenderDrawCommandList &renderCommand
 					}
 				}
 
-				constexpr uint32_t meshInstanceCount = 1;
-				this->commandBuffer.drawIndexed(currentIndexBufferIndexCount, meshInstanceCount, 0, 0, 0);
+				// Shaders read one model matrix per draw, so instances only rebind the transform's dynamic offset. Pipeline,
+				// vertex/index buffers, material, and push constants above are shared by every instance.
+				const VulkanBuffer &transformBuffer = this->uniformBufferPool.get(drawCall.transformBufferID);
+				const VulkanBufferUniformInfo &transformBufferInfo = transformBuffer.uniform;
+				for (int instanceIndex = 0; instanceIndex < drawCall.instanceCount; instanceIndex++)
+				{
+					const uint32_t transformBufferDynamicOffset = (drawCall.transformIndex + instanceIndex) * transformBufferInfo.bytesPerStride;
+					this->commandBuffer.bindDescriptorSets(graphicsPipelineBindPoint, pipelineLayout, TransformDescriptorSetLayoutIndex, transformBufferInfo.descriptorSet, transformBufferDynamicOffset);
 
-				totalPresentedTriangleCount += currentIndexBufferIndexCount / MeshUtils::POSITION_COMPONENTS_PER_VERTEX;
+					constexpr uint32_t meshInstanceCount = 1;
+					this->commandBuffer.drawIndexed(currentIndexBufferIndexCount, meshInstanceCount, 0, 0, 0);
+
+					totalPresentedTriangleCount += currentIndexBufferIndexCount / MeshUtils::POSITION_COMPONENTS_PER_VERTEX;
+				}
 			}
 
 			totalSceneDrawCallCount += renderCommandList.entries[i].getCount();
@@ -401,6 +401,7 @@ public:
 
 	void resize(int windowWidth, int windowHeight, int sceneViewWidth, int sceneViewHeight, int internalWidth, int internalHeight) override;
 	void handleRenderTargetsReset(int windowWidth, int windowHeight, int sceneViewWidth, int sceneViewHeight, int internalWidth, int internalHeight) override;
+	void resizeInternal(int internalWidth, int internalHeight) override;
 
 	RendererProfilerData2D getProfilerData2D() const override;
 	RendererProfilerData3D getProfilerData3D() const override;
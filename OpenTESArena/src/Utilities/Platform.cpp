@@ -1,10 +1,18 @@
+#include <algorithm>
 #include <filesystem>
+#include <fstream>
+#include <limits>
 #include <thread>
 
 #ifdef _WIN32
 #include <windows.h>
 #endif
 
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 #include "SDL.h"
 
 #include "Platform.h"
@@ -170,6 +178,120 @@ namespace Platform
 		*outValue = vdfText.substr(valueBegin + 1, valueEnd - valueBegin - 1);
 		return true;
 	}
+
+	// Linux CPU topology is exposed as small text files in sysfs.
+	const std::string SysCpuPath = "/sys/devices/system/cpu/";
+
+	// Reads the first line of a sysfs file. Returns false if it doesn't exist (i.e., not on Linux or no such CPU feature).
+	bool tryReadSysFileLine(const std::string &filename, std::string *outLine)
+	{
+		std::ifstream ifs(filename);
+		if (!ifs.is_open())
+		{
+			return false;
+		}
+
+		return static_cast<bool>(std::getline(ifs, *outLine));
+	}
+
+	// Parses a sysfs CPU list like "0-3,8,10-11" into CPU IDs.
+	std::vector<int> parseSysCpuList(const std::string &cpuListText)
+	{
+		std::vector<int> cpuIDs;
+
+		for (const std::string &rangeText : String::split(String::trim(cpuListText), ','))
+		{
+			if (rangeText.empty())
+			{
+				continue;
+			}
+
+			const size_t dashPos = rangeText.find('-');
+			try
+			{
+				const int firstCpuID = std::stoi(rangeText.substr(0, dashPos));
+				const int lastCpuID = (dashPos != std::string::npos) ? std::stoi(rangeText.substr(dashPos + 1)) : firstCpuID;
+				for (int cpuID = firstCpuID; cpuID <= lastCpuID; cpuID++)
+				{
+					cpuIDs.emplace_back(cpuID);
+				}
+			}
+			catch (const std::exception &e)
+			{
+				DebugLogWarningFormat("Couldn't parse CPU list range \"%s\" (%s).", rangeText.c_str(), e.what());
+			}
+		}
+
+		return cpuIDs;
+	}
+
+	// Gets the lowest CPU ID in a sysfs CPU list file, which is what identifies a core or cache among its sharers.
+	int getSysCpuListFirstID(const std::string &filename, int defaultCpuID)
+	{
+		std::string cpuListText;
+		if (!Platform::tryReadSysFileLine(filename, &cpuListText))
+		{
+			return defaultCpuID;
+		}
+
+		const std::vector<int> cpuIDs = Platform::parseSysCpuList(cpuListText);
+		if (cpuIDs.empty())
+		{
+			return defaultCpuID;
+		}
+
+		return *std::min_element(cpuIDs.begin(), cpuIDs.end());
+	}
+
+#ifdef __linux__
+	// CPUs the process was allowed to run on at startup (i.e., from taskset or a cgroup cpuset). Unpinned threads
+	// go back to this instead of every CPU.
+	const cpu_set_t StartupCpuSet = []()
+	{
+		cpu_set_t cpuSet;
+		if (sched_getaffinity(0, sizeof(cpuSet), &cpuSet) != 0)
+		{
+			CPU_ZERO(&cpuSet);
+			for (int i = 0; i < CPU_SETSIZE; i++)
+			{
+				CPU_SET(i, &cpuSet);
+			}
+		}
+
+		return cpuSet;
+	}();
+#endif
+
+	bool isCpuAllowed(int cpuID)
+	{
+#ifdef __linux__
+		return (cpuID >= 0) && (cpuID < CPU_SETSIZE) && CPU_ISSET(cpuID, &Platform::StartupCpuSet);
+#else
+		return cpuID >= 0;
+#endif
+	}
+
+	// Gets the CPU that represents the given CPU's physical core (the lowest of its SMT siblings the process can use).
+	int getSysCoreFirstCpuID(int cpuID)
+	{
+		const std::string topologyPath = Platform::SysCpuPath + "cpu" + std::to_string(cpuID) + "/topology/";
+		std::string siblingCpuListText;
+		if (!Platform::tryReadSysFileLine(topologyPath + "thread_siblings_list", &siblingCpuListText))
+		{
+			return cpuID;
+		}
+
+		int firstCpuID = cpuID;
+		for (const int siblingCpuID : Platform::parseSysCpuList(siblingCpuListText))
+		{
+			if (Platform::isCpuAllowed(siblingCpuID))
+			{
+				firstCpuID = std::min(firstCpuID, siblingCpuID);
+			}
+		}
+
+		return firstCpuID;
+	}
 }
 
 std::string Platform::getPlatform()
@@ -403,6 +525,118 @@ int Platform::getThreadCount()
 	}
 }
 
+std::vector<int> Platform::getPhysicalCoreCpuIDs()
+{
+	std::string onlineCpuListText;
+	if (!Platform::tryReadSysFileLine(Platform::SysCpuPath + "online", &onlineCpuListText))
+	{
+		return std::vector<int>();
+	}
+
+	// Intel hybrid CPUs list their efficiency cores separately. Other big.LITTLE designs give efficiency cores a
+	// lower relative capacity instead.
+	std::vector<int> atomCpuIDs;
+	std::string atomCpuListText;
+	if (Platform::tryReadSysFileLine("/sys/devices/cpu_atom/cpus", &atomCpuListText))
+	{
+		atomCpuIDs = Platform::parseSysCpuList(atomCpuListText);
+	}
+
+	struct PhysicalCore
+	{
+		int cpuID;
+		int capacity;
+		int lastLevelCacheID; // Lowest CPU sharing its L3, so cores of the same cluster (i.e., CCX) sort together.
+		bool isEfficiencyCore;
+	};
+
+	std::vector<PhysicalCore> cores;
+	int minCapacity = std::numeric_limits<int>::max();
+	int maxCapacity = 0;
+	for (const int cpuID : Platform::parseSysCpuList(onlineCpuListText))
+	{
+		if (!Platform::isCpuAllowed(cpuID))
+		{
+			continue; // Outside the process's affinity mask, so pinning to it would fail.
+		}
+
+		if (Platform::getSysCoreFirstCpuID(cpuID) != cpuID)
+		{
+			continue; // SMT sibling of a core that's already listed.
+		}
+
+		const std::string cpuPath = Platform::SysCpuPath + "cpu" + std::to_string(cpuID) + "/";
+
+		PhysicalCore core;
+		core.cpuID = cpuID;
+		core.capacity = 0;
+		core.lastLevelCacheID = Platform::getSysCpuListFirstID(cpuPath + "cache/index3/shared_cpu_list", -1);
+		core.isEfficiencyCore = std::find(atomCpuIDs.begin(), atomCpuIDs.end(), cpuID) != atomCpuIDs.end();
+
+		std::string capacityText;
+		if (Platform::tryReadSysFileLine(cpuPath + "cpu_capacity", &capacityText))
+		{
+			core.capacity = std::atoi(capacityText.c_str());
+			minCapacity = std::min(minCapacity, core.capacity);
+			maxCapacity = std::max(maxCapacity, core.capacity);
+		}
+
+		cores.emplace_back(core);
+	}
+
+	// Only the lowest tier counts, so mid-tier performance cores on three-tier designs aren't demoted.
+	for (PhysicalCore &core : cores)
+	{
+		core.isEfficiencyCore |= (core.capacity == minCapacity) && (minCapacity < maxCapacity);
+	}
+
+	std::stable_sort(cores.begin(), cores.end(),
+		[](const PhysicalCore &a, const PhysicalCore &b)
+	{
+		if (a.isEfficiencyCore != b.isEfficiencyCore)
+		{
+			return !a.isEfficiencyCore;
+		}
+
+		return a.lastLevelCacheID < b.lastLevelCacheID;
+	});
+
+	std::vector<int> cpuIDs;
+	for (const PhysicalCore &core : cores)
+	{
+		cpuIDs.emplace_back(core.cpuID);
+	}
+
+	return cpuIDs;
+}
+
+bool Platform::trySetThreadAffinity(std::thread &thread, int cpuID)
+{
+#ifdef __linux__
+	cpu_set_t cpuSet;
+	if (cpuID >= 0)
+	{
+		CPU_ZERO(&cpuSet);
+		CPU_SET(cpuID, &cpuSet);
+	}
+	else
+	{
+		cpuSet = Platform::StartupCpuSet;
+	}
+
+	const int result = pthread_setaffinity_np(thread.native_handle(), sizeof(cpuSet), &cpuSet);
+	if (result != 0)
+	{
+		DebugLogWarningFormat("Couldn't set thread affinity to CPU %d (error %d).", cpuID, result);
+		return false;
+	}
+
+	return true;
+#else
+	return false;
+#endif
+}
+
 int Platform::getCacheLineSize()
 {
 	return SDL_GetCPUCacheLineSize();
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <thread>
 #include <vector>
 
 // Namespace for various platform-specific functions.
@@ -37,6 +38,15 @@ namespace Platform
 	// Gets the max number of threads available on the CPU.
 	int getThreadCount();
 
+	// Gets one logical CPU ID per physical core, skipping SMT siblings. Performance cores come before efficiency
+	// cores, and cores sharing a last-level cache are adjacent. Only CPUs in the process's startup affinity mask are
+	// listed. Empty if the topology isn't known (Linux only).
+	std::vector<int> getPhysicalCoreCpuIDs();
+
+	// Restricts a thread to one logical CPU, or restores the process's startup affinity mask if the CPU ID is
+	// negative (Linux only).
+	bool trySetThreadAffinity(std::thread &thread, int cpuID);
+
 	// Gets the CPU cache line size in bytes. Important for things like avoiding false sharing
 	// between threads that access the same cache line of memory.
 	int getCacheLineSize();